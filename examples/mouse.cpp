@@ -505,12 +505,7 @@ void MouseDraw::drawCanvas()
                 , &canvaschar[0]
                 , sizeof(finalcut::FChar) * unsigned(x_end) );
     auto& line_changes = print_region->changes_in_line[unsigned(ay + y)];
-
-    if ( int(line_changes.xmin) > ax )
-      line_changes.xmin = uInt(ax);
-
-    if ( int(line_changes.xmax) < ax + x_end - 1 )
-      line_changes.xmax = uInt(ax + x_end - 1);
+    line_changes.addSpan (uInt(ax), uInt(ax + x_end - 1));
   }
 
   print_region->changes_in_row = {0, uInt(y_end - 1)};
@@ -51,13 +51,13 @@ struct Data
     const Termcap cap;
   };
 
-  static std::array<TermcapString, 86> strings;
+  static std::array<TermcapString, 89> strings;
 };
 
 //----------------------------------------------------------------------
 // struct data - string data array
 //----------------------------------------------------------------------
-std::array<Data::TermcapString, 86> Data::strings =
+std::array<Data::TermcapString, 89> Data::strings =
 {{
   { "t_bell", Termcap::t_bell },
   { "t_flash_screen", Termcap::t_flash_screen },
@@ -144,6 +144,9 @@ std::array<Data::TermcapString, 86> Data::strings =
   { "t_acs_chars", Termcap::t_acs_chars },
   { "t_keypad_xmit", Termcap::t_keypad_xmit },
   { "t_keypad_local", Termcap::t_keypad_local },
+  { "t_parm_index", Termcap::t_parm_index },
+  { "t_parm_rindex", Termcap::t_parm_rindex },
+  { "t_change_scroll_region", Termcap::t_change_scroll_region },
   { "t_key_mouse", Termcap::t_key_mouse }
 }};
 
@@ -20,7 +20,12 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -496,6 +501,47 @@ void FApplication::setTerminalEncoding (const FString& enc_str)
   }
 }
 
+//----------------------------------------------------------------------
+void FApplication::setCompositorThreads (const FString& num_str)
+{
+  const auto& str = num_str.toString();
+  char* end{nullptr};
+  errno = 0;
+  const auto threads = std::strtoul(str.data(), &end, 10);
+
+  if ( str.empty() || ! std::isdigit(int(uChar(str[0])))
+    || *end != '\0' || errno == ERANGE )
+  {
+    setExitMessage ( "Invalid number of compositor threads \"" + num_str
+                   + "\"\n(Expected a non-negative integer)" );
+    exit(EXIT_FAILURE);
+  }
+
+  getStartOptions().compositor_threads = std::size_t(threads);
+}
+
+//----------------------------------------------------------------------
+void FApplication::setFlushLatency (const FString& ms_str)
+{
+  // The latency is given in milliseconds and stored in microseconds
+
+  static constexpr double max_latency_ms{1000.0};
+  const auto& str = ms_str.toString();
+  char* end{nullptr};
+  const auto latency_ms = std::strtod(str.data(), &end);
+
+  if ( str.empty() || end == str.data() || *end != '\0'
+    || ! std::isfinite(latency_ms) )
+  {
+    setExitMessage ( "Invalid flush latency \"" + ms_str
+                   + "\"\n(Expected milliseconds, e.g. 16.7)" );
+    exit(EXIT_FAILURE);
+  }
+
+  const auto clamped_ms = std::min(std::max(latency_ms, 0.0), max_latency_ms);
+  getStartOptions().flush_latency = uInt64(std::lround(clamped_ms * 1000.0));
+}
+
 //----------------------------------------------------------------------
 inline auto FApplication::getLongOptions() -> const std::vector<CmdOption>&
 {
@@ -513,6 +559,12 @@ inline auto FApplication::getLongOptions() -> const std::vector<CmdOption>&
     {"vgafont",                  no_argument,       nullptr,  'v' },
     {"newfont",                  no_argument,       nullptr,  'n' },
     {"dark-theme",               no_argument,       nullptr,  't' },
+    {"compositor-threads",       required_argument, nullptr,  'p' },
+    {"threaded-output",          no_argument,       nullptr,  'w' },
+    {"optimal-line-encoding",    no_argument,       nullptr,  'L' },
+    {"bandwidth-budget",         no_argument,       nullptr,  'B' },
+    {"non-blocking-output",      no_argument,       nullptr,  'N' },
+    {"flush-latency",            required_argument, nullptr,  'F' },
 
   #if defined(__FreeBSD__) || defined(__DragonFly__)
     {"no-esc-for-alt-meta",      no_argument,       nullptr,  'E' },
@@ -531,6 +583,8 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
 {
   auto enc = [] (const auto& s) { FApplication::setTerminalEncoding(s); };
   auto log = [] (const auto& s) { FApplication::setLogFile(s); };
+  auto thr = [] (const auto& s) { FApplication::setCompositorThreads(s); };
+  auto lat = [] (const auto& s) { FApplication::setFlushLatency(s); };
   auto opt = &FApplication::getStartOptions;
 
   // --encoding
@@ -557,6 +611,18 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['n'] = [opt] (const auto&) { opt().newfont = true; };
   // --dark-theme
   cmd_map['t'] = [opt] (const auto&) { opt().dark_theme = true; };
+  // --compositor-threads
+  cmd_map['p'] = [thr] (const auto& arg) { thr(FString(arg)); };
+  // --threaded-output
+  cmd_map['w'] = [opt] (const auto&) { opt().threaded_output = true; };
+  // --optimal-line-encoding
+  cmd_map['L'] = [opt] (const auto&) { opt().optimal_line_encoding = true; };
+  // --bandwidth-budget
+  cmd_map['B'] = [opt] (const auto&) { opt().bandwidth_budget = true; };
+  // --non-blocking-output
+  cmd_map['N'] = [opt] (const auto&) { opt().non_blocking_output = true; };
+  // --flush-latency
+  cmd_map['F'] = [lat] (const auto& arg) { lat(FString(arg)); };
 #if defined(__FreeBSD__) || defined(__DragonFly__)
   // --no-esc-for-alt-meta
   cmd_map['E'] = [opt] (const auto&) { opt().meta_sends_escape = false; };
@@ -649,6 +715,22 @@ void FApplication::showParameterUsage()
     << "    Enables graphical font\n"
     << "  --dark-theme              "
     << "    Enables dark theme\n"
+    << "  --compositor-threads=<N>  "
+    << "    Compose the virtual terminal with N threads\n"
+    << "                            "
+    << "    (0 = number of processors)\n"
+    << "  --threaded-output         "
+    << "    Write to the terminal in a separate thread\n"
+    << "  --optimal-line-encoding   "
+    << "    Encode changed lines with the fewest bytes\n"
+    << "  --bandwidth-budget        "
+    << "    Limit the output to the measured link bandwidth\n"
+    << "  --non-blocking-output     "
+    << "    Write to the terminal without blocking\n"
+    << "  --flush-latency=<MS>      "
+    << "    Write changes at the earliest after MS milliseconds\n"
+    << "                            "
+    << "    (default 16.7, 0 = immediately, at most 1000)\n"
 
 #if defined(__FreeBSD__) || defined(__DragonFly__)
     << "\n"
@@ -721,7 +803,8 @@ void FApplication::keyPressed()
 //----------------------------------------------------------------------
 void FApplication::keyReleased() const
 {
-  sendKeyUpEvent (keyboard_widget);
+  static const auto& keyboard = FKeyboard::getInstance();
+  sendKeyUpEvent (keyboard_widget, keyboard.getKey());
 }
 
 //----------------------------------------------------------------------
@@ -750,16 +833,26 @@ inline void FApplication::performKeyboardAction()
   {
     processTerminalFocus (keyboard.getKey());  // Term focus-in/focus-out
   }
+  else if ( keyboard.getKey() == FKey::Bracketed_paste )
+  {
+    processPaste();  // Text pasted into the terminal
+  }
   else
   {
-    const bool acceptKeyDown = sendKeyDownEvent (keyboard_widget);
-    const bool acceptKeyPress = sendKeyPressEvent (keyboard_widget);
-
-    if ( ! (acceptKeyDown || acceptKeyPress) )
-      sendKeyboardAccelerator();
+    performKeyPress (keyboard.getKey());
   }
 }
 
+//----------------------------------------------------------------------
+inline void FApplication::performKeyPress (FKey key) const
+{
+  const bool acceptKeyDown = sendKeyDownEvent (keyboard_widget, key);
+  const bool acceptKeyPress = sendKeyPressEvent (keyboard_widget, key);
+
+  if ( ! (acceptKeyDown || acceptKeyPress) )
+    sendKeyboardAccelerator (key);
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::performMouseAction() const
 {
@@ -803,43 +896,40 @@ inline void FApplication::sendEscapeKeyPressEvent() const
 }
 
 //----------------------------------------------------------------------
-inline auto FApplication::sendKeyDownEvent (FWidget* widget) const -> bool
+inline auto FApplication::sendKeyDownEvent (FWidget* widget, FKey key) const -> bool
 {
   // Send key down event
-  static const auto& keyboard = FKeyboard::getInstance();
-  FKeyEvent k_down_ev (Event::KeyDown, keyboard.getKey());
+  FKeyEvent k_down_ev (Event::KeyDown, key);
   sendEvent (widget, &k_down_ev);
   return k_down_ev.isAccepted();
 }
 
 //----------------------------------------------------------------------
-inline auto FApplication::sendKeyPressEvent (FWidget* widget) const -> bool
+inline auto FApplication::sendKeyPressEvent (FWidget* widget, FKey key) const -> bool
 {
   // Send key press event
-  static const auto& keyboard = FKeyboard::getInstance();
-  FKeyEvent k_press_ev (Event::KeyPress, keyboard.getKey());
+  FKeyEvent k_press_ev (Event::KeyPress, key);
   sendEvent (widget, &k_press_ev);
   return k_press_ev.isAccepted();
 }
 
 //----------------------------------------------------------------------
-inline auto FApplication::sendKeyUpEvent (FWidget* widget) const -> bool
+inline auto FApplication::sendKeyUpEvent (FWidget* widget, FKey key) const -> bool
 {
   // Send key up event
-  static const auto& keyboard = FKeyboard::getInstance();
-  FKeyEvent k_up_ev (Event::KeyUp, keyboard.getKey());
+  FKeyEvent k_up_ev (Event::KeyUp, key);
   sendEvent (widget, &k_up_ev);
   return k_up_ev.isAccepted();
 }
 
 //----------------------------------------------------------------------
-inline void FApplication::sendKeyboardAccelerator() const
+inline void FApplication::sendKeyboardAccelerator (FKey key) const
 {
   if ( FWidget::getOpenMenu() )
     return;
 
   // Switch to a specific dialog with Meta + 1..9
-  bool accpt = processDialogSwitchAccelerator();
+  bool accpt = processDialogSwitchAccelerator(key);
 
   // Windows keyboard accelerator
   if ( ! accpt )
@@ -847,7 +937,7 @@ inline void FApplication::sendKeyboardAccelerator() const
     auto window = static_cast<const FWidget*>(getActiveWindow());
 
     if ( window )
-      accpt = processAccelerator(*window);
+      accpt = processAccelerator(*window, key);
   }
 
   // Global keyboard accelerator
@@ -856,7 +946,7 @@ inline void FApplication::sendKeyboardAccelerator() const
     auto root_widget = getRootWidget();
 
     if ( root_widget )
-      processAccelerator(*root_widget);
+      processAccelerator(*root_widget, key);
   }
 }
 
@@ -929,14 +1019,10 @@ inline void FApplication::processInput() const
 }
 
 //----------------------------------------------------------------------
-auto FApplication::processDialogSwitchAccelerator() const -> bool
+auto FApplication::processDialogSwitchAccelerator (FKey key) const -> bool
 {
-  static const auto& keyboard = FKeyboard::getInstance();
-
-  if ( keyboard.getKey() >= FKey::Meta_1
-    && keyboard.getKey() <= FKey::Meta_9 )
+  if ( key >= FKey::Meta_1 && key <= FKey::Meta_9 )
   {
-    const FKey key = keyboard.getKey();
     const auto n = std::size_t(key - FKey::Meta_0);
     const std::size_t s = getDialogList()->size();
 
@@ -962,16 +1048,14 @@ auto FApplication::processDialogSwitchAccelerator() const -> bool
 }
 
 //----------------------------------------------------------------------
-auto FApplication::processAccelerator (const FWidget& widget) const -> bool
+auto FApplication::processAccelerator (const FWidget& widget, FKey key) const -> bool
 {
   if ( widget.getAcceleratorList().empty() )
     return false;
 
   for (auto&& item : widget.getAcceleratorList())
   {
-    static const auto& keyboard = FKeyboard::getInstance();
-
-    if ( item.key == keyboard.getKey() )
+    if ( item.key == key )
     {
       // unset the move/size mode
       auto move_size = getMoveResizeWidget();
@@ -1019,6 +1103,38 @@ void FApplication::processTerminalFocus (const FKey& key) const
   sendEvent (root_widget, &tf_ev);
 }
 
+//----------------------------------------------------------------------
+void FApplication::processPaste() const
+{
+  static const auto& keyboard = FKeyboard::getInstance();
+
+  if ( ! keyboard_widget )
+    return;
+
+  FPasteEvent paste_ev (Event::Paste, FString(keyboard.getPasteText()));
+  sendEvent (keyboard_widget, &paste_ev);
+
+  if ( paste_ev.isAccepted() )
+    return;
+
+  // The widget does not handle pasted text,
+  // so the text is entered character by character
+  for (const auto& ch : paste_ev.getText())
+  {
+    if ( (ch < L' ' && ch != L'\t' && ch != L'\r' && ch != L'\n')
+      || (ch >= 0x7f && ch < 0xa0) )
+      continue;  // Pasted control characters are not keystrokes
+
+    const auto key = ( ch == L'\n' ) ? FKey::Return : FKey(ch);
+    sendKeyDownEvent (keyboard_widget, key);
+    sendKeyPressEvent (keyboard_widget, key);
+    sendKeyUpEvent (keyboard_widget, key);
+
+    if ( isQuit() )
+      return;
+  }
+}
+
 //----------------------------------------------------------------------
 void FApplication::determineClickedWidget (const FMouseData& md)
 {
@@ -1451,11 +1567,12 @@ auto FApplication::isEventProcessable ( FObject* receiver
       && ! internal::hasModalWindowAsParent(widget)
       && ! window->isMenuWidget() )
     {
-      static constexpr std::array<const Event, 13> blocked_events
+      static constexpr std::array<const Event, 14> blocked_events
       {{
         Event::KeyPress,
         Event::KeyUp,
         Event::KeyDown,
+        Event::Paste,
         Event::MouseDown,
         Event::MouseUp,
         Event::MouseDoubleClick,
@@ -172,6 +172,8 @@ class FApplication : public FWidget
     // Methods
     void         init();
     static void  setTerminalEncoding (const FString&);
+    static void  setCompositorThreads (const FString&);
+    static void  setFlushLatency (const FString&);
     static auto  getLongOptions() -> const std::vector<struct option>&;
     static void  setCmdOptionsMap (CmdMap&);
     static void  cmdOptions (const Args&);
@@ -185,22 +187,24 @@ class FApplication : public FWidget
     void         escapeKeyPressed() const;
     void         mouseTracking() const;
     void         performKeyboardAction();
+    void         performKeyPress (FKey) const;
     void         performMouseAction() const;
     void         mouseEvent (const FMouseData&) const;
     void         sendEscapeKeyPressEvent() const;
-    auto         sendKeyDownEvent (FWidget*) const -> bool;
-    auto         sendKeyPressEvent (FWidget*) const -> bool;
-    auto         sendKeyUpEvent (FWidget*) const -> bool;
-    void         sendKeyboardAccelerator() const;
+    auto         sendKeyDownEvent (FWidget*, FKey) const -> bool;
+    auto         sendKeyPressEvent (FWidget*, FKey) const -> bool;
+    auto         sendKeyUpEvent (FWidget*, FKey) const -> bool;
+    void         sendKeyboardAccelerator (FKey) const;
     auto         hasDataInQueue() const -> bool;
     void         queuingKeyboardInput() const;
     void         queuingMouseInput() const;
     void         processKeyboardEvent() const;
     void         processMouseEvent() const;
     void         processInput() const;
-    auto         processDialogSwitchAccelerator() const -> bool;
-    auto         processAccelerator (const FWidget&) const -> bool;
+    auto         processDialogSwitchAccelerator (FKey) const -> bool;
+    auto         processAccelerator (const FWidget&, FKey) const -> bool;
     void         processTerminalFocus (const FKey&) const;
+    void         processPaste() const;
     static void  determineClickedWidget (const FMouseData&);
     static void  determineWheelWidget (const FMouseData&);
     static auto  isNonActivatingMouseEvent (const FMouseData&) -> bool;
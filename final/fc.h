@@ -79,7 +79,8 @@ enum class Event : uInt8
   Hide,              // Widget is hidden
   Close,             // Widget close
   Timer,             // Timer event occurred
-  User               // User defined event
+  User,              // User defined event
+  Paste              // Text pasted
 };
 
 // Internal character encoding
@@ -701,10 +702,14 @@ enum class FKey : uInt32
   Shift_Ctrl_Meta_menu       = 0x01600007,  // Shifted control-M-Menu
   Term_Focus_In              = 0x01900000,  // Terminal focus-in event
   Term_Focus_Out             = 0x01900001,  // Terminal focus-out event
+  Bracketed_paste_start      = 0x01900002,  // Start of pasted text
+  Bracketed_paste_end        = 0x01900003,  // End of pasted text
+  Bracketed_paste            = 0x01900004,  // Pasted text
   Escape_mintty              = 0x0200001b,  // Mintty Esc
   X11mouse                   = 0x02000020,  // Xterm mouse
   Extended_mouse             = 0x02000021,  // SGR extended mouse
   Urxvt_mouse                = 0x02000022,  // Urxvt mouse extension
+  Kitty_keyboard             = 0x02000023,  // Kitty keyboard protocol
   Meta_offset                = 0x020000e0,  // Meta key offset
   Meta_tab                   = 0x020000e9,  // M-tab
   Meta_enter                 = 0x020000ea,  // M-enter
@@ -1603,6 +1608,9 @@ enum class Termcap : uInt8
   t_acs_chars,
   t_keypad_xmit,
   t_keypad_local,
+  t_parm_index,
+  t_parm_rindex,
+  t_change_scroll_region,
   t_key_mouse
 };
 
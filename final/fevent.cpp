@@ -73,6 +73,32 @@ void FKeyEvent::ignore() noexcept
 { accpt = false; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent (Event ev_type, FString str)  // constructor
+  : FEvent{ev_type}
+  , text{std::move(str)}
+{ }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::getText() const noexcept -> const FString&
+{ return text; }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::isAccepted() const noexcept -> bool
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept() noexcept
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore() noexcept
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
@@ -33,6 +33,10 @@
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
  *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *      ├─────▏FPasteEvent ▏
+ *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *      │
+ *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
  *      ├─────▏FMouseEvent ▏
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
@@ -87,6 +91,7 @@
 #include "final/ftypes.h"
 #include "final/util/fdata.h"
 #include "final/util/fpoint.h"
+#include "final/util/fstring.h"
 
 namespace finalcut
 {
@@ -137,6 +142,26 @@ class FKeyEvent : public FEvent  // keyboard event
 };
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+class FPasteEvent : public FEvent  // paste event
+{
+  public:
+    FPasteEvent (Event, FString);
+
+    auto getText() const noexcept -> const FString&;
+    auto isAccepted() const noexcept -> bool;
+    void accept() noexcept;
+    void ignore() noexcept;
+
+  private:
+    FString text{};
+    bool    accpt{false};  // reject by default
+};
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
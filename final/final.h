@@ -47,6 +47,7 @@
 #include <final/eventloop/timer_monitor.h>
 #include <final/input/fkeyboard.h>
 #include <final/input/fkey_map.h>
+#include <final/input/fkey_tokenizer.h>
 #include <final/input/fmouse.h>
 #include <final/menu/fcheckmenuitem.h>
 #include <final/menu/fdialoglistmenu.h>
@@ -56,10 +57,15 @@
 #include <final/menu/fradiomenuitem.h>
 #include <final/output/fcolorpalette.h>
 #include <final/output/foutput.h>
+#include <final/output/tty/fbandwidthbudget.h>
 #include <final/output/tty/fcharmap.h>
+#include <final/output/tty/fflushtiming.h>
 #include <final/output/tty/foptiattr.h>
 #include <final/output/tty/foptimove.h>
+#include <final/output/tty/frowscanner.h>
 #include <final/output/tty/ftermcap.h>
+#include <final/output/tty/flineencoder.h>
+#include <final/output/tty/ftermcapprogram.h>
 #include <final/output/tty/ftermcapquirks.h>
 #include <final/output/tty/ftermdata.h>
 #include <final/output/tty/ftermdebugdata.h>
@@ -67,7 +73,9 @@
 #include <final/output/tty/fterm.h>
 #include <final/output/tty/ftermios.h>
 #include <final/output/tty/ftermoutput.h>
+#include <final/output/tty/ftermwriter.h>
 #include <final/output/tty/ftermxterminal.h>
+#include <final/output/tty/futf8encoder.h>
 #include <final/output/tty/sgr_optimizer.h>
 #include <final/util/char_ringbuffer.h>
 #include <final/util/emptyfstring.h>
@@ -79,7 +87,10 @@
 #include <final/util/fsize.h>
 #include <final/util/fstring.h>
 #include <final/util/fsystem.h>
+#include <final/vterm/fbandcompositor.h>
+#include <final/vterm/fcellblender.h>
 #include <final/vterm/fcolorpair.h>
+#include <final/vterm/fscrolldetector.h>
 #include <final/vterm/fstyle.h>
 #include <final/vterm/fvtermbuffer.h>
 #include <final/vterm/fvterm.h>
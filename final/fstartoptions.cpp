@@ -53,6 +53,10 @@ FStartOptions::FStartOptions()
   , dark_theme{false}
   , color_change{true}
   , is_being_initialized{false}
+  , threaded_output{false}
+  , optimal_line_encoding{false}
+  , bandwidth_budget{false}
+  , non_blocking_output{false}
 { }
 
 
@@ -73,10 +77,16 @@ void FStartOptions::setDefault()
   color_change = true;
   vgafont = false;
   newfont = false;
+  compositor_threads = 1;
+  flush_latency = 16'667;
   encoding = Encoding::Unknown;
   dark_theme = false;
   terminal_focus_events = true;
   is_being_initialized = false;
+  threaded_output = false;
+  optimal_line_encoding = false;
+  bandwidth_budget = false;
+  non_blocking_output = false;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
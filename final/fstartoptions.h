@@ -63,29 +63,35 @@ class FStartOptions final
     void setDefault();
 
     // Data members
-    uInt8 cursor_optimisation   : 1;
-    uInt8 mouse_support         : 1;
-    uInt8 terminal_detection    : 1;
-    uInt8 terminal_data_request : 1;
-    uInt8 terminal_focus_events : 1;
-    uInt8 sgr_optimizer         : 1;
-    uInt8 vgafont               : 1;
-    uInt8 newfont               : 1;
+    uInt8 cursor_optimisation    : 1;
+    uInt8 mouse_support          : 1;
+    uInt8 terminal_detection     : 1;
+    uInt8 terminal_data_request  : 1;
+    uInt8 terminal_focus_events  : 1;
+    uInt8 sgr_optimizer          : 1;
+    uInt8 vgafont                : 1;
+    uInt8 newfont                : 1;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
-    uInt8 meta_sends_escape     : 1;
-    uInt8 change_cursorstyle    : 1;
-    uInt8                       : 6;  // padding bits
+    uInt8 meta_sends_escape      : 1;
+    uInt8 change_cursorstyle     : 1;
+    uInt8                        : 6;  // padding bits
 #elif defined(__NetBSD__) || defined(__OpenBSD__)
-    uInt8 meta_sends_escape     : 1;
-    uInt8                       : 7;  // padding bits
+    uInt8 meta_sends_escape      : 1;
+    uInt8                        : 7;  // padding bits
 #endif
 
-    uInt16 dark_theme           : 1;
-    uInt16 color_change         : 1;
-    uInt16 is_being_initialized : 1;
-    uInt16                      : 13;  // padding bits
-
+    uInt16 dark_theme            : 1;
+    uInt16 color_change          : 1;
+    uInt16 is_being_initialized  : 1;
+    uInt16 threaded_output       : 1;
+    uInt16 optimal_line_encoding : 1;
+    uInt16 bandwidth_budget      : 1;
+    uInt16 non_blocking_output   : 1;
+    uInt16                       : 9;  // padding bits
+
+    std::size_t   compositor_threads{1};
+    uInt64        flush_latency{16'667};  // Microseconds
     Encoding      encoding{Encoding::Unknown};
     std::ofstream logfile_stream{};
 };
@@ -322,9 +322,10 @@ inline auto encode (wchar_t ucs, CharBufferT& buffer) -> uInt32_if_vector_or_arr
 #else
 
 template <typename CharBufferT>
-inline auto encode (wchar_t ucs, CharBufferT& buffer) -> uInt32_if_vector_or_array<CharBufferT>
+inline auto encode (wchar_t wc, CharBufferT& buffer) -> uInt32_if_vector_or_array<CharBufferT>
 {
   // Writes UTF-8 bytes to the target array and returns the length
+  const auto ucs = uInt32(wc);  // A negative wchar_t is an invalid character
   const auto index = std::is_same<CharBufferT, std::vector<char>>::value
                    ? buffer.size()
                    : 0;
@@ -1131,12 +1132,12 @@ struct FChar
 #endif
   auto operator == (const FChar& lhs, const FChar& rhs) noexcept -> bool
   {
-     if ( lhs.color.data != rhs.color.data )
-      return false;
-
+    // Color and attributes are compared as one 64-bit word
     constexpr auto mask = getCompareBitMask();
+    const auto lhs_style = (uInt64(lhs.attr.data & mask) << 32) | lhs.color.data;
+    const auto rhs_style = (uInt64(rhs.attr.data & mask) << 32) | rhs.color.data;
 
-    if ( (lhs.attr.data & mask) != (rhs.attr.data & mask) )
+    if ( lhs_style != rhs_style )
       return false;
 
 #if defined(__clang__)
@@ -1145,11 +1146,13 @@ struct FChar
     #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
   #endif
 #endif
-    return lhs.ch.unicode_data[0] == rhs.ch.unicode_data[0]
-        && lhs.ch.unicode_data[1] == rhs.ch.unicode_data[1]
-        && lhs.ch.unicode_data[2] == rhs.ch.unicode_data[2]
-        && lhs.ch.unicode_data[3] == rhs.ch.unicode_data[3]
-        && lhs.ch.unicode_data[4] == rhs.ch.unicode_data[4];
+    // Branchless comparison of all code points
+    const auto diff = uInt32(lhs.ch.unicode_data[0] ^ rhs.ch.unicode_data[0])
+                    | uInt32(lhs.ch.unicode_data[1] ^ rhs.ch.unicode_data[1])
+                    | uInt32(lhs.ch.unicode_data[2] ^ rhs.ch.unicode_data[2])
+                    | uInt32(lhs.ch.unicode_data[3] ^ rhs.ch.unicode_data[3])
+                    | uInt32(lhs.ch.unicode_data[4] ^ rhs.ch.unicode_data[4]);
+    return diff == 0;
 #if defined(__clang__)
   #pragma clang diagnostic pop
 #endif
@@ -1166,6 +1169,60 @@ struct FChar
   }
 };
 
+
+// FCompactChar
+//----------------------------------------------------------------------
+struct FCompactChar
+{
+  // Constant
+  static constexpr uInt32 GRAPHEME_FLAG = 0x80000000U;  // Code is a grapheme pool index
+  static constexpr uInt32 UNKNOWN_CODE  = 0x7fffffffU;  // Cell content is unknown
+
+  // Accessors
+  constexpr auto getCode() const noexcept -> uInt32
+  {
+    return uInt32(glyph_attr & 0xffffffffU);
+  }
+
+  constexpr auto getAttribute() const noexcept -> uInt32
+  {
+    return uInt32(glyph_attr >> 32);
+  }
+
+  constexpr auto getGraphemeIndex() const noexcept -> uInt32
+  {
+    return getCode() & ~GRAPHEME_FLAG;
+  }
+
+  // Mutator
+  constexpr void set (uInt32 code, uInt32 attr, uInt32 cell_color) noexcept
+  {
+    glyph_attr = (uInt64(attr & getCompareBitMask()) << 32) | code;
+    color = cell_color;
+  }
+
+  // Predicate
+  constexpr auto isGrapheme() const noexcept -> bool
+  {
+    return (getCode() & GRAPHEME_FLAG) != 0;
+  }
+
+  // Data members
+  uInt64 glyph_attr{0};  // Code point or grapheme index + compare attributes
+  uInt32 color{0};       // Foreground and background color
+
+  // Friend operator functions
+  friend constexpr auto operator == (const FCompactChar& lhs, const FCompactChar& rhs) noexcept -> bool
+  {
+    return lhs.glyph_attr == rhs.glyph_attr && lhs.color == rhs.color;
+  }
+
+  friend constexpr auto operator != (const FCompactChar& lhs, const FCompactChar& rhs) noexcept -> bool
+  {
+    return ! ( lhs == rhs );
+  }
+};
+
 }  // namespace finalcut
 
 #endif  // FTYPES_H
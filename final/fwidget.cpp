@@ -1354,6 +1354,13 @@ void FWidget::onKeyDown (FKeyEvent*)
   // to receive key down events for the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::onPaste (FPasteEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive pasted text for the widget
+}
+
 //----------------------------------------------------------------------
 void FWidget::onMouseDown (FMouseEvent*)
 {
@@ -1530,6 +1537,12 @@ inline void FWidget::mapKeyEvents()
       {
         KeyDownEvent(static_cast<FKeyEvent*>(ev));
       }
+    },
+    { Event::Paste,
+      [this] (FEvent* ev)
+      {
+        onPaste (static_cast<FPasteEvent*>(ev));
+      }
     }
   } );
 }
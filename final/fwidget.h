@@ -55,6 +55,10 @@
  *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▏
  *                   :
  *                   :      *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *                   :- - - -▕ FPasteEvent ▏
+ *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                   :
+ *                   :      *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
  *                   :- - - -▕ FMouseEvent ▏
  *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *                   :
@@ -116,6 +120,7 @@ namespace finalcut
 
 // class forward declaration
 class FMenuBar;
+class FPasteEvent;
 class FRect;
 class FResizeEvent;
 class FSize;
@@ -335,6 +340,7 @@ class FWidget : public FVTerm
     virtual void onKeyPress (FKeyEvent*);
     virtual void onKeyUp (FKeyEvent*);
     virtual void onKeyDown (FKeyEvent*);
+    virtual void onPaste (FPasteEvent*);
     virtual void onMouseDown (FMouseEvent*);
     virtual void onMouseUp (FMouseEvent*);
     virtual void onMouseDoubleClick (FMouseEvent*);
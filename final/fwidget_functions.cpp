@@ -51,12 +51,23 @@ constexpr auto getPrintTransMask() noexcept -> uInt32
   return FCharAttribute_to_uInt32(mask);
 }
 
+constexpr auto getTransMask() noexcept -> uInt32
+{
+  FCharAttribute mask{};
+  mask.transparent = true;
+  mask.color_overlay = true;
+  mask.inherit_background = true;
+  return FCharAttribute_to_uInt32(mask);
+}
+
 struct var
 {
   static constexpr auto print_trans_mask = getPrintTransMask();
+  static constexpr auto trans_mask = getTransMask();
 };
 
 constexpr uInt32 var::print_trans_mask;
+constexpr uInt32 var::trans_mask;
 
 }  // namespace internal
 
@@ -74,12 +85,12 @@ struct TransparentShadowData
   uInt         shadow_height{};
   FChar        transparent_char{};
   FChar        color_overlay_char{};
-  FChar*       region_ptr{};
 };
 
 
 // Function forward declarations
 //----------------------------------------------------------------------
+auto getTransparentCount (FVTerm::FTermRegion::FChar_const_iterator, uInt) noexcept -> uInt;
 void drawRightShadow (TransparentShadowData&);
 void drawBottomShadow (TransparentShadowData&);
 
@@ -411,13 +422,13 @@ void drawTransparentShadow (FWidget* w)
       { L'\0', L'\0', L'\0', L'\0', L'\0' },
       { wc_shadow.fg, wc_shadow.bg },
       { 0x00004000U }  // color_overlay
-    },
-    &region.getFChar(region.size.width, 0)
+    }
   };
 
   drawRightShadow(data);
   drawBottomShadow(data);
   region.has_changes = true;
+  region.invalidateOpacity();
   // Update row changes
   auto last_row = uInt(data.height + data.shadow_height - 1);
   region.changes_in_row = {uInt(0), last_row};
@@ -426,6 +437,17 @@ void drawTransparentShadow (FWidget* w)
     w->setReverse(false);
 }
 
+//----------------------------------------------------------------------
+inline auto getTransparentCount ( FVTerm::FTermRegion::FChar_const_iterator iter
+                                , uInt length ) noexcept -> uInt
+{
+  const auto is_transparent = [] (const FChar& fchar)
+  {
+    return fchar.isBitSet(internal::var::trans_mask);
+  };
+  return uInt(std::count_if(iter, std::next(iter, length), is_transparent));
+}
+
 //----------------------------------------------------------------------
 inline void drawRightShadow (TransparentShadowData& d)
 {
@@ -436,27 +458,20 @@ inline void drawRightShadow (TransparentShadowData& d)
   const auto s_width = d.shadow_width;
   const auto width = d.width;
   const auto height = d.height;
-  auto* ptr = d.region_ptr;
   auto& changes_in_line = d.region.changes_in_line;
-  auto& changes_in_1st_line = changes_in_line[0];
 
-  std::fill (ptr, std::next(ptr, s_width), d.transparent_char);
-  changes_in_1st_line.xmin = std::min(changes_in_1st_line.xmin, width);
-  changes_in_1st_line.xmax = width + s_width - 1;
-  changes_in_1st_line.trans_count += s_width;
-  const auto total_width = width + s_width;
-
-  for (std::size_t y{1}; y < height; y++)
+  for (std::size_t y{0}; y < height; y++)
   {
-    ptr = std::next(ptr, total_width);
+    // Rows are addressed via the row offset table (see rotateRows)
+    const auto iter = d.region.getFCharIterator(int(width), int(y));
+    const auto& shadow_char = ( y == 0 ) ? d.transparent_char
+                                         : d.color_overlay_char;
     auto& changes = changes_in_line[y];
-    changes.xmin = std::min(d.region.changes_in_line[y].xmin, width);
-    changes.xmax = width + s_width - 1;
-    changes.trans_count += s_width;
-    std::fill (ptr, std::next(ptr, s_width), d.color_overlay_char);
+    changes.addSpan (width, width + s_width - 1);
+    // A redrawn shadow replaces the already counted transparent characters
+    changes.trans_count += s_width - getTransparentCount(iter, s_width);
+    std::fill (iter, std::next(iter, s_width), shadow_char);
   }
-
-  d.region_ptr = std::next(ptr, s_width);
 }
 
 //----------------------------------------------------------------------
@@ -473,19 +488,17 @@ inline void drawBottomShadow (TransparentShadowData& d)
   const auto s_height = d.shadow_height;
   const auto start_y = d.height;
   auto& changes_in_line = d.region.changes_in_line;
-  auto* ptr = d.region_ptr;
 
   for (std::size_t i{0}; i < s_height; i++)
   {
     const auto y = start_y + i;
+    auto iter = d.region.getFCharIterator(0, int(y));
     auto& changes = changes_in_line[y];
-    changes.xmin = 0;
-    changes.xmax = xmax;
-    changes.trans_count += total_width;
-    std::fill (ptr, std::next(ptr, s_width), d.transparent_char);
-    ptr = std::next(ptr, s_width);
-    std::fill (ptr, std::next(ptr, width), d.color_overlay_char);
-    ptr = std::next(ptr, width);
+    changes.setSpan (0, xmax);
+    changes.trans_count += total_width - getTransparentCount(iter, total_width);
+    std::fill (iter, std::next(iter, s_width), d.transparent_char);
+    iter = std::next(iter, s_width);
+    std::fill (iter, std::next(iter, width), d.color_overlay_char);
   }
 }
 
@@ -594,9 +607,9 @@ struct GenericBlockShadowData
   inline void updateChanges (uInt y, uInt xmin, uInt xmax, uInt tc = 0)
   {
     auto& changes = region.changes_in_line[y];
-    changes.xmin = std::min(changes.xmin, xmin);
-    changes.xmax = std::max(changes.xmax, xmax);
+    changes.addSpan (xmin, xmax);
     changes.trans_count += tc + 1;
+    region.invalidateOpacity();
   }
 
   // Data members
@@ -950,9 +963,11 @@ struct GenericBoxData
   inline void updateChanges (uInt y, uInt xmin, uInt xmax)
   {
     auto& changes = region.changes_in_line[y];
-    changes.xmin = std::min(changes.xmin, xmin);
-    changes.xmax = std::min(max_width, std::max(changes.xmax, xmax));
+    changes.addSpan (xmin, std::min(max_width, xmax));
     changes.trans_count += trans_count_increment;
+
+    if ( trans_count_increment > 0 )
+      region.invalidateOpacity();
   }
 
   // Data members
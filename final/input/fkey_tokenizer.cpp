@@ -0,0 +1,430 @@
+/***********************************************************************
+* fkey_tokenizer.cpp - Compiled automaton for terminal input sequences *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include "final/fc.h"
+#include "final/input/fkey_map.h"
+#include "final/input/fkey_tokenizer.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr std::size_t start_state{0};      // Start of every sequence
+constexpr std::size_t character_state{1};  // Complete character
+constexpr std::size_t escape_state{2};     // After the escape character
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FKeyTokenizer
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr uInt16 FKeyTokenizer::DEAD_STATE;
+constexpr uInt8 FKeyTokenizer::KNOWN_KEY_PRIORITY;
+constexpr uInt8 FKeyTokenizer::TERMCAP_KEY_PRIORITY;
+constexpr uInt8 FKeyTokenizer::MOUSE_PRIORITY;
+constexpr uInt8 FKeyTokenizer::KEYBOARD_PROTOCOL_PRIORITY;
+
+
+// public methods of FKeyTokenizer
+//----------------------------------------------------------------------
+void FKeyTokenizer::compile()
+{
+  // Combines all key strings, the mouse reports and the character
+  // encoding into a nondeterministic automaton and converts it
+  // into a deterministic one
+
+  Nfa nfa(3);  // Start, character and escape state
+  nfa[internal::character_state].accept = Accept::Character;
+  addCharacters(nfa);
+  addKeys(nfa);
+
+  addKeyboardProtocol(nfa);
+
+  if ( mouse_support )
+    addMouseReports(nfa);
+
+  buildDfa(nfa);
+  compiled = true;
+  reset();
+}
+
+//----------------------------------------------------------------------
+auto FKeyTokenizer::feed (char ch) noexcept -> Status
+{
+  // Advances the automaton by one character. The search in the
+  // sorted character ranges of a state limits the cost per
+  // character, so that a sequence is parsed in linear time.
+
+  if ( status != Status::Incomplete )
+    return status;
+
+  length++;
+
+  if ( states.empty() )
+    return (status = Status::Invalid);
+
+  const auto& state = states[current_state];
+  const auto first = edges.cbegin() + std::ptrdiff_t(state.edge_begin);
+  const auto last = edges.cbegin() + std::ptrdiff_t(state.edge_end);
+  const auto uch = uChar(ch);
+  const auto iter = std::lower_bound ( first, last, uch
+                                     , [] (const Edge& edge, uChar c)
+                                       {
+                                         return edge.last < c;
+                                       }
+                                     );
+
+  if ( iter == last || iter->first > uch )
+    return (status = Status::Invalid);
+
+  current_state = iter->next;
+  const auto accept = states[current_state].accept;
+
+  if ( accept == Accept::Character || accept == Accept::Key )
+    status = Status::Complete;
+
+  return status;
+}
+
+
+// private methods of FKeyTokenizer
+//----------------------------------------------------------------------
+auto FKeyTokenizer::addState (Nfa& nfa, bool exclusive) -> std::size_t
+{
+  nfa.emplace_back();
+  nfa.back().exclusive = exclusive;
+  return nfa.size() - 1;
+}
+
+//----------------------------------------------------------------------
+inline void FKeyTokenizer::addEdge ( Nfa& nfa, std::size_t from
+                                   , uChar first, uChar last
+                                   , std::size_t to )
+{
+  nfa[from].edges.push_back({first, last, to});
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::addCharacters (Nfa& nfa) const
+{
+  // Single characters and UTF-8 encoded characters
+
+  using internal::start_state;
+  using internal::character_state;
+  addEdge (nfa, start_state, 0x00, 0x1a, character_state);
+  addEdge (nfa, start_state, 0x1b, 0x1b, internal::escape_state);
+  addEdge (nfa, start_state, 0x1c, 0x7f, character_state);
+
+  if ( ! utf8_input )
+  {
+    addEdge (nfa, start_state, 0x80, 0xff, character_state);
+    return;
+  }
+
+  // A UTF-8 start byte determines the number of continuation bytes
+  std::array<std::size_t, 6> continuation{{ character_state }};
+
+  for (std::size_t n{1}; n < continuation.size(); n++)
+  {
+    continuation[n] = addState(nfa);
+    addEdge (nfa, continuation[n], 0x00, 0xff, continuation[n - 1]);
+  }
+
+  addEdge (nfa, start_state, 0x80, 0xbf, character_state);
+  addEdge (nfa, start_state, 0xc0, 0xdf, continuation[1]);
+  addEdge (nfa, start_state, 0xe0, 0xef, continuation[2]);
+  addEdge (nfa, start_state, 0xf0, 0xf7, continuation[3]);
+  addEdge (nfa, start_state, 0xf8, 0xfb, continuation[4]);
+  addEdge (nfa, start_state, 0xfc, 0xfd, continuation[5]);
+  addEdge (nfa, start_state, 0xfe, 0xff, character_state);
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::addKey ( Nfa& nfa, const std::string& string
+                           , FKey key, uInt8 priority, Accept accept )
+{
+  // Inserts an escape sequence into the key tree
+
+  if ( string.length() < 2 || string[0] != ESC[0] )
+    return;
+
+  auto state = internal::escape_state;
+
+  for (std::size_t i{1}; i < string.length(); i++)
+  {
+    const auto ch = uChar(string[i]);
+    const auto& state_edges = nfa[state].edges;
+    const auto iter = std::find_if ( state_edges.cbegin()
+                                   , state_edges.cend()
+                                   , [ch] (const NfaEdge& edge)
+                                     {
+                                       return edge.first == ch && edge.last == ch;
+                                     }
+                                   );
+
+    if ( iter != state_edges.cend() )
+    {
+      state = iter->next;
+    }
+    else
+    {
+      const auto next = addState(nfa);
+      addEdge (nfa, state, ch, ch, next);
+      state = next;
+    }
+  }
+
+  auto& final_state = nfa[state];
+
+  if ( priority <= final_state.priority )
+    return;  // Already defined with a higher priority
+
+  final_state.key = key;
+  final_state.accept = accept;
+  final_state.priority = priority;
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::addKeys (Nfa& nfa) const
+{
+  // Termcap keys take precedence over known keys
+
+  for (const auto& item : FKeyMap::getKeyMap())
+  {
+    const std::string string(item.string.data(), item.length);
+
+    // Meta-O, Meta-[ and Meta-] are prefixes of other keys
+    // and are only recognized after a timeout
+    const bool deferred = string.length() == 2
+                       && ( string[1] == 'O'
+                         || string[1] == '['
+                         || string[1] == ']' );
+    const auto accept = deferred ? Accept::Deferred : Accept::Key;
+    addKey (nfa, string, item.num, KNOWN_KEY_PRIORITY, accept);
+  }
+
+  for (const auto& item : termcap_keys)
+    addKey (nfa, item.first, item.second, TERMCAP_KEY_PRIORITY, Accept::Key);
+}
+
+//----------------------------------------------------------------------
+auto FKeyTokenizer::addDigits ( Nfa& nfa, std::size_t from
+                              , bool exclusive ) -> std::size_t
+{
+  // Adds a decimal number with at least one digit
+
+  const auto digits = addState(nfa, exclusive);
+  addEdge (nfa, from, '0', '9', digits);
+  addEdge (nfa, digits, '0', '9', digits);
+  return digits;
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::addMouseReports (Nfa& nfa)
+{
+  // Mouse reports run parallel to the key tree
+
+  const auto csi = addState(nfa);
+  addEdge (nfa, internal::escape_state, '[', '[', csi);
+
+  // X11 mouse: ESC [ M Cb Cx Cy
+  auto state = addState(nfa, true);
+  addEdge (nfa, csi, 'M', 'M', state);
+
+  for (std::size_t i{0}; i < 3; i++)
+  {
+    const auto next = addState(nfa, true);
+    addEdge (nfa, state, 0x00, 0xff, next);
+    state = next;
+  }
+
+  const auto x11_end = state;
+  nfa[x11_end].key = FKey::X11mouse;
+
+  // SGR mouse: ESC [ < Pb ; Px ; Py M  or  ESC [ < Pb ; Px ; Py m
+  state = addState(nfa, true);
+  addEdge (nfa, csi, '<', '<', state);
+
+  for (std::size_t i{0}; i < 2; i++)
+  {
+    const auto separator = addState(nfa, true);
+    addEdge (nfa, addDigits(nfa, state, true), ';', ';', separator);
+    state = separator;
+  }
+
+  const auto sgr_digits = addDigits(nfa, state, true);
+  const auto sgr_end = addState(nfa, true);
+  addEdge (nfa, sgr_digits, 'M', 'M', sgr_end);
+  addEdge (nfa, sgr_digits, 'm', 'm', sgr_end);
+  nfa[sgr_end].key = FKey::Extended_mouse;
+
+  // Urxvt mouse: ESC [ Pb ; Px ; Py M  (Pb >= 10)
+  state = addState(nfa);
+  addEdge (nfa, csi, '1', '9', state);
+
+  for (std::size_t i{0}; i < 2; i++)
+  {
+    const auto separator = addState(nfa);
+    addEdge (nfa, addDigits(nfa, state, false), ';', ';', separator);
+    state = separator;
+  }
+
+  const auto urxvt_end = addState(nfa);
+  addEdge (nfa, addDigits(nfa, state, false), 'M', 'M', urxvt_end);
+  nfa[urxvt_end].key = FKey::Urxvt_mouse;
+
+  for (const auto& mouse_state : {x11_end, sgr_end, urxvt_end})
+  {
+    nfa[mouse_state].accept = Accept::Key;
+    nfa[mouse_state].priority = MOUSE_PRIORITY;
+  }
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::addKeyboardProtocol (Nfa& nfa)
+{
+  // Kitty keyboard protocol: ESC [ code u  or  ESC [ code ; modifiers u
+
+  const auto csi = addState(nfa);
+  addEdge (nfa, internal::escape_state, '[', '[', csi);
+  const auto code = addDigits(nfa, csi, false);
+  const auto separator = addState(nfa);
+  addEdge (nfa, code, ';', ';', separator);
+  const auto modifiers = addDigits(nfa, separator, false);
+  const auto end = addState(nfa);
+  addEdge (nfa, code, 'u', 'u', end);
+  addEdge (nfa, modifiers, 'u', 'u', end);
+  nfa[end].key = FKey::Kitty_keyboard;
+  nfa[end].accept = Accept::Key;
+  nfa[end].priority = KEYBOARD_PROTOCOL_PRIORITY;
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizer::buildDfa (const Nfa& nfa)
+{
+  // Subset construction: each deterministic state represents
+  // the set of all parallel nondeterministic states
+
+  using StateSet = std::vector<std::size_t>;
+  std::map<StateSet, uInt16> state_index{};
+  std::vector<StateSet> state_sets{};
+  states.clear();
+  edges.clear();
+
+  auto get_state = [&] (const StateSet& set) -> uInt16
+  {
+    const auto iter = state_index.find(set);
+
+    if ( iter != state_index.end() )
+      return iter->second;
+
+    if ( states.size() >= DEAD_STATE )
+      return DEAD_STATE;
+
+    State state{0, 0, FKey::None, Accept::None};
+    uInt8 priority{0};
+
+    for (const auto& n : set)
+    {
+      if ( nfa[n].accept == Accept::None
+        || (state.accept != Accept::None && nfa[n].priority <= priority) )
+        continue;
+
+      state.key = nfa[n].key;
+      state.accept = nfa[n].accept;
+      priority = nfa[n].priority;
+    }
+
+    const auto index = uInt16(states.size());
+    states.push_back(state);
+    state_sets.push_back(set);
+    state_index.emplace(set, index);
+    return index;
+  };
+
+  get_state({internal::start_state});
+  StateSet target{};
+
+  for (std::size_t index{0}; index < states.size(); index++)
+  {
+    states[index].edge_begin = edges.size();
+
+    for (std::size_t ch{0}; ch < 256; ch++)
+    {
+      target.clear();
+      bool exclusive{false};
+
+      for (const auto& n : state_sets[index])
+      {
+        for (const auto& edge : nfa[n].edges)
+        {
+          if ( ch < edge.first || ch > edge.last )
+            continue;
+
+          target.push_back(edge.next);
+          exclusive = exclusive || nfa[edge.next].exclusive;
+        }
+      }
+
+      if ( exclusive )
+      {
+        // A mouse report excludes all other sequences
+        target.erase ( std::remove_if ( target.begin(), target.end()
+                                      , [&nfa] (std::size_t n)
+                                        {
+                                          return ! nfa[n].exclusive;
+                                        } )
+                     , target.end() );
+      }
+
+      if ( target.empty() )
+        continue;
+
+      std::sort (target.begin(), target.end());
+      target.erase (std::unique(target.begin(), target.end()), target.end());
+      const auto next = get_state(target);
+
+      if ( next == DEAD_STATE )
+        continue;
+
+      // Merge adjacent characters with the same successor state
+      if ( edges.size() > states[index].edge_begin
+        && edges.back().next == next
+        && std::size_t(edges.back().last) + 1 == ch )
+        edges.back().last = uChar(ch);
+      else
+        edges.push_back({uChar(ch), uChar(ch), next});
+    }
+
+    states[index].edge_end = edges.size();
+  }
+}
+
+}  // namespace finalcut
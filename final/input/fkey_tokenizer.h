@@ -0,0 +1,248 @@
+/***********************************************************************
+* fkey_tokenizer.h - Compiled automaton for terminal input sequences   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FKeyTokenizer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FKEY_TOKENIZER_H
+#define FKEY_TOKENIZER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FKeyTokenizer
+//----------------------------------------------------------------------
+
+class FKeyTokenizer final
+{
+  public:
+    // Enumeration
+    enum class Status : uInt8
+    {
+      Incomplete,  // More characters are required
+      Complete,    // A key, a mouse report or a character
+      Invalid      // No input sequence starts with these characters
+    };
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getStatus() const noexcept -> Status;
+    auto getKey() const noexcept -> FKey;
+    auto getDeferredKey() const noexcept -> FKey;
+    auto getLength() const noexcept -> std::size_t;
+    auto getStateCount() const noexcept -> std::size_t;
+
+    // Mutators
+    template <typename Iter>
+    void setTermcapMap (Iter, Iter);
+    void setUTF8 (bool = true) noexcept;
+    void setMouseSupport (bool = true) noexcept;
+
+    // Inquiry
+    auto isCompiled() const noexcept -> bool;
+
+    // Methods
+    void compile();
+    auto feed (char) noexcept -> Status;
+    void reset() noexcept;
+
+  private:
+    // Enumeration
+    enum class Accept : uInt8
+    {
+      None,       // Prefix of a sequence
+      Character,  // Single character or UTF-8 character
+      Deferred,   // Key that is also a prefix of other keys
+      Key         // Key or mouse report
+    };
+
+    // Constants
+    static constexpr uInt16 DEAD_STATE{UINT16_MAX};
+    static constexpr uInt8 KNOWN_KEY_PRIORITY{1};
+    static constexpr uInt8 TERMCAP_KEY_PRIORITY{2};
+    static constexpr uInt8 MOUSE_PRIORITY{3};
+    static constexpr uInt8 KEYBOARD_PROTOCOL_PRIORITY{3};
+
+    struct Edge
+    {
+      uChar  first;  // Character range
+      uChar  last;
+      uInt16 next;
+    };
+
+    struct State
+    {
+      std::size_t edge_begin;
+      std::size_t edge_end;
+      FKey        key;
+      Accept      accept;
+    };
+
+    struct NfaEdge
+    {
+      uChar       first;
+      uChar       last;
+      std::size_t next;
+    };
+
+    struct NfaState
+    {
+      std::vector<NfaEdge> edges{};
+      FKey   key{FKey::None};
+      Accept accept{Accept::None};
+      uInt8  priority{0};
+      bool   exclusive{false};  // Excludes all parallel alternatives
+    };
+
+    // Using-declarations
+    using TermcapKeys = std::vector<std::pair<std::string, FKey>>;
+    using Nfa = std::vector<NfaState>;
+
+    // Methods
+    static auto addState (Nfa&, bool = false) -> std::size_t;
+    static void addEdge (Nfa&, std::size_t, uChar, uChar, std::size_t);
+    void addCharacters (Nfa&) const;
+    static void addKey (Nfa&, const std::string&, FKey, uInt8, Accept);
+    void addKeys (Nfa&) const;
+    static auto addDigits (Nfa&, std::size_t, bool) -> std::size_t;
+    static void addMouseReports (Nfa&);
+    static void addKeyboardProtocol (Nfa&);
+    void buildDfa (const Nfa&);
+
+    // Data members
+    std::vector<State> states{};
+    std::vector<Edge>  edges{};
+    TermcapKeys        termcap_keys{};
+    uInt16             current_state{0};
+    std::size_t        length{0};
+    Status             status{Status::Incomplete};
+    bool               utf8_input{false};
+    bool               mouse_support{true};
+    bool               compiled{false};
+};
+
+// FKeyTokenizer inline functions
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getClassName() const -> FString
+{ return "FKeyTokenizer"; }
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getStatus() const noexcept -> Status
+{ return status; }
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getKey() const noexcept -> FKey
+{
+  // Returns the recognized key (FKey::None for a character)
+
+  if ( status != Status::Complete )
+    return FKey::None;
+
+  return states[current_state].key;
+}
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getDeferredKey() const noexcept -> FKey
+{
+  // Returns the key that will be recognized after a timeout
+
+  if ( status != Status::Incomplete || states.empty()
+    || states[current_state].accept != Accept::Deferred )
+    return FKey::None;
+
+  return states[current_state].key;
+}
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getLength() const noexcept -> std::size_t
+{ return length; }
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::getStateCount() const noexcept -> std::size_t
+{ return states.size(); }
+
+//----------------------------------------------------------------------
+template <typename Iter>
+inline void FKeyTokenizer::setTermcapMap (Iter first, Iter last)
+{
+  termcap_keys.clear();
+
+  for (auto iter{first}; iter != last; ++iter)
+  {
+    if ( iter->string && iter->length > 0 )
+      termcap_keys.emplace_back(std::string(iter->string, iter->length), iter->num);
+  }
+
+  compiled = false;
+}
+
+//----------------------------------------------------------------------
+inline void FKeyTokenizer::setUTF8 (bool enable) noexcept
+{
+  if ( utf8_input != enable )
+    compiled = false;
+
+  utf8_input = enable;
+}
+
+//----------------------------------------------------------------------
+inline void FKeyTokenizer::setMouseSupport (bool enable) noexcept
+{
+  if ( mouse_support != enable )
+    compiled = false;
+
+  mouse_support = enable;
+}
+
+//----------------------------------------------------------------------
+inline auto FKeyTokenizer::isCompiled() const noexcept -> bool
+{ return compiled; }
+
+//----------------------------------------------------------------------
+inline void FKeyTokenizer::reset() noexcept
+{
+  current_state = 0;
+  length = 0;
+  status = Status::Incomplete;
+}
+
+}  // namespace finalcut
+
+#endif  // FKEY_TOKENIZER_H
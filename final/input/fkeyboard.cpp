@@ -37,6 +37,7 @@
 #include "final/input/fkey_map.h"
 #include "final/output/tty/fterm.h"
 #include "final/output/tty/ftermios.h"
+#include "final/util/fsystem.h"
 
 #if defined(__linux__)
   #include "final/output/tty/ftermlinux.h"
@@ -65,7 +66,8 @@ FKeyboard::FKeyboard()
   time_keypressed = TimeValue{};  // Set to epoch time
 
   // Get the stdin file status flags
-  stdin_status_flags = fcntl(FTermios::getStdIn(), F_GETFL);
+  static const auto& fsys = FSystem::getInstance();
+  stdin_status_flags = fsys->fcntl(FTermios::getStdIn(), F_GETFL);
 
   if ( stdin_status_flags == -1 )
     std::abort();
@@ -125,18 +127,20 @@ void FKeyboard::setNonBlockingInput (bool enable)
   if ( enable == non_blocking_stdin )
     return;
 
+  static const auto& fsys = FSystem::getInstance();
+
   if ( enable )  // make stdin non-blocking
   {
     stdin_status_flags |= O_NONBLOCK;
 
-    if ( fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
+    if ( fsys->fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
       non_blocking_stdin = true;
   }
   else
   {
     stdin_status_flags &= ~O_NONBLOCK;
 
-    if ( fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
+    if ( fsys->fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
       non_blocking_stdin = false;
   }
 }
@@ -144,7 +148,7 @@ void FKeyboard::setNonBlockingInput (bool enable)
 //----------------------------------------------------------------------
 auto FKeyboard::hasUnprocessedInput() const noexcept -> bool
 {
-  return fifo_buf.hasData();
+  return fifo_buf.hasData() || paste_mode;
 }
 
 //----------------------------------------------------------------------
@@ -202,6 +206,9 @@ void FKeyboard::clearKeyBuffer() noexcept
   fkey = FKey::None;
   key = FKey::None;
   fifo_buf.clear();
+  key_tokenizer.reset();
+  paste_buf.clear();
+  paste_mode = false;
 }
 
 //----------------------------------------------------------------------
@@ -209,6 +216,15 @@ void FKeyboard::clearKeyBufferOnTimeout()
 {
   // Empty the buffer on timeout
 
+  if ( paste_mode )
+  {
+    // The terminal has not sent the end of the pasted text
+    if ( isKeypressTimeout() && ! fkey_queue.isFull() )
+      finishPaste();
+
+    return;
+  }
+
   if ( fifo_buf.hasData() && isKeypressTimeout() )
     clearKeyBuffer();
 }
@@ -219,11 +235,15 @@ void FKeyboard::escapeKeyHandling()
   // Send an escape key press event if there is only one 0x1b
   // in the buffer and the timeout is reached
 
+  if ( paste_mode )
+    return;  // Pasted text is not a key input
+
   if ( fifo_buf.getSize() == 1
     && fifo_buf[0] == 0x1b
     && isKeypressTimeout() )
   {
     fifo_buf.clear();
+    key_tokenizer.reset();
     escapeKeyPressedCommand();
   }
 
@@ -239,6 +259,12 @@ void FKeyboard::processQueuedInput()
     key = fkey_queue.front();
     fkey_queue.pop();
 
+    if ( key == FKey::Bracketed_paste )
+    {
+      paste_text.swap(paste_queue.front());
+      paste_queue.pop();
+    }
+
     if ( key > FKey::None )
     {
       keyPressedCommand();
@@ -247,6 +273,7 @@ void FKeyboard::processQueuedInput()
         return;
 
       keyReleasedCommand();
+      paste_text.clear();
 
       if ( FApplication::isQuit() )
         return;
@@ -257,90 +284,6 @@ void FKeyboard::processQueuedInput()
 }
 
 // private methods of FKeyboard
-//----------------------------------------------------------------------
-inline auto FKeyboard::getMouseProtocolKey() const -> FKey
-{
-  // Looking for mouse string in the key buffer
-
-  if ( ! mouse_support )
-    return NOT_SET;
-
-  const auto buf_len = fifo_buf.getSize();
-
-  if ( buf_len < 3 || fifo_buf[1] != '[' )
-    return NOT_SET;
-
-  // x11 mouse tracking
-  if ( fifo_buf[2] == 'M' )
-    return ( buf_len < 6 ) ? FKey::Incomplete : FKey::X11mouse;
-
-  // SGR mouse tracking
-  if ( fifo_buf[2] == '<' )
-  {
-    if ( buf_len < 9 || (fifo_buf[buf_len - 1] != 'M' && fifo_buf[buf_len - 1] != 'm') )
-      return FKey::Incomplete;  // Incomplete mouse sequence
-
-    return FKey::Extended_mouse;
-  }
-
-  // urxvt mouse tracking
-  if ( fifo_buf[2] >= '1' && fifo_buf[2] <= '9'
-    && std::isdigit(fifo_buf[3]) && buf_len >= 9
-    && fifo_buf[buf_len - 1] == 'M' )
-    return FKey::Urxvt_mouse;
-
-  return NOT_SET;
-}
-
-//----------------------------------------------------------------------
-inline auto FKeyboard::getTermcapKey() -> FKey
-{
-  // Looking for termcap key strings in the buffer
-
-  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
-
-  if ( key_cap_ptr.use_count() == 0 )
-    return NOT_SET;
-
-  const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getTermcapKey(fifo_buf);
-
-  if ( found_key != FKey::None )  // found
-  {
-    fifo_buf.pop(buf_len);  // Remove founded entry
-    return found_key;
-  }
-
-  return NOT_SET;
-}
-
-//----------------------------------------------------------------------
-inline auto FKeyboard::getKnownKey() -> FKey
-{
-  // Looking for a known key strings in the buffer
-
-  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
-  const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getKnownKey(fifo_buf);
-
-  if ( found_key != FKey::None )  // found
-  {
-    if ( buf_len == 2
-      && ( fifo_buf[1] == 'O'
-        || fifo_buf[1] == '['
-        || fifo_buf[1] == ']' )
-      && ! isKeypressTimeout() )
-    {
-      return FKey::Incomplete;
-    }
-
-    fifo_buf.pop(buf_len);  // Remove founded entry
-    return found_key;
-  }
-
-  return NOT_SET;
-}
-
 //----------------------------------------------------------------------
 inline auto FKeyboard::getSingleKey() -> FKey
 {
@@ -383,7 +326,10 @@ inline auto FKeyboard::getSingleKey() -> FKey
     keycode = UTF8decode(len);
   }
   else
+  {
+    len = 1;
     keycode = FKey(uChar(firstchar));
+  }
 
   fifo_buf.pop(len);  // Remove founded entry
 
@@ -393,12 +339,90 @@ inline auto FKeyboard::getSingleKey() -> FKey
   return FKey(keycode == FKey(127) ? FKey::Backspace : keycode);
 }
 
+//----------------------------------------------------------------------
+auto FKeyboard::getKeyboardProtocolKey (std::size_t length) -> FKey
+{
+  // Converts a kitty keyboard protocol sequence
+  // (ESC [ code ; modifiers u) into a legacy key code
+
+  std::array<uInt32, 2> param{{0, 1}};
+  std::size_t n{0};
+
+  for (std::size_t i{2}; i + 1 < length; i++)
+  {
+    const auto ch = uChar(fifo_buf[i]);
+
+    if ( ch == ';' )
+    {
+      n++;
+      param[n] = 0;
+    }
+    else if ( param[n] < 0x110000 )
+      param[n] = 10 * param[n] + uInt32(ch - '0');
+  }
+
+  fifo_buf.pop(length);  // Remove founded entry
+  const auto code = param[0];
+  const auto modifiers = ( param[1] > 0 ) ? param[1] - 1 : 0;
+  const bool shift = modifiers & 0x01;
+  const bool alt   = modifiers & 0x02;
+  const bool ctrl  = modifiers & 0x04;
+
+  if ( code == 27 )
+    return FKey::Escape;
+
+  if ( code == 13 )
+    return alt ? FKey::Meta_enter : FKey::Return;
+
+  if ( code == 9 )
+  {
+    if ( shift )
+      return FKey::Back_tab;
+
+    return alt ? FKey::Meta_tab : FKey::Tab;
+  }
+
+  if ( code == 127 )
+    return FKey::Backspace;
+
+  if ( code >= 0x80 )  // Unicode character or private use key
+    return ( code < 0xe000 || code > 0xf8ff ) ? FKey(code) : FKey::None;
+
+  auto ch = code;
+
+  if ( shift && ch >= 'a' && ch <= 'z' )
+    ch -= 'a' - 'A';
+
+  if ( ctrl )
+  {
+    if ( ch == ' ' || ch == '@' )
+      return FKey::Ctrl_space;
+
+    if ( ch >= '@' && ch <= '~' )
+      ch &= 0x1f;
+  }
+
+  // Meta + printable character or Meta + control character (Ctrl+Alt)
+  if ( alt && ch > 0 && ch <= '~' )
+    return FKey::Meta_offset + FKey(ch);
+
+  return FKey(ch);
+}
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::isKeypressTimeout() -> bool
 {
   return FObjectTimer::isTimeout (time_keypressed, key_timeout);
 }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::isMouseKey (const FKey keycode) noexcept -> bool
+{
+  return keycode == FKey::X11mouse
+      || keycode == FKey::Extended_mouse
+      || keycode == FKey::Urxvt_mouse;
+}
+
 //----------------------------------------------------------------------
 auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 {
@@ -448,78 +472,219 @@ auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 }
 
 //----------------------------------------------------------------------
-inline auto FKeyboard::readKey() -> ssize_t
+inline auto FKeyboard::readKey (std::size_t length) -> ssize_t
 {
+  // Reads all available characters with a single system call
+  // directly into the free space of the fifo buffer
+
+  static const auto& fsys = FSystem::getInstance();
   setNonBlockingInput();
-  const ssize_t bytes = read(FTermios::getStdIn(), &read_character, 1);
-  unsetNonBlockingInput();
+  const auto bytes = fsys->read ( FTermios::getStdIn()
+                                , fifo_buf.getWritePosition()
+                                , length );
+
+  if ( bytes > 0 )
+    fifo_buf.commit(std::size_t(bytes));
+
   return bytes;
 }
 
 //----------------------------------------------------------------------
 void FKeyboard::parseKeyBuffer()
 {
-  while ( readKey() > 0 )
+  // Characters that did not fit into the full key queue
+  // are processed first
+  parseFifoBuffer();
+
+  while ( ! fkey_queue.isFull() )
   {
+    if ( fifo_buf.isEmpty() )
+      fifo_buf.clear();  // Makes the entire buffer contiguous
+
+    const auto length = fifo_buf.getContiguousFreeSpace();
+
+    if ( length == 0 )
+      break;
+
+    const auto bytes = readKey(length);
+
+    if ( bytes <= 0 )
+      break;
+
+    // A short read does not indicate an empty input queue,
+    // because a terminal in canonical mode returns only one line
     time_keypressed = FObjectTimer::getCurrentTime();
     has_pending_input = false;
+    parseFifoBuffer();
+  }
 
-    if ( ! fifo_buf.isFull() )
-      fifo_buf.push(read_character);
+  // stdin usually shares its file status flags with stdout,
+  // so it stays non-blocking only while reading
+  unsetNonBlockingInput();
+  has_pending_input = fkey_queue.isFull() && fifo_buf.hasData();
+}
 
-    // Read the rest from the fifo buffer
-    while ( fifo_buf.hasData() && fkey != FKey::Incomplete )
+//----------------------------------------------------------------------
+void FKeyboard::parseFifoBuffer()
+{
+  while ( fifo_buf.hasData() && ! fkey_queue.isFull() )
+  {
+    if ( paste_mode )
     {
-      fkey = parseKeyString();
-      fkey = keyCorrection(fkey);
-
-      if ( fkey == FKey::X11mouse
-        || fkey == FKey::Extended_mouse
-        || fkey == FKey::Urxvt_mouse )
-      {
-        key = fkey;
-        mouseTrackingCommand();
-        break;
-      }
-
-      if ( fkey != FKey::Incomplete )
-        fkey_queue.emplace(fkey);
+      if ( ! parsePasteBuffer() )
+        break;  // Wait for the rest of the pasted text
+
+      continue;
     }
 
-    fkey = FKey::None;
+    fkey = parseKeyString();
 
-    if ( fkey_queue.isFull() )
+    if ( fkey == FKey::Incomplete )
       break;
+
+    fkey = keyCorrection(fkey);
+
+    if ( isMouseKey(fkey) )
+    {
+      const auto length = key_tokenizer.getLength();
+      const auto buf_len = fifo_buf.getSize();
+      key_tokenizer.reset();
+      key = fkey;
+      mouseTrackingCommand();
+
+      if ( fifo_buf.getSize() == buf_len )
+        fifo_buf.pop(length);  // Mouse report was not processed
+
+      continue;
+    }
+
+    if ( fkey == FKey::Bracketed_paste_start )
+    {
+      paste_mode = true;
+      paste_buf.clear();
+      continue;
+    }
+
+    if ( fkey == FKey::None  // Key without legacy encoding
+      || fkey == FKey::Bracketed_paste_end )
+      continue;
+
+    fkey_queue.emplace(fkey);
   }
+
+  fkey = FKey::None;
 }
 
 //----------------------------------------------------------------------
 auto FKeyboard::parseKeyString() -> FKey
 {
-  const auto& firstchar = fifo_buf.front();
+  // Feeds the characters that have not yet been scanned
+  // into the key tokenizer
 
-  if ( firstchar != ESC[0] )
-    return getSingleKey();
+  using Status = FKeyTokenizer::Status;
 
-  if ( fifo_buf.getSize() == 1 )
-    return isKeypressTimeout() ? getSingleKey() : FKey::Incomplete;
+  if ( ! key_tokenizer.isCompiled() )
+    key_tokenizer.compile();
 
-  FKey keycode = getMouseProtocolKey();
+  const auto buf_len = fifo_buf.getSize();
 
-  if ( keycode != NOT_SET )
-    return keycode;
+  if ( key_tokenizer.getLength() > buf_len )
+    key_tokenizer.reset();  // The buffer was changed from outside
 
-  keycode = getTermcapKey();
+  auto status = key_tokenizer.getStatus();
 
-  if ( keycode != NOT_SET )
-    return keycode;
+  while ( status == Status::Incomplete && key_tokenizer.getLength() < buf_len )
+    status = key_tokenizer.feed(fifo_buf[key_tokenizer.getLength()]);
+
+  if ( status == Status::Complete )
+  {
+    const auto keycode = key_tokenizer.getKey();
+
+    // The mouse report remains in the buffer for the mouse handler
+    if ( isMouseKey(keycode) )
+      return keycode;
+
+    const auto length = key_tokenizer.getLength();
+    key_tokenizer.reset();
 
-  keycode = getKnownKey();
+    if ( keycode == FKey::None )
+      return getSingleKey();
 
-  if ( keycode != NOT_SET )
+    if ( keycode == FKey::Kitty_keyboard )
+      return getKeyboardProtocolKey(length);
+
+    fifo_buf.pop(length);  // Remove founded entry
     return keycode;
+  }
+
+  // Incomplete or invalid sequences are kept until the timeout
+  if ( ! isKeypressTimeout() )
+    return FKey::Incomplete;
+
+  const auto deferred_key = key_tokenizer.getDeferredKey();
+  const auto length = key_tokenizer.getLength();
+  key_tokenizer.reset();
+
+  if ( deferred_key != FKey::None )
+  {
+    fifo_buf.pop(length);
+    return deferred_key;
+  }
+
+  return getSingleKey();
+}
+
+//----------------------------------------------------------------------
+auto FKeyboard::parsePasteBuffer() -> bool
+{
+  // Collects the pasted text up to the end sequence
+  // without interpreting the characters as keys
 
-  return isKeypressTimeout() ? getSingleKey() : FKey::Incomplete;
+  static constexpr std::array<char, 6> paste_end{{'\033', '[', '2', '0', '1', '~'}};
+  const auto buf_len = fifo_buf.getSize();
+  std::size_t length{0};  // Length of the text before the end sequence
+  std::size_t match{0};
+
+  while ( match < paste_end.size() && length + match < buf_len )
+  {
+    if ( fifo_buf[length + match] == paste_end[match] )
+      match++;
+    else
+    {
+      length++;
+      match = 0;
+    }
+  }
+
+  paste_buf.append (fifo_buf.begin(), fifo_buf.begin() + std::ptrdiff_t(length));
+
+  if ( match < paste_end.size() )
+  {
+    // Keep a possibly incomplete end sequence in the buffer
+    fifo_buf.pop(length);
+    return false;
+  }
+
+  fifo_buf.pop(length + match);
+  paste_mode = false;
+  paste_queue.emplace(std::move(paste_buf));
+  paste_buf.clear();
+  fkey_queue.emplace(FKey::Bracketed_paste);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::finishPaste()
+{
+  // Delivers the pasted text received so far
+
+  paste_buf.append (fifo_buf.begin(), fifo_buf.end());
+  fifo_buf.clear();
+  key_tokenizer.reset();
+  paste_mode = false;
+  paste_queue.emplace(std::move(paste_buf));
+  paste_buf.clear();
+  fkey_queue.emplace(FKey::Bracketed_paste);
 }
 
 //----------------------------------------------------------------------
@@ -564,6 +729,7 @@ void FKeyboard::substringKeyHandling()
 
     fkey_queue.emplace(fkey);
     fifo_buf.clear();
+    key_tokenizer.reset();
   }
 }
 
@@ -45,8 +45,8 @@
 #include <utility>
 
 #include "final/ftypes.h"
-#include "final/input/fkey_hashmap.h"
 #include "final/input/fkey_map.h"
+#include "final/input/fkey_tokenizer.h"
 #include "final/util/char_ringbuffer.h"
 #include "final/util/fstring.h"
 
@@ -90,7 +90,7 @@ class FKeyboard final
 {
   public:
     // Constants
-    static constexpr std::size_t FIFO_BUF_SIZE{512};
+    static constexpr std::size_t FIFO_BUF_SIZE{4096};
 
     // Using-declaration
     using keybuffer = CharRingBuffer<FIFO_BUF_SIZE>;
@@ -115,6 +115,7 @@ class FKeyboard final
     static auto getInstance() -> FKeyboard&;
     auto  getKey() const noexcept -> FKey;
     auto  getKeyName (const FKey) const -> FString;
+    auto  getPasteText() const noexcept -> const std::string&;
     auto  getKeyBuffer() & noexcept -> keybuffer&;
     auto  getKeyPressedTime() const noexcept -> TimeValue;
     static auto  getKeypressTimeout() noexcept -> uInt64;
@@ -160,22 +161,25 @@ class FKeyboard final
     using FKeyMapPtr = std::shared_ptr<FKeyMap::KeyCapMapType>;
     using KeyMapEnd = FKeyMap::KeyCapMapType::const_iterator;
     using KeyQueue = FRingBuffer<FKey, MAX_QUEUE_SIZE>;
+    using PasteQueue = FRingBuffer<std::string, MAX_QUEUE_SIZE>;
 
-    // Accessors
-    auto  getMouseProtocolKey() const -> FKey;
-    auto  getTermcapKey() -> FKey;
-    auto  getKnownKey() -> FKey;
+    // Accessor
     auto  getSingleKey() -> FKey;
+    auto  getKeyboardProtocolKey (std::size_t) -> FKey;
 
-    // Predicate
+    // Predicates
     static auto isKeypressTimeout() -> bool;
+    static auto isMouseKey (const FKey) noexcept -> bool;
     static auto isIntervalTimeout() -> bool;
 
     // Methods
     auto  UTF8decode (const std::size_t) const noexcept -> FKey;
-    auto  readKey() -> ssize_t;
+    auto  readKey (std::size_t) -> ssize_t;
     void  parseKeyBuffer();
+    void  parseFifoBuffer();
     auto  parseKeyString() -> FKey;
+    auto  parsePasteBuffer() -> bool;
+    void  finishPaste();
     auto  keyCorrection (const FKey&) const -> FKey;
     void  substringKeyHandling();
     void  keyPressedCommand() const;
@@ -197,15 +201,18 @@ class FKeyboard final
     FKeyMapPtr        key_cap_ptr{};
     KeyMapEnd         key_cap_end{};
     keybuffer         fifo_buf{};
+    FKeyTokenizer     key_tokenizer{};
     KeyQueue          fkey_queue{};
+    PasteQueue        paste_queue{};
+    std::string       paste_buf{};
+    std::string       paste_text{};
     FKey              fkey{FKey::None};
     FKey              key{FKey::None};
     int               stdin_status_flags{0};
-    char              read_character{};
     bool              has_pending_input{false};
+    bool              paste_mode{false};
     bool              fifo_in_use{false};
     bool              utf8_input{false};
-    bool              mouse_support{true};
     bool              non_blocking_stdin{false};
 };
 
@@ -218,6 +225,10 @@ inline auto FKeyboard::getClassName() const -> FString
 inline auto FKeyboard::getKey() const noexcept -> FKey
 { return key; }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getPasteText() const noexcept -> const std::string&
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::getKeyBuffer() & noexcept -> keybuffer&
 { return fifo_buf; }
@@ -240,7 +251,7 @@ inline void FKeyboard::setTermcapMap (const T& keymap)
 {
   key_cap_ptr = std::make_shared<T>(keymap);
   key_cap_end = key_cap_ptr->cend();
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  key_tokenizer.setTermcapMap(key_cap_ptr->cbegin(), key_cap_end);
 }
 
 //----------------------------------------------------------------------
@@ -254,7 +265,7 @@ inline void FKeyboard::setTermcapMap()
                              , [] (const FKeyMap::KeyCapMap& entry)
                                { return entry.length == 0; }
                              );
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  key_tokenizer.setTermcapMap(key_cap_ptr->cbegin(), key_cap_end);
 }
 
 //----------------------------------------------------------------------
@@ -283,19 +294,25 @@ inline auto FKeyboard::hasDataInQueue() const -> bool
 
 //----------------------------------------------------------------------
 inline void FKeyboard::enableUTF8() noexcept
-{ utf8_input = true; }
+{
+  utf8_input = true;
+  key_tokenizer.setUTF8(true);
+}
 
 //----------------------------------------------------------------------
 inline void FKeyboard::disableUTF8() noexcept
-{ utf8_input = false; }
+{
+  utf8_input = false;
+  key_tokenizer.setUTF8(false);
+}
 
 //----------------------------------------------------------------------
 inline void FKeyboard::enableMouseSequences() noexcept
-{ mouse_support = true; }
+{ key_tokenizer.setMouseSupport(true); }
 
 //----------------------------------------------------------------------
 inline void FKeyboard::disableMouseSequences() noexcept
-{ mouse_support = false; }
+{ key_tokenizer.setMouseSupport(false); }
 
 //----------------------------------------------------------------------
 inline void FKeyboard::setPressCommand (const FKeyboardCommand& cmd)
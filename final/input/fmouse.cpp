@@ -202,6 +202,32 @@ void FMouseData::clearButtonState() noexcept
   b_state.mouse_moved    = false;
 }
 
+//----------------------------------------------------------------------
+auto FMouseData::coalesceMove (const FMouseData& md) noexcept -> bool
+{
+  // Takes over the position of a subsequent mouse movement
+  // with the same button state. Only the last position of
+  // consecutive movements needs to be processed.
+
+  const auto& next = md.b_state;
+
+  if ( ! b_state.mouse_moved || ! next.mouse_moved
+    || b_state.wheel_up || b_state.wheel_down
+    || b_state.wheel_left || b_state.wheel_right
+    || next.wheel_up || next.wheel_down
+    || next.wheel_left || next.wheel_right
+    || b_state.left_button != next.left_button
+    || b_state.right_button != next.right_button
+    || b_state.middle_button != next.middle_button
+    || b_state.shift_button != next.shift_button
+    || b_state.control_button != next.control_button
+    || b_state.meta_button != next.meta_button )
+    return false;
+
+  mouse = md.mouse;
+  return true;
+}
+
 
 // protected methods of FMouseData
 //----------------------------------------------------------------------
@@ -1793,15 +1819,11 @@ void FMouseControl::processQueuedInput()
     if ( FApplication::isQuit() )
       return;
 
-    FMouseDataPtr md(std::move(fmousedata_queue.front()));
+    FMouseData md(fmousedata_queue.front());
     fmousedata_queue.pop();
-
-    if ( md )
-    {
-      setCurrentMouseEvent (md);
-      event_cmd.execute(*md);
-      resetCurrentMouseEvent();
-    }
+    setCurrentMouseEvent (md);
+    event_cmd.execute(md);
+    resetCurrentMouseEvent();
 
     if ( FApplication::isQuit() )
       return;
@@ -1819,8 +1841,15 @@ void FMouseControl::processEvent (const TimeValue& time)
   if ( iter != mouse_protocol.end() )
   {
     (*iter)->processEvent(time);
-    auto& md = static_cast<FMouseData&>(**iter);
-    fmousedata_queue.emplace(std::make_unique<FMouseData>(std::move(md)));
+    const auto& md = static_cast<FMouseData&>(**iter);
+
+    // A movement replaces the preceding queued movement
+    // with the same button state
+    if ( fmousedata_queue.hasData()
+      && fmousedata_queue.back().coalesceMove(md) )
+      return;
+
+    fmousedata_queue.push(md);
   }
 }
 
@@ -1913,9 +1942,10 @@ void FMouseControl::xtermMouse (bool enable) const
 }
 
 //----------------------------------------------------------------------
-void FMouseControl::setCurrentMouseEvent (const FMouseDataPtr& ptr)
+void FMouseControl::setCurrentMouseEvent (FMouseData& md)
 {
-  getCurrentMouseEvent() = ptr;
+  // Non-owning pointer to the mouse event during its dispatch
+  getCurrentMouseEvent() = FMouseDataPtr(FMouseDataPtr{}, &md);
 }
 
 //----------------------------------------------------------------------
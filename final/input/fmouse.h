@@ -133,6 +133,7 @@ class FMouseData
 
     // Methods
     void clearButtonState() noexcept;
+    auto coalesceMove (const FMouseData&) noexcept -> bool;
 
   protected:
     // Enumerations
@@ -650,7 +651,7 @@ class FMouseControl
     // Using-declarations
     using FMousePtr = std::unique_ptr<FMouse>;
     using FMouseProtocol = std::vector<FMousePtr>;
-    using MouseQueue = FRingBuffer<FMouseDataPtr, MAX_QUEUE_SIZE>;
+    using MouseQueue = FRingBuffer<FMouseData, MAX_QUEUE_SIZE>;
 
     // Accessor
     auto  findMouseWithType (const FMouse::MouseType&) const -> FMouseProtocol::const_iterator;
@@ -661,7 +662,7 @@ class FMouseControl
     void  xtermMouse (bool = true) const;
     void  enableXTermMouse() const;
     void  disableXTermMouse() const;
-    static void  setCurrentMouseEvent (const FMouseDataPtr&);
+    static void  setCurrentMouseEvent (FMouseData&);
     static void  resetCurrentMouseEvent();
 
     // Data member
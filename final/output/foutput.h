@@ -110,12 +110,15 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     // Methods
     virtual void initTerminal (FVTerm::FTermRegion*) = 0;
     virtual void finishTerminal() = 0;
+    virtual void beginSynchronizedUpdate() = 0;
     virtual auto updateTerminal() -> bool = 0;
+    virtual void endSynchronizedUpdate() = 0;
     virtual void detectTerminalSize() = 0;
     virtual void commitTerminalResize() = 0;
     virtual void initScreenSettings() = 0;
     virtual auto scrollTerminalForward() -> bool = 0;
     virtual auto scrollTerminalReverse() -> bool = 0;
+    virtual auto scrollTerminalRegion (int, int, int, std::size_t) -> bool = 0;
     virtual void clearTerminalAttributes() = 0;
     virtual void clearTerminalState() = 0;
     virtual auto clearTerminal (wchar_t = L' ') -> bool = 0;
@@ -0,0 +1,100 @@
+/***********************************************************************
+* fbandwidthbudget.cpp - Output byte budget for slow terminal links    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/output/tty/fbandwidthbudget.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FBandwidthBudget
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr std::size_t FBandwidthBudget::MIN_FRAME_BUDGET;
+constexpr uInt64 FBandwidthBudget::MIN_SAMPLE_DURATION;
+constexpr uInt64 FBandwidthBudget::MAX_THROUGHPUT;
+constexpr uInt FBandwidthBudget::MAX_SERIAL_BAUDRATE;
+
+
+// public methods of FBandwidthBudget
+//----------------------------------------------------------------------
+auto FBandwidthBudget::getFrameBudget (uInt64 frame_time_us) const noexcept -> std::size_t
+{
+  // Returns the number of bytes the link can transfer within one
+  // frame time (0 = unlimited)
+
+  if ( throughput == 0 )
+    return 0;
+
+  const auto budget = std::size_t(throughput * frame_time_us / 1'000'000);
+  return std::max(budget, MIN_FRAME_BUDGET);
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudget::setBaudRate (uInt baud) noexcept
+{
+  // A serial line transfers 10 bits per byte (start + 8 data + stop).
+  // Pseudo terminals report 38400 baud, which says nothing about
+  // the real link speed.
+
+  if ( baud == 0 || baud >= MAX_SERIAL_BAUDRATE )
+    return;
+
+  throughput = std::max(uInt64(baud / 10), uInt64(1));
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudget::addSample (std::size_t bytes, uInt64 duration_us) noexcept
+{
+  // Estimates the throughput from the duration of a blocking write.
+  // The write only blocks when the kernel buffer is full, i.e. when
+  // the output is faster than the link.
+
+  if ( bytes == 0 )
+    return;
+
+  if ( duration_us < MIN_SAMPLE_DURATION )
+  {
+    // The link has absorbed the output without delay,
+    // so probe for a higher throughput
+    if ( throughput > 0 )
+      throughput += throughput / 8 + 1;
+
+    if ( throughput > MAX_THROUGHPUT )
+      throughput = 0;  // Fast enough to be unlimited
+
+    return;
+  }
+
+  const auto rate = std::max(uInt64(bytes) * 1'000'000 / duration_us, uInt64(1));
+
+  if ( rate > MAX_THROUGHPUT )
+    return;
+
+  // Exponential moving average (weight 1/4)
+  throughput = ( throughput == 0 ) ? rate : (3 * throughput + rate) / 4;
+}
+
+}  // namespace finalcut
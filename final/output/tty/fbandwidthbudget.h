@@ -0,0 +1,98 @@
+/***********************************************************************
+* fbandwidthbudget.h - Output byte budget for slow terminal links      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FBandwidthBudget ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FBANDWIDTHBUDGET_H
+#define FBANDWIDTHBUDGET_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FBandwidthBudget
+//----------------------------------------------------------------------
+
+class FBandwidthBudget final
+{
+  public:
+    // Constants
+    static constexpr std::size_t MIN_FRAME_BUDGET    = 512;          // Bytes
+    static constexpr uInt64      MIN_SAMPLE_DURATION = 2'000;        //   2 ms
+    static constexpr uInt64      MAX_THROUGHPUT      = 16'777'216;   //  16 MB/s
+    static constexpr uInt        MAX_SERIAL_BAUDRATE = 38'400;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getThroughput() const noexcept -> uInt64;
+    auto getFrameBudget (uInt64) const noexcept -> std::size_t;
+
+    // Mutator
+    void setBaudRate (uInt) noexcept;
+
+    // Inquiry
+    auto isLimited() const noexcept -> bool;
+
+    // Methods
+    void addSample (std::size_t, uInt64) noexcept;
+    void reset() noexcept;
+
+  private:
+    // Data member
+    uInt64  throughput{0};  // Bytes per second (0 = unlimited)
+};
+
+// FBandwidthBudget inline functions
+//----------------------------------------------------------------------
+inline auto FBandwidthBudget::getClassName() const -> FString
+{ return "FBandwidthBudget"; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthBudget::getThroughput() const noexcept -> uInt64
+{ return throughput; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthBudget::isLimited() const noexcept -> bool
+{ return throughput > 0; }
+
+//----------------------------------------------------------------------
+inline void FBandwidthBudget::reset() noexcept
+{ throughput = 0; }
+
+}  // namespace finalcut
+
+#endif  // FBANDWIDTHBUDGET_H
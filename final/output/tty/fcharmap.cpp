@@ -22,6 +22,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "final/fc.h"
 #include "final/ftypes.h"
@@ -30,6 +31,70 @@
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// class CharEncodeIndex
+//----------------------------------------------------------------------
+
+class CharEncodeIndex
+{
+  public:
+    // Two-level index over the Basic Multilingual Plane: the high byte
+    // of the code point selects a page, the low byte the map position
+    // within this page (0 = not found)
+
+    explicit CharEncodeIndex (const FCharMap::CharEncodeType& char_map)
+    {
+      pages.emplace_back();  // Page 0 stays empty
+
+      for (std::size_t pos{0}; pos < char_map.size(); pos++)
+      {
+        const auto ucs = uInt32(char_map[pos].encoding.unicode);
+
+        if ( ucs > 0xffff )
+          continue;
+
+        auto& page = page_index[ucs >> 8];
+
+        if ( page == 0 )
+        {
+          page = uInt8(pages.size());
+          pages.emplace_back();
+        }
+
+        auto& entry = pages[page][ucs & 0xff];
+
+        if ( entry == 0 )  // The first entry of a code point wins
+          entry = uInt8(pos + 1);
+      }
+    }
+
+    auto find (wchar_t ucs) const noexcept -> std::size_t
+    {
+      const auto code = uInt32(ucs);
+
+      if ( code > 0xffff )
+        return 0;
+
+      return pages[page_index[code >> 8]][code & 0xff];
+    }
+
+  private:
+    // Using-declaration
+    using Page = std::array<uInt8, 256>;
+
+    // Data members
+    std::array<uInt8, 256> page_index{};
+    std::vector<Page>      pages{};
+};
+
+static_assert ( std::tuple_size<FCharMap::CharEncodeType>::value < 256
+              , "The map position must fit into one byte" );
+
+}  // namespace internal
+
 //----------------------------------------------------------------------
 auto FCharMap::getInstance() -> FCharMap&
 {
@@ -76,6 +141,22 @@ auto FCharMap::getCharEncodeMap() -> CharEncodeType&
   return character;
 }
 
+//----------------------------------------------------------------------
+auto FCharMap::findCharEncode (wchar_t ucs) -> const CharEncodeMap*
+{
+  // Finds the map entry of a Unicode character in constant time.
+  // The index only stores positions, so that later changes to the
+  // encoded characters of the map remain visible.
+
+  static const internal::CharEncodeIndex index{character};
+  const auto pos = index.find(ucs);
+
+  if ( pos == 0 )
+    return nullptr;
+
+  return &character[pos - 1];
+}
+
 //----------------------------------------------------------------------
 auto FCharMap::getDECSpecialGraphics() -> const DECGraphicsType&
 {
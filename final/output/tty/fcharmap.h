@@ -79,6 +79,7 @@ class FCharMap final
     static auto getCharacter ( const CharEncodeMap& char_enc
                              , const Encoding& enc ) -> const wchar_t&;
     static auto getCharEncodeMap() -> CharEncodeType&;
+    static auto findCharEncode (wchar_t) -> const CharEncodeMap*;
     static auto getDECSpecialGraphics() -> const DECGraphicsType&;
     static auto getCP437UCSMap() -> const Cp437UcsType&;
     static auto getHalfFullWidthMap() -> const HalfFullWidthType&;
@@ -0,0 +1,116 @@
+/***********************************************************************
+* fflushtiming.cpp - Flush timing from the terminal drain rate         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/output/tty/fflushtiming.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FFlushTiming
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr uInt64 FFlushTiming::DEFAULT_LATENCY;
+constexpr uInt64 FFlushTiming::MAX_FLUSH_WAIT;
+constexpr uInt64 FFlushTiming::MIN_SAMPLE_DURATION;
+
+
+// public methods of FFlushTiming
+//----------------------------------------------------------------------
+void FFlushTiming::setTargetLatency (uInt64 latency_us) noexcept
+{
+  // The target latency is the minimum time between two flushes.
+  // A latency of 0 writes every change immediately.
+
+  target_latency = latency_us;
+  flush_wait = latency_us;  // Recalculated with the next write
+}
+
+//----------------------------------------------------------------------
+void FFlushTiming::addWrite ( std::size_t bytes, uInt64 write_us
+                            , std::size_t queued, uInt64 now_us ) noexcept
+{
+  // Adjusts the flush wait time after a write of bytes that took
+  // write_us. queued is the number of bytes that remain in the
+  // terminal output queue (TIOCOUTQ, 0 = empty or unknown).
+
+  if ( last_queued > 0 && now_us > last_sample_us )
+  {
+    // Bytes the terminal has taken from its output queue
+    const auto total = uInt64(last_queued) + uInt64(bytes);
+    const auto drained = ( total > queued ) ? total - queued : 0;
+    const auto rate = drained * 1'000'000 / (now_us - last_sample_us);
+
+    // If the old queue content is not completely drained, the terminal
+    // was busy for the whole interval. Otherwise, the rate is a lower
+    // bound that can only raise the estimate.
+    if ( drained < last_queued || rate > drain_rate )
+      updateDrainRate (rate);
+  }
+  else if ( write_us >= MIN_SAMPLE_DURATION && bytes > 0 )
+  {
+    // A blocking write shows the rate at which the terminal reads
+    updateDrainRate (uInt64(bytes) * 1'000'000 / write_us);
+  }
+
+  last_queued = queued;
+  last_sample_us = now_us;
+
+  // Time until the terminal has processed the output
+  uInt64 backlog_us{0};
+
+  if ( queued > 0 && drain_rate > 0 )
+    backlog_us = uInt64(queued) * 1'000'000 / drain_rate;
+
+  if ( write_us >= MIN_SAMPLE_DURATION )
+    backlog_us = std::max(backlog_us, write_us);
+
+  // A drained terminal gets the next change after the target latency,
+  // a busy terminal receives the accumulated changes after draining
+  flush_wait = std::max(target_latency, std::min(backlog_us, MAX_FLUSH_WAIT));
+}
+
+//----------------------------------------------------------------------
+void FFlushTiming::reset() noexcept
+{
+  flush_wait = target_latency;
+  drain_rate = 0;
+  last_sample_us = 0;
+  last_queued = 0;
+}
+
+
+// private methods of FFlushTiming
+//----------------------------------------------------------------------
+inline void FFlushTiming::updateDrainRate (uInt64 rate) noexcept
+{
+  if ( rate == 0 )
+    return;
+
+  // Exponential moving average (weight 1/4)
+  drain_rate = ( drain_rate == 0 ) ? rate : (3 * drain_rate + rate) / 4;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,109 @@
+/***********************************************************************
+* fflushtiming.h - Flush timing from the terminal drain rate           *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FFlushTiming ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FFLUSHTIMING_H
+#define FFLUSHTIMING_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FFlushTiming
+//----------------------------------------------------------------------
+
+class FFlushTiming final
+{
+  public:
+    // Constants
+    static constexpr uInt64 DEFAULT_LATENCY     = 16'667;   //  16.6 ms = 60 Hz
+    static constexpr uInt64 MAX_FLUSH_WAIT      = 200'000;  // 200.0 ms = 5 Hz
+    static constexpr uInt64 MIN_SAMPLE_DURATION = 2'000;    //   2.0 ms
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getTargetLatency() const noexcept -> uInt64;
+    auto getFlushWait() const noexcept -> uInt64;
+    auto getDrainRate() const noexcept -> uInt64;
+
+    // Mutator
+    void setTargetLatency (uInt64) noexcept;
+
+    // Inquiry
+    auto isFlushTimeout (uInt64) const noexcept -> bool;
+
+    // Methods
+    void addWrite (std::size_t, uInt64, std::size_t, uInt64) noexcept;
+    void reset() noexcept;
+
+  private:
+    // Method
+    void updateDrainRate (uInt64) noexcept;
+
+    // Data members
+    uInt64       target_latency{DEFAULT_LATENCY};
+    uInt64       flush_wait{DEFAULT_LATENCY};
+    uInt64       drain_rate{0};       // Bytes per second (0 = unknown)
+    uInt64       last_sample_us{0};
+    std::size_t  last_queued{0};      // Bytes in the terminal output queue
+};
+
+// FFlushTiming inline functions
+//----------------------------------------------------------------------
+inline auto FFlushTiming::getClassName() const -> FString
+{ return "FFlushTiming"; }
+
+//----------------------------------------------------------------------
+inline auto FFlushTiming::getTargetLatency() const noexcept -> uInt64
+{ return target_latency; }
+
+//----------------------------------------------------------------------
+inline auto FFlushTiming::getFlushWait() const noexcept -> uInt64
+{ return flush_wait; }
+
+//----------------------------------------------------------------------
+inline auto FFlushTiming::getDrainRate() const noexcept -> uInt64
+{ return drain_rate; }
+
+//----------------------------------------------------------------------
+inline auto FFlushTiming::isFlushTimeout (uInt64 elapsed_us) const noexcept -> bool
+{ return elapsed_us >= flush_wait; }
+
+}  // namespace finalcut
+
+#endif  // FFLUSHTIMING_H
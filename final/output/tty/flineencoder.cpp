@@ -0,0 +1,447 @@
+/***********************************************************************
+* flineencoder.cpp - Minimum-cost encoding of a terminal line span     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "final/output/tty/flineencoder.h"
+#include "final/output/tty/foptiattr.h"
+#include "final/output/tty/frowscanner.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline auto hasSameLineStyle (const FChar& lhs, const FChar& rhs) noexcept -> bool
+{
+  // Same comparison as in FTermOutput::appendAttributes()
+
+  return lhs.color.data == rhs.color.data
+      && (lhs.attr.data & 0x0000ffffU) == (rhs.attr.data & 0x0000ffffU);
+}
+
+//----------------------------------------------------------------------
+inline auto getLineStyleCost ( const FChar& from, const FChar& to
+                             , const FLineEncoder::CostModel& model ) -> uInt
+{
+  if ( hasSameLineStyle(from, to) || ! model.attribute_change )
+    return 0;
+
+  return model.attribute_change(from, to);
+}
+
+//----------------------------------------------------------------------
+inline auto getLineMoveCost ( uInt from, uInt to
+                            , const FLineEncoder::CostModel& model ) -> uInt
+{
+  return model.cursor_move ? model.cursor_move(from, to) : 0;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FLineEncoder
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr std::size_t FLineEncoder::MAX_ATTRIBUTE_CLASSES;
+constexpr uInt FLineEncoder::NO_PATH;
+
+
+// public methods of FLineEncoder
+//----------------------------------------------------------------------
+auto FLineEncoder::encode ( const FChar* first, const FChar* last
+                          , const FChar& term_attribute
+                          , const CostModel& model ) -> bool
+{
+  // Finds the cheapest encoding of the cells [first, last) by dynamic
+  // programming. A state is the cursor column together with the
+  // current attribute class. Printing, repeating and erasing move to
+  // the attribute class of the cell, skipping unchanged cells keeps
+  // it. Operations over a run of cells start only at anchor columns,
+  // which include every column the greedy encoder can reach.
+  // Returns false if the span has too many different attributes.
+
+  plan.clear();
+  cost = 0;
+  const auto n = std::size_t(last - first);
+
+  if ( n == 0 )
+    return true;
+
+  if ( ! assignAttributeClasses(first, n, term_attribute) )
+    return false;
+
+  choices.assign((n + 1) * class_count, Choice{});
+  choices[0].cost = 0;  // Column 0 with the terminal attributes
+  anchors.assign(n + 1, false);
+
+  for (std::size_t i{0}; i < n; i++)
+  {
+    const auto& cell = first[i];
+    const auto to_class = cell_class[i];
+    const auto run = FRowScanner::countEqual(first + i, last, cell);
+    const auto char_cost = model.character ? model.character(cell) : 1;
+    uInt repeat_cost{0};
+    uInt erase_cost{0};
+    uInt skip_cost{NO_PATH};
+    std::size_t unchanged{0};
+    const bool anchor = isAnchor(first, i);
+
+    if ( anchor && run > 1 && model.repeat_character )
+      repeat_cost = model.repeat_character(cell, uInt(run));
+
+    if ( anchor && run > 1 && model.erase_characters && isErasable(cell, model) )
+    {
+      erase_cost = model.erase_characters(uInt(run));
+
+      if ( erase_cost > 0 && i + run < n )
+      {
+        const auto move = internal::getLineMoveCost(uInt(i), uInt(i + run), model);
+        erase_cost = ( move > 0 ) ? erase_cost + move : 0;
+      }
+    }
+
+    if ( anchor && cell.isBitSet(FAttribute::set::no_changes) )
+    {
+      unchanged = FRowScanner::countUnchanged(first + i, last);
+
+      const auto move = internal::getLineMoveCost(uInt(i), uInt(i + unchanged), model);
+
+      if ( i + unchanged >= n )
+        skip_cost = 0;  // The cursor does not have to follow
+      else if ( move > 0 )
+        skip_cost = move;
+    }
+
+    const bool clear_eol = model.clear_to_eol > 0
+                        && model.reaches_eol
+                        && i + run == n
+                        && isErasable(cell, model);
+
+    for (std::size_t from_class{0}; from_class < class_count; from_class++)
+    {
+      const auto current = choices[i * class_count + from_class].cost;
+
+      if ( current == NO_PATH )
+        continue;
+
+      // On equal costs, skipping unchanged cells takes precedence
+      if ( skip_cost != NO_PATH )
+        relax ( i, from_class, current + skip_cost
+              , i + unchanged, from_class, Operation::Move, uInt(unchanged) );
+
+      const auto attr_cost = current + getAttributeCost(from_class, to_class, model);
+      relax (i, from_class, attr_cost + char_cost, i + 1, to_class, Operation::Print, 1);
+
+      if ( repeat_cost > 0 )
+        relax ( i, from_class, attr_cost + repeat_cost
+              , i + run, to_class, Operation::Repeat, uInt(run) );
+
+      if ( erase_cost > 0 )
+        relax ( i, from_class, attr_cost + erase_cost
+              , i + run, to_class, Operation::Erase, uInt(run) );
+
+      if ( clear_eol )
+        relax ( i, from_class, attr_cost + model.clear_to_eol
+              , n, to_class, Operation::ClearToEOL, uInt(n - i) );
+    }
+  }
+
+  // Find the cheapest final state
+  const auto* end_choices = &choices[n * class_count];
+  const auto* best = std::min_element ( end_choices, end_choices + class_count
+                                      , [] (const Choice& lhs, const Choice& rhs)
+                                        {
+                                          return lhs.cost < rhs.cost;
+                                        } );
+  cost = best->cost;
+
+  // Follow the choices back to column 0
+  std::vector<std::pair<uInt, const Choice*>> path{};
+  auto x = n;
+  const auto* choice = best;
+
+  while ( x > 0 )
+  {
+    path.emplace_back(choice->prev_x, choice);
+    x = choice->prev_x;
+    choice = &choices[x * class_count + choice->prev_class];
+  }
+
+  std::for_each ( path.rbegin(), path.rend()
+                , [this, n] (const std::pair<uInt, const Choice*>& entry)
+                  {
+                    const auto step_x = entry.first;
+                    const auto& step = *entry.second;
+                    const auto end_x = step_x + step.count;
+
+                    if ( step.op == Operation::Move )
+                    {
+                      if ( end_x < n )
+                        addStep (Operation::Move, end_x, 0);
+
+                      return;
+                    }
+
+                    addStep (step.op, step_x, step.count);
+
+                    if ( step.op == Operation::Erase && end_x < n )
+                      addStep (Operation::Move, end_x, 0);
+                  } );
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FLineEncoder::encodeGreedy ( const FChar* first, const FChar* last
+                                , const FChar& term_attribute
+                                , const CostModel& model )
+{
+  // Reproduces the local decisions of FTermOutput::printRange()
+
+  plan.clear();
+  const auto n = uInt(last - first);
+  uInt x{0};
+
+  while ( x < n )
+  {
+    const auto& cell = first[x];
+
+    if ( cell.isBitSet(FAttribute::set::no_changes) )
+    {
+      const auto count = uInt(FRowScanner::countUnchanged(first + x, last));
+
+      if ( count > model.cursor_address_length )
+      {
+        x += count;
+        addStep (Operation::Move, x, 0);
+        continue;
+      }
+    }
+
+    const auto run = uInt(FRowScanner::countEqual(first + x, last, cell));
+
+    if ( model.erase_characters && cell.ch.unicode_data[0] == L' ' )
+    {
+      if ( run > 1 && isErasable(cell, model)
+        && run > model.erase_char_length + model.cursor_address_length )
+      {
+        addStep (Operation::Erase, x, run);
+        addStep (Operation::Move, x + run, 0);
+      }
+      else
+      {
+        for (uInt i{0}; i < run; i++)
+          addStep (Operation::Print, x + i);
+      }
+
+      x += run;
+    }
+    else if ( model.repeat_character )
+    {
+      if ( run > 1 && run > model.repeat_char_length
+        && model.repeat_character(cell, run) > 0 )
+      {
+        addStep (Operation::Repeat, x, run);
+      }
+      else
+      {
+        for (uInt i{0}; i < run; i++)
+          addStep (Operation::Print, x + i);
+      }
+
+      x += run;
+    }
+    else
+    {
+      addStep (Operation::Print, x);
+      x++;
+    }
+  }
+
+  cost = getPlanCost(plan, first, term_attribute, model);
+}
+
+//----------------------------------------------------------------------
+auto FLineEncoder::getPlanCost ( const Plan& steps, const FChar* first
+                               , const FChar& term_attribute
+                               , const CostModel& model ) -> uInt
+{
+  // Returns the number of bytes that the plan writes
+
+  const FChar* current = &term_attribute;
+  uInt cursor_x{0};
+  uInt total{0};
+
+  for (const auto& step : steps)
+  {
+    if ( step.op == Operation::Move )
+    {
+      if ( step.x != cursor_x )
+        total += internal::getLineMoveCost(cursor_x, step.x, model);
+
+      cursor_x = step.x;
+      continue;
+    }
+
+    const auto& cell = first[step.x];
+
+    total += internal::getLineStyleCost(*current, cell, model);
+    current = &cell;
+
+    if ( step.op == Operation::Print )
+    {
+      total += model.character ? model.character(cell) : 1;
+      cursor_x = step.x + 1;
+    }
+    else if ( step.op == Operation::Repeat )
+    {
+      total += model.repeat_character(cell, step.count);
+      cursor_x = step.x + step.count;
+    }
+    else if ( step.op == Operation::Erase )
+    {
+      total += model.erase_characters(step.count);
+      cursor_x = step.x;
+    }
+    else if ( step.op == Operation::ClearToEOL )
+    {
+      total += model.clear_to_eol;
+      cursor_x = step.x;
+    }
+  }
+
+  return total;
+}
+
+
+// private methods of FLineEncoder
+//----------------------------------------------------------------------
+auto FLineEncoder::assignAttributeClasses ( const FChar* first, std::size_t n
+                                          , const FChar& term_attribute ) -> bool
+{
+  // Cells with the same colors and attributes share one class.
+  // Class 0 is the current attribute state of the terminal.
+
+  class_cells.clear();
+  class_cells.push_back(&term_attribute);
+  cell_class.resize(n);
+
+  for (std::size_t i{0}; i < n; i++)
+  {
+    const auto& cell = first[i];
+    auto iter = std::find_if ( class_cells.cbegin(), class_cells.cend()
+                             , [&cell] (const FChar* class_cell)
+                               {
+                                 return internal::hasSameLineStyle(*class_cell, cell);
+                               } );
+
+    if ( iter == class_cells.cend() )
+    {
+      if ( class_cells.size() == MAX_ATTRIBUTE_CLASSES )
+        return false;
+
+      class_cells.push_back(&cell);
+      iter = std::prev(class_cells.cend());
+    }
+
+    cell_class[i] = std::size_t(iter - class_cells.cbegin());
+  }
+
+  class_count = class_cells.size();
+  attribute_costs.assign(class_count * class_count, NO_PATH);
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline auto FLineEncoder::getAttributeCost ( std::size_t from, std::size_t to
+                                           , const CostModel& model ) -> uInt
+{
+  if ( from == to )
+    return 0;
+
+  auto& attribute_cost = attribute_costs[from * class_count + to];
+
+  if ( attribute_cost == NO_PATH )
+    attribute_cost = internal::getLineStyleCost(*class_cells[from], *class_cells[to], model);
+
+  return attribute_cost;
+}
+
+//----------------------------------------------------------------------
+inline void FLineEncoder::relax ( std::size_t from_x, std::size_t from_class
+                                , uInt new_cost
+                                , std::size_t to_x, std::size_t to_class
+                                , Operation op, uInt count )
+{
+  auto& choice = choices[to_x * class_count + to_class];
+
+  if ( new_cost >= choice.cost )
+    return;
+
+  choice.cost = new_cost;
+  choice.prev_x = uInt(from_x);
+  choice.prev_class = uInt(from_class);
+  choice.op = op;
+  choice.count = count;
+
+  if ( op != Operation::Print )
+    anchors[to_x] = true;
+}
+
+//----------------------------------------------------------------------
+inline auto FLineEncoder::isAnchor (const FChar* first, std::size_t x) const -> bool
+{
+  // Anchors are the first column, the beginning of a run of equal or
+  // unchanged cells and each column behind a multi-cell operation
+
+  if ( x == 0 || anchors[x] )
+    return true;
+
+  const auto& cell = first[x];
+  const auto& prev = first[x - 1];
+  constexpr auto unchanged = FAttribute::set::no_changes;
+  return ! (cell == prev)
+      || cell.isBitSet(unchanged) != prev.isBitSet(unchanged);
+}
+
+//----------------------------------------------------------------------
+inline void FLineEncoder::addStep (Operation op, uInt x, uInt count)
+{
+  plan.push_back({op, x, count});
+}
+
+//----------------------------------------------------------------------
+inline auto FLineEncoder::isErasable ( const FChar& cell
+                                     , const CostModel& model ) noexcept -> bool
+{
+  // Erased cells get the background color only with "bce"
+
+  return cell.ch.unicode_data[0] == L' '
+      && (model.background_color_erase || FOptiAttr::isNormal(cell));
+}
+
+}  // namespace finalcut
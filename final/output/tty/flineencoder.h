@@ -0,0 +1,155 @@
+/***********************************************************************
+* flineencoder.h - Minimum-cost encoding of a terminal line span       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FLineEncoder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FLINEENCODER_H
+#define FLINEENCODER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FLineEncoder
+//----------------------------------------------------------------------
+
+class FLineEncoder final
+{
+  public:
+    // Enumeration
+    enum class Operation : uInt8
+    {
+      Print,       // Prints one character
+      Repeat,      // Repeats one character n-fold
+      Erase,       // Erases n characters (the cursor stays)
+      ClearToEOL,  // Clears to the end of line (the cursor stays)
+      Move         // Moves the cursor to column x
+    };
+
+    struct Step
+    {
+      Operation op;
+      uInt      x;         // Column relative to the span start
+      uInt      count{1};  // Number of cells
+    };
+
+    // All costs in bytes. A repeat, erase or cursor move cost of 0
+    // marks the operation as not available.
+    struct CostModel
+    {
+      std::function<uInt(const FChar&, const FChar&)> attribute_change{};
+      std::function<uInt(const FChar&)>               character{};
+      std::function<uInt(uInt, uInt)>                 cursor_move{};
+      std::function<uInt(const FChar&, uInt)>         repeat_character{};
+      std::function<uInt(uInt)>                       erase_characters{};
+      uInt  clear_to_eol{0};
+      bool  background_color_erase{false};
+      bool  reaches_eol{false};  // The span ends at the right margin
+
+      // Thresholds of the greedy encoder
+      uInt  cursor_address_length{0};
+      uInt  erase_char_length{0};
+      uInt  repeat_char_length{0};
+    };
+
+    // Using-declaration
+    using Plan = std::vector<Step>;
+
+    // Constant
+    static constexpr std::size_t MAX_ATTRIBUTE_CLASSES = 16;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getPlan() const noexcept -> const Plan&;
+    auto getCost() const noexcept -> uInt;
+
+    // Methods
+    auto encode (const FChar*, const FChar*, const FChar&, const CostModel&) -> bool;
+    void encodeGreedy (const FChar*, const FChar*, const FChar&, const CostModel&);
+    static auto getPlanCost ( const Plan&, const FChar*, const FChar&
+                            , const CostModel& ) -> uInt;
+
+  private:
+    struct Choice
+    {
+      uInt      cost{NO_PATH};
+      uInt      prev_x{0};
+      uInt      prev_class{0};
+      Operation op{Operation::Print};
+      uInt      count{0};
+    };
+
+    // Constant
+    static constexpr uInt NO_PATH = uInt(-1);
+
+    // Methods
+    auto assignAttributeClasses (const FChar*, std::size_t, const FChar&) -> bool;
+    auto getAttributeCost (std::size_t, std::size_t, const CostModel&) -> uInt;
+    void relax (std::size_t, std::size_t, uInt, std::size_t, std::size_t, Operation, uInt);
+    auto isAnchor (const FChar*, std::size_t) const -> bool;
+    void addStep (Operation, uInt, uInt = 1);
+    static auto isErasable (const FChar&, const CostModel&) noexcept -> bool;
+
+    // Data members
+    Plan                      plan{};
+    uInt                      cost{0};
+    std::vector<const FChar*> class_cells{};  // Representative cells
+    std::vector<std::size_t>  cell_class{};
+    std::vector<uInt>         attribute_costs{};
+    std::vector<Choice>       choices{};
+    std::vector<bool>         anchors{};
+    std::size_t               class_count{0};
+};
+
+// FLineEncoder inline functions
+//----------------------------------------------------------------------
+inline auto FLineEncoder::getClassName() const -> FString
+{ return "FLineEncoder"; }
+
+//----------------------------------------------------------------------
+inline auto FLineEncoder::getPlan() const noexcept -> const Plan&
+{ return plan; }
+
+//----------------------------------------------------------------------
+inline auto FLineEncoder::getCost() const noexcept -> uInt
+{ return cost; }
+
+}  // namespace finalcut
+
+#endif  // FLINEENCODER_H
@@ -113,6 +113,10 @@ auto has_background_changes (const FChar&, FColor, bool) noexcept -> bool;
 // class FOptiAttr
 //----------------------------------------------------------------------
 
+// static class attribute
+constexpr std::size_t FOptiAttr::TRANSITION_CACHE_SIZE;
+
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FOptiAttr::FOptiAttr()
@@ -411,6 +415,7 @@ void FOptiAttr::initialize()
   init_reset_attribute (F_dbl_underline.off);
   init_reset_attribute (F_standout.off, all_tests & ~same_like_se);
   alt_equal_pc_charset = hasCharsetEquivalence();
+  clearTransitionCache();
 }
 
 //----------------------------------------------------------------------
@@ -457,42 +462,63 @@ auto FOptiAttr::vga2ansi (FColor color) noexcept -> FColor
 //----------------------------------------------------------------------
 auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> FTermcap::TermcapString
 {
-  const bool next_has_color = hasColor(next);
-  fake_reverse = false;
-  attr_buf.clear();
-  prevent_no_color_video_attributes (term, next_has_color);
-  prevent_no_color_video_attributes (next);
-  detectSwitchOn (term, next);
-  detectSwitchOff (term, next);
-
-  // Simulate invisible characters
-  if ( ! F_secure.on.cap.data && next.isBitSet(FAttribute::set::invisible) )
-    next.encoded_char.unicode_data[0] = ' ';
+  // Screen updates repeat the same few attribute transitions over and
+  // over again. Therefore, the escape sequence and the resulting cell
+  // states of a transition are only calculated once and then taken
+  // from a direct-mapped cache.
 
-  // Look for no changes
-  if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
-    return {nullptr, 0};
+  const auto& mask = internal::var::attribute_mask;
+  const auto key = getTransitionKey(term, next);
+  auto& entry = transition_cache[getTransitionIndex(key)];
 
-  if ( hasNoAttribute(next) )
-  {
-    deactivateAttributes (term, next);
-  }
-  else if ( F_attributes.on.cap.data
-         && (! term.isBitSet(FAttribute::set::pc_charset) || alt_equal_pc_charset) )
+  if ( entry.valid && isSameTransition(entry.key, key) )
   {
-    changeAttributeSGR (term, next);
+    transition_cache_hits++;
   }
   else
   {
-    changeAttributeSeparately (term, next);
+    transition_cache_misses++;
+    createTransition (key, term, next, entry);
   }
 
-  static const auto& start_options = FStartOptions::getInstance();
+  term.attr.data = (term.attr.data & entry.term_attr_keep) | entry.term_attr;
+  term.color.data = entry.term_color;
+  next.attr.data = (next.attr.data & ~mask) | entry.next_attr;
+  next.color.data = entry.next_color;
 
-  if ( start_options.sgr_optimizer )
-    sgr_optimizer.optimize();
+  if ( entry.hide_char )
+    next.encoded_char.unicode_data[0] = ' ';
+
+  if ( ! entry.has_changes )
+    return {nullptr, 0};
 
-  return {attr_buf.data(), uInt32(attr_buf.length())};
+  return {entry.sequence.data(), uInt32(entry.sequence.length())};
+}
+
+//----------------------------------------------------------------------
+auto FOptiAttr::getAttributeChangeLength ( const FChar& term
+                                         , const FChar& next ) -> std::size_t
+{
+  // Returns the length of the attribute change in bytes without
+  // changing the cells or the transition cache statistics
+
+  const auto key = getTransitionKey(term, next);
+  auto& entry = transition_cache[getTransitionIndex(key)];
+
+  if ( ! entry.valid || ! isSameTransition(entry.key, key) )
+    createTransition (key, term, next, entry);
+
+  return entry.has_changes ? entry.sequence.length() : 0;
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::clearTransitionCache() noexcept
+{
+  for (auto& entry : transition_cache)
+    entry.valid = false;
+
+  transition_cache_hits = 0;
+  transition_cache_misses = 0;
 }
 
 
@@ -500,19 +526,20 @@ auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> FTermcap::TermcapS
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode ( Capability& capability
                                 , const FTermcap::TermcapString& cap
-                                , bool caused_reset ) const noexcept
+                                , bool caused_reset ) noexcept
 {
   if ( cap.data )
   {
     capability.cap = cap;
     capability.caused_reset = caused_reset;
+    clearTransitionCache();
   }
 }
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_on ( TextStyle& style
                                    , const FTermcap::TermcapString& cap
-                                   , bool caused_reset ) const noexcept
+                                   , bool caused_reset ) noexcept
 {
   set_mode (style.on, cap, caused_reset);
 }
@@ -520,11 +547,113 @@ inline void FOptiAttr::set_mode_on ( TextStyle& style
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_off ( TextStyle& style
                                     , const FTermcap::TermcapString& cap
-                                    , bool caused_reset ) const noexcept
+                                    , bool caused_reset ) noexcept
 {
   set_mode (style.off, cap, caused_reset);
 }
 
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionKey ( const FChar& term
+                                        , const FChar& next ) -> TransitionKey
+{
+  static const auto& start_options = FStartOptions::getInstance();
+  const auto& mask = internal::var::attribute_mask;
+  return
+  {
+    term.attr.data & mask,
+    term.color.data,
+    next.attr.data & mask,
+    next.color.data,
+    bool(start_options.sgr_optimizer)
+  };
+}
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionIndex (const TransitionKey& key) noexcept -> std::size_t
+{
+  uInt32 hash = key.term_attr;
+  hash = (hash * 0x9e3779b1U) ^ key.term_color;
+  hash = (hash * 0x9e3779b1U) ^ key.next_attr;
+  hash = (hash * 0x9e3779b1U) ^ key.next_color;
+  hash ^= hash >> 16;
+  return std::size_t(hash) & (TRANSITION_CACHE_SIZE - 1);
+}
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::isSameTransition ( const TransitionKey& lhs
+                                        , const TransitionKey& rhs ) noexcept -> bool
+{
+  return lhs.term_attr == rhs.term_attr
+      && lhs.term_color == rhs.term_color
+      && lhs.next_attr == rhs.next_attr
+      && lhs.next_color == rhs.next_color
+      && lhs.sgr_optimized == rhs.sgr_optimized;
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::createTransition ( const TransitionKey& key
+                                 , const FChar& term
+                                 , const FChar& next
+                                 , TransitionEntry& entry )
+{
+  // The transition is calculated on copies of both cells. All bits
+  // outside the attribute mask are set in the term copy, so that
+  // the bits that survive a reset can be read off afterwards.
+
+  const auto& mask = internal::var::attribute_mask;
+  FChar term_copy{term};
+  FChar next_copy{next};
+  term_copy.attr.data |= ~mask;
+  entry.has_changes = calculateAttributeChange (term_copy, next_copy);
+  entry.key = key;
+  entry.sequence.assign(attr_buf);
+  entry.term_attr_keep = term_copy.attr.data & ~mask;
+  entry.term_attr = term_copy.attr.data & mask;
+  entry.term_color = term_copy.color.data;
+  entry.next_attr = next_copy.attr.data & mask;
+  entry.next_color = next_copy.color.data;
+  entry.hide_char = ! F_secure.on.cap.data
+                 && next_copy.isBitSet(FAttribute::set::invisible);
+  entry.valid = true;
+}
+
+//----------------------------------------------------------------------
+auto FOptiAttr::calculateAttributeChange (FChar& term, FChar& next) -> bool
+{
+  const bool next_has_color = hasColor(next);
+  fake_reverse = false;
+  attr_buf.clear();
+  prevent_no_color_video_attributes (term, next_has_color);
+  prevent_no_color_video_attributes (next);
+  detectSwitchOn (term, next);
+  detectSwitchOff (term, next);
+
+  // Look for no changes
+  if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
+    return false;
+
+  if ( hasNoAttribute(next) )
+  {
+    deactivateAttributes (term, next);
+  }
+  else if ( F_attributes.on.cap.data
+         && (! term.isBitSet(FAttribute::set::pc_charset) || alt_equal_pc_charset) )
+  {
+    changeAttributeSGR (term, next);
+  }
+  else
+  {
+    changeAttributeSeparately (term, next);
+  }
+
+  static const auto& start_options = FStartOptions::getInstance();
+
+  if ( start_options.sgr_optimizer )
+    sgr_optimizer.optimize();
+
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline auto FOptiAttr::setTermBold (FChar& term) noexcept -> bool
 {
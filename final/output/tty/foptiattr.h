@@ -101,6 +101,8 @@ class FOptiAttr final
     // Accessors
     auto        getClassName() const -> FString;
     static auto getInstance() -> FOptiAttr&;
+    auto        getTransitionCacheHits() const noexcept -> std::size_t;
+    auto        getTransitionCacheMisses() const noexcept -> std::size_t;
 
     // Mutators
     void        setTermEnvironment (const TermEnv&);
@@ -151,6 +153,8 @@ class FOptiAttr final
     void        initialize();
     static auto vga2ansi (FColor) noexcept -> FColor;
     auto        changeAttribute (FChar&, FChar&) -> FTermcap::TermcapString;
+    auto        getAttributeChangeLength (const FChar&, const FChar&) -> std::size_t;
+    void        clearTransitionCache() noexcept;
 
   private:
     struct Capability
@@ -186,6 +190,32 @@ class FOptiAttr final
       FChar off{};
     };
 
+    struct TransitionKey
+    {
+      uInt32 term_attr{0};   // Masked attribute bits
+      uInt32 term_color{0};
+      uInt32 next_attr{0};   // Masked attribute bits
+      uInt32 next_color{0};
+      bool   sgr_optimized{false};
+    };
+
+    struct TransitionEntry
+    {
+      TransitionKey key{};
+      std::string   sequence{};
+      uInt32        term_attr_keep{0};  // Unmasked term bits that survive
+      uInt32        term_attr{0};
+      uInt32        term_color{0};
+      uInt32        next_attr{0};
+      uInt32        next_color{0};
+      bool          has_changes{false};
+      bool          hide_char{false};   // Simulated invisible character
+      bool          valid{false};
+    };
+
+    // Constant
+    static constexpr std::size_t TRANSITION_CACHE_SIZE = 256;  // Power of 2
+
     // Using-declarations
     using SetFunctionCall = std::function<bool(FOptiAttr*, FChar&)>;
 
@@ -198,6 +228,7 @@ class FOptiAttr final
     using AttributeHandlers = std::array<AttributeHandlerEntry, 13>;
     using NoColorVideoHandler = std::function<void(FOptiAttr*, FChar&)>;
     using NoColorVideoHandlerTable = std::array<NoColorVideoHandler, 18>;
+    using TransitionCache = std::array<TransitionEntry, TRANSITION_CACHE_SIZE>;
 
     // Enumerations
     enum init_reset_tests : uInt8
@@ -212,9 +243,9 @@ class FOptiAttr final
     };
 
     // Mutators
-    void        set_mode (Capability&, const FTermcap::TermcapString&, bool) const noexcept;
-    void        set_mode_on (TextStyle&, const FTermcap::TermcapString&, bool) const noexcept;
-    void        set_mode_off (TextStyle&, const FTermcap::TermcapString&, bool) const noexcept;
+    void        set_mode (Capability&, const FTermcap::TermcapString&, bool) noexcept;
+    void        set_mode_on (TextStyle&, const FTermcap::TermcapString&, bool) noexcept;
+    void        set_mode_off (TextStyle&, const FTermcap::TermcapString&, bool) noexcept;
     auto        setTermBold (FChar&) noexcept -> bool;
     auto        unsetTermBold (FChar&) noexcept -> bool;
     auto        setTermDim (FChar&) noexcept -> bool;
@@ -260,6 +291,11 @@ class FOptiAttr final
     auto        hasColorChanged (const FChar&, const FChar&) const noexcept -> bool;
 
     // Methods
+    static auto getTransitionKey (const FChar&, const FChar&) -> TransitionKey;
+    static auto getTransitionIndex (const TransitionKey&) noexcept -> std::size_t;
+    static auto isSameTransition (const TransitionKey&, const TransitionKey&) noexcept -> bool;
+    void        createTransition (const TransitionKey&, const FChar&, const FChar&, TransitionEntry&);
+    auto        calculateAttributeChange (FChar&, FChar&) -> bool;
     void        resetColor (FChar&) const noexcept ;
     void        prevent_no_color_video_attributes (FChar&, bool = false);
     void        deactivateAttributes (FChar&, FChar&);
@@ -316,6 +352,9 @@ class FOptiAttr final
     SGRoptimizer     sgr_optimizer{attr_buf};
     bool             alt_equal_pc_charset{false};
     bool             fake_reverse{false};
+    TransitionCache  transition_cache{};
+    std::size_t      transition_cache_hits{0};
+    std::size_t      transition_cache_misses{0};
 };
 
 
@@ -324,21 +363,41 @@ class FOptiAttr final
 inline auto FOptiAttr::getClassName() const -> FString
 { return "FOptiAttr"; }
 
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionCacheHits() const noexcept -> std::size_t
+{ return transition_cache_hits; }
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionCacheMisses() const noexcept -> std::size_t
+{ return transition_cache_misses; }
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::setMaxColor (int c) noexcept
-{ F_color.max_color = c; }
+{
+  F_color.max_color = c;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setNoColorVideo (int attr) noexcept
-{ F_color.attr_without_color = attr; }
+{
+  F_color.attr_without_color = attr;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = true; }
+{
+  F_color.ansi_default_color = true;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::unsetDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = false; }
+{
+  F_color.ansi_default_color = false;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 template <typename CharT
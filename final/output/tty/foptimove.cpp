@@ -487,6 +487,94 @@ void FOptiMove::set_clr_eol (const FTermcap::TermcapString& cap)
   }
 }
 
+//----------------------------------------------------------------------
+void FOptiMove::set_scroll_forward (const FTermcap::TermcapString& cap)
+{
+  if ( cap.data )
+  {
+    scroll.forward.cap = cap;
+    scroll.forward.duration = capDuration (cap, 1);
+    scroll.forward.length = capDurationToLength (scroll.forward.duration);
+  }
+  else
+  {
+    scroll.forward.cap = {nullptr, 0};
+    scroll.forward.duration = \
+    scroll.forward.length   = LONG_DURATION;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::set_scroll_reverse (const FTermcap::TermcapString& cap)
+{
+  if ( cap.data )
+  {
+    scroll.reverse.cap = cap;
+    scroll.reverse.duration = capDuration (cap, 1);
+    scroll.reverse.length = capDurationToLength (scroll.reverse.duration);
+  }
+  else
+  {
+    scroll.reverse.cap = {nullptr, 0};
+    scroll.reverse.duration = \
+    scroll.reverse.length   = LONG_DURATION;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::set_parm_index (const FTermcap::TermcapString& cap)
+{
+  if ( cap.data && FTermcap::isInitialized() )
+  {
+    const auto temp = FTermcap::encodeParameter(cap, 23);
+    scroll.parm_forward.cap = cap;
+    scroll.parm_forward.duration = capDuration (temp, 1);
+    scroll.parm_forward.length = capDurationToLength (scroll.parm_forward.duration);
+  }
+  else
+  {
+    scroll.parm_forward.cap = {nullptr, 0};
+    scroll.parm_forward.duration = \
+    scroll.parm_forward.length   = LONG_DURATION;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::set_parm_rindex (const FTermcap::TermcapString& cap)
+{
+  if ( cap.data && FTermcap::isInitialized() )
+  {
+    const auto temp = FTermcap::encodeParameter(cap, 23);
+    scroll.parm_reverse.cap = cap;
+    scroll.parm_reverse.duration = capDuration (temp, 1);
+    scroll.parm_reverse.length = capDurationToLength (scroll.parm_reverse.duration);
+  }
+  else
+  {
+    scroll.parm_reverse.cap = {nullptr, 0};
+    scroll.parm_reverse.duration = \
+    scroll.parm_reverse.length   = LONG_DURATION;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::set_change_scroll_region (const FTermcap::TermcapString& cap)
+{
+  if ( cap.data && FTermcap::isInitialized() )
+  {
+    const auto temp = FTermcap::encodeParameter(cap, 0, 23);
+    scroll.change_region.cap = cap;
+    scroll.change_region.duration = capDuration (temp, 1);
+    scroll.change_region.length = capDurationToLength (scroll.change_region.duration);
+  }
+  else
+  {
+    scroll.change_region.cap = {nullptr, 0};
+    scroll.change_region.duration = \
+    scroll.change_region.length   = LONG_DURATION;
+  }
+}
+
 //----------------------------------------------------------------------
 void FOptiMove::check_boundaries ( int& xold, int& yold
                                  , int& xnew, int& ynew ) const noexcept
@@ -551,6 +639,34 @@ auto FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew) -> FTermcap:
   return {};
 }
 
+//----------------------------------------------------------------------
+auto FOptiMove::scrollRegion (int top, int bottom, int lines) -> FTermcap::TermcapString
+{
+  // Returns the string to scroll the lines from top to bottom by
+  // the given number of lines (lines > 0: up, lines < 0: down)
+
+  const auto height = int(screen.height);
+
+  if ( ! scroll.change_region.cap.data
+    || ! parm_cursor.address.cap.data
+    || top < 0 || bottom >= height || top >= bottom
+    || lines == 0 || std::abs(lines) > bottom - top )
+    return {};
+
+  if ( scrollLines(temp_result, lines) == LONG_DURATION )
+    return {};
+
+  // Set the scrolling region, place the cursor on the region margin,
+  // scroll and reset the scrolling region to the full screen.
+  // The cursor position is undefined after changing the scrolling region.
+  const auto margin = ( lines > 0 ) ? bottom : top;
+  scroll_buf = FTermcap::encodeParameter(scroll.change_region.cap, top, bottom).data;
+  scroll_buf.append(FTermcap::encodeMotionParameter(parm_cursor.address.cap, 0, margin).data);
+  scroll_buf.append(temp_result);
+  scroll_buf.append(FTermcap::encodeParameter(scroll.change_region.cap, 0, height - 1).data);
+  return {scroll_buf.data(), uInt32(scroll_buf.size())};
+}
+
 
 // private methods of FApplication
 //----------------------------------------------------------------------
@@ -899,6 +1015,34 @@ inline void FOptiMove::leftMove ( std::string& hmove, int& htime
     moveWithLeftCursor (hmove, htime, num, from_x, to_x);
 }
 
+//----------------------------------------------------------------------
+inline auto FOptiMove::scrollLines (std::string& lines_scroll, int lines) const -> int
+{
+  // Chooses the faster way between index and parameterized index
+
+  const auto& single = ( lines > 0 ) ? scroll.forward : scroll.reverse;
+  const auto& parm = ( lines > 0 ) ? scroll.parm_forward : scroll.parm_reverse;
+  const int num = std::abs(lines);
+  int stime{LONG_DURATION};
+  lines_scroll.clear();
+
+  if ( parm.cap.data )
+  {
+    lines_scroll = FTermcap::encodeParameter(parm.cap, num).data;
+    stime = parm.duration;
+  }
+
+  if ( single.cap.data && (num * single.duration < stime) )
+  {
+    if ( ! lines_scroll.empty() )
+      lines_scroll.clear();
+
+    stime = repeatedAppend (lines_scroll, single, num);
+  }
+
+  return stime;
+}
+
 //----------------------------------------------------------------------
 inline auto FOptiMove::isWideMove ( int xold, int yold
                                   , int xnew, int ynew ) const noexcept -> bool
@@ -1164,6 +1308,16 @@ void printDurations (const FOptiMove& om)
             << om.parm_cursor.left.duration << " ms" << std::flush;
   std::clog << "parm_right_cursor: "
             << om.parm_cursor.right.duration << " ms" << std::flush;
+  std::clog << "   scroll_forward: "
+            << om.scroll.forward.duration << " ms" << std::flush;
+  std::clog << "   scroll_reverse: "
+            << om.scroll.reverse.duration << " ms" << std::flush;
+  std::clog << "       parm_index: "
+            << om.scroll.parm_forward.duration << " ms" << std::flush;
+  std::clog << "      parm_rindex: "
+            << om.scroll.parm_reverse.duration << " ms" << std::flush;
+  std::clog << "    scroll_region: "
+            << om.scroll.change_region.duration << " ms" << std::flush;
 }
 
 }  // namespace finalcut
@@ -128,6 +128,11 @@ class FOptiMove final
     auto  getRepeatCharLength() const noexcept -> uInt;
     auto  getClrBolLength() const noexcept -> uInt;
     auto  getClrEolLength() const noexcept -> uInt;
+    auto  getScrollForwardLength() const noexcept -> uInt;
+    auto  getScrollReverseLength() const noexcept -> uInt;
+    auto  getParmIndexLength() const noexcept -> uInt;
+    auto  getParmRindexLength() const noexcept -> uInt;
+    auto  getChangeScrollRegionLength() const noexcept -> uInt;
 
     // Mutators
     void  setBaudRate (int);
@@ -155,12 +160,18 @@ class FOptiMove final
     void  set_repeat_last_char (const FTermcap::TermcapString&);
     void  set_clr_bol (const FTermcap::TermcapString&);
     void  set_clr_eol (const FTermcap::TermcapString&);
+    void  set_scroll_forward (const FTermcap::TermcapString&);
+    void  set_scroll_reverse (const FTermcap::TermcapString&);
+    void  set_parm_index (const FTermcap::TermcapString&);
+    void  set_parm_rindex (const FTermcap::TermcapString&);
+    void  set_change_scroll_region (const FTermcap::TermcapString&);
     void  set_auto_left_margin (bool = true) noexcept;
     void  set_eat_newline_glitch (bool = true) noexcept;
 
     // Methods
     void  check_boundaries (int&, int&, int&, int&) const noexcept;
     auto  moveCursor (int, int, int, int) -> FTermcap::TermcapString;
+    auto  scrollRegion (int, int, int) -> FTermcap::TermcapString;
 
   private:
     struct Capability
@@ -203,6 +214,15 @@ class FOptiMove final
       Capability  clr_eol{};
     };
 
+    struct Scroll
+    {
+      Capability  forward{};
+      Capability  reverse{};
+      Capability  parm_forward{};
+      Capability  parm_reverse{};
+      Capability  change_region{};
+    };
+
     struct Dimension
     {
       std::size_t width{};
@@ -228,6 +248,7 @@ class FOptiMove final
     void  downMove (std::string&, int&, int, int) const;
     void  upMove (std::string&, int&, int, int) const;
     auto  horizontalMove (std::string&, int, int) const -> int;
+    auto  scrollLines (std::string&, int) const -> int;
     void  moveWithParmRightCursor (std::string&, int&, int) const;
     void  moveWithRightCursor (std::string&, int&, int, int, int) const;
     void  rightMove (std::string&, int&, int, int) const;
@@ -252,12 +273,14 @@ class FOptiMove final
     Cursor      cursor{};
     ParamCursor parm_cursor{};
     Edit        edit{};
+    Scroll      scroll{};
     Dimension   screen{80, 24};
     int         char_duration{1};
     int         baudrate{9600};
     int         tabstop{0};
     std::string move_buf{};
     std::string temp_result{};
+    std::string scroll_buf{};
     bool        automatic_left_margin{false};
     bool        eat_nl_glitch{false};
 
@@ -351,6 +374,26 @@ inline auto FOptiMove::getClrBolLength() const noexcept -> uInt
 inline auto FOptiMove::getClrEolLength() const noexcept -> uInt
 { return static_cast<uInt>(edit.clr_eol.length); }
 
+//----------------------------------------------------------------------
+inline auto FOptiMove::getScrollForwardLength() const noexcept -> uInt
+{ return static_cast<uInt>(scroll.forward.length); }
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::getScrollReverseLength() const noexcept -> uInt
+{ return static_cast<uInt>(scroll.reverse.length); }
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::getParmIndexLength() const noexcept -> uInt
+{ return static_cast<uInt>(scroll.parm_forward.length); }
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::getParmRindexLength() const noexcept -> uInt
+{ return static_cast<uInt>(scroll.parm_reverse.length); }
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::getChangeScrollRegionLength() const noexcept -> uInt
+{ return static_cast<uInt>(scroll.change_region.length); }
+
 //----------------------------------------------------------------------
 inline void FOptiMove::set_auto_left_margin (bool bcap) noexcept
 { automatic_left_margin = bcap; }
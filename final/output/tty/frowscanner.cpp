@@ -0,0 +1,346 @@
+/***********************************************************************
+* frowscanner.cpp - Run scanner for character cell rows                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #define FROWSCANNER_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+#include "final/output/tty/frowscanner.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+// A cell pattern covers two consecutive cells, so that the AVX2
+// kernel can compare 96 bytes with three 256-bit operations
+constexpr std::size_t WORDS_PER_CELL = sizeof(FChar) / sizeof(uInt64);
+
+static_assert ( sizeof(FChar) == 6 * sizeof(uInt64)
+              , "The row scanner expects a 48-byte FChar" );
+
+struct CellPattern
+{
+  alignas(32) std::array<uInt64, 2 * WORDS_PER_CELL> value{};  // Masked value
+  alignas(32) std::array<uInt64, 2 * WORDS_PER_CELL> mask{};   // Relevant bits
+};
+
+using KernelFunc = std::size_t (*)(const FChar*, const FChar*, const CellPattern&);
+
+struct KernelSet
+{
+  FRowScanner::Kernel kernel;
+  KernelFunc          forward;
+  KernelFunc          reverse;
+};
+
+//----------------------------------------------------------------------
+auto makeCellPattern (const FChar& value_char, uInt32 attr_mask, bool with_char)
+    -> CellPattern
+{
+  // Creates a pattern that matches all cells whose relevant bits
+  // are identical to those of value_char
+
+  std::array<uInt8, sizeof(FChar)> mask_bytes{};
+
+  if ( with_char )
+  {
+    std::memset (&mask_bytes[offsetof(FChar, ch)], 0xff, sizeof(FUnicode));
+    std::memset (&mask_bytes[offsetof(FChar, color)], 0xff, sizeof(FCellColor));
+  }
+
+  std::memcpy (&mask_bytes[offsetof(FChar, attr)], &attr_mask, sizeof(attr_mask));
+  CellPattern pattern{};
+  std::memcpy (&pattern.mask[0], mask_bytes.data(), sizeof(FChar));
+  std::memcpy (&pattern.mask[WORDS_PER_CELL], mask_bytes.data(), sizeof(FChar));
+  std::memcpy (&pattern.value[0], &value_char, sizeof(FChar));
+  std::memcpy (&pattern.value[WORDS_PER_CELL], &value_char, sizeof(FChar));
+
+  for (std::size_t i{0}; i < pattern.value.size(); i++)
+    pattern.value[i] &= pattern.mask[i];
+
+  return pattern;
+}
+
+//----------------------------------------------------------------------
+auto getUnchangedPattern() -> const CellPattern&
+{
+  static const auto pattern = []
+  {
+    FChar value_char{};
+    value_char.attr.data = FAttribute::set::no_changes;
+    return makeCellPattern (value_char, FAttribute::set::no_changes, false);
+  }();
+
+  return pattern;
+}
+
+//----------------------------------------------------------------------
+inline auto isMatchScalar (const FChar* cell, const CellPattern& pattern) noexcept -> bool
+{
+  std::array<uInt64, WORDS_PER_CELL> word;
+  std::memcpy (word.data(), cell, sizeof(FChar));
+  const auto& v = pattern.value;
+  const auto& m = pattern.mask;
+  return ( ((word[0] & m[0]) ^ v[0]) | ((word[1] & m[1]) ^ v[1])
+         | ((word[2] & m[2]) ^ v[2]) | ((word[3] & m[3]) ^ v[3])
+         | ((word[4] & m[4]) ^ v[4]) | ((word[5] & m[5]) ^ v[5]) ) == 0;
+}
+
+//----------------------------------------------------------------------
+auto countForwardScalar ( const FChar* first, const FChar* last
+                        , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = first;
+
+  while ( cell < last && isMatchScalar(cell, pattern) )
+    ++cell;
+
+  return std::size_t(cell - first);
+}
+
+//----------------------------------------------------------------------
+auto countReverseScalar ( const FChar* first, const FChar* last
+                        , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = last;
+
+  while ( cell > first && isMatchScalar(cell - 1, pattern) )
+    --cell;
+
+  return std::size_t(last - cell);
+}
+
+#if defined(FROWSCANNER_X86_SIMD)
+//----------------------------------------------------------------------
+inline auto isMatchSSE2 (const FChar* cell, const CellPattern& pattern) noexcept -> bool
+{
+  const auto* bytes = reinterpret_cast<const __m128i*>(cell);
+  const auto* value = reinterpret_cast<const __m128i*>(pattern.value.data());
+  const auto* mask = reinterpret_cast<const __m128i*>(pattern.mask.data());
+  const auto diff0 = _mm_xor_si128 (_mm_and_si128(_mm_loadu_si128(bytes), _mm_load_si128(mask)), _mm_load_si128(value));
+  const auto diff1 = _mm_xor_si128 (_mm_and_si128(_mm_loadu_si128(bytes + 1), _mm_load_si128(mask + 1)), _mm_load_si128(value + 1));
+  const auto diff2 = _mm_xor_si128 (_mm_and_si128(_mm_loadu_si128(bytes + 2), _mm_load_si128(mask + 2)), _mm_load_si128(value + 2));
+  const auto diff = _mm_or_si128 (_mm_or_si128(diff0, diff1), diff2);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xffff;
+}
+
+//----------------------------------------------------------------------
+auto countForwardSSE2 ( const FChar* first, const FChar* last
+                      , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = first;
+
+  while ( cell < last && isMatchSSE2(cell, pattern) )
+    ++cell;
+
+  return std::size_t(cell - first);
+}
+
+//----------------------------------------------------------------------
+auto countReverseSSE2 ( const FChar* first, const FChar* last
+                      , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = last;
+
+  while ( cell > first && isMatchSSE2(cell - 1, pattern) )
+    --cell;
+
+  return std::size_t(last - cell);
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline auto matchPairAVX2 (const FChar* cells, const CellPattern& pattern) noexcept -> uInt
+{
+  // Returns bit 0 for a match of the first cell
+  // and bit 1 for a match of the second cell
+
+  const auto* bytes = reinterpret_cast<const __m256i*>(cells);
+  const auto* value = reinterpret_cast<const __m256i*>(pattern.value.data());
+  const auto* mask = reinterpret_cast<const __m256i*>(pattern.mask.data());
+  const auto zero = _mm256_setzero_si256();
+  const auto diff0 = _mm256_xor_si256 (_mm256_and_si256(_mm256_loadu_si256(bytes), _mm256_load_si256(mask)), _mm256_load_si256(value));
+  const auto diff1 = _mm256_xor_si256 (_mm256_and_si256(_mm256_loadu_si256(bytes + 1), _mm256_load_si256(mask + 1)), _mm256_load_si256(value + 1));
+  const auto diff2 = _mm256_xor_si256 (_mm256_and_si256(_mm256_loadu_si256(bytes + 2), _mm256_load_si256(mask + 2)), _mm256_load_si256(value + 2));
+  const auto eq0 = uInt32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(diff0, zero)));
+  const auto eq1 = uInt32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(diff1, zero)));
+  const auto eq2 = uInt32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(diff2, zero)));
+  const bool first_match = eq0 == 0xffffffffU && (eq1 & 0xffffU) == 0xffffU;
+  const bool second_match = (eq1 >> 16) == 0xffffU && eq2 == 0xffffffffU;
+  return uInt(first_match) | (uInt(second_match) << 1);
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto countForwardAVX2 ( const FChar* first, const FChar* last
+                      , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = first;
+
+  while ( last - cell >= 2 )
+  {
+    const auto match = matchPairAVX2(cell, pattern);
+
+    if ( match != 3 )
+      return std::size_t(cell - first) + (match & 1);
+
+    cell += 2;
+  }
+
+  if ( cell < last && isMatchSSE2(cell, pattern) )
+    ++cell;
+
+  return std::size_t(cell - first);
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto countReverseAVX2 ( const FChar* first, const FChar* last
+                      , const CellPattern& pattern ) -> std::size_t
+{
+  const auto* cell = last;
+
+  while ( cell - first >= 2 )
+  {
+    const auto match = matchPairAVX2(cell - 2, pattern);
+
+    if ( match != 3 )
+      return std::size_t(last - cell) + (match >> 1);
+
+    cell -= 2;
+  }
+
+  if ( cell > first && isMatchSSE2(cell - 1, pattern) )
+    --cell;
+
+  return std::size_t(last - cell);
+}
+#endif  // defined(FROWSCANNER_X86_SIMD)
+
+//----------------------------------------------------------------------
+auto isKernelSupported (FRowScanner::Kernel kernel) noexcept -> bool
+{
+  if ( kernel == FRowScanner::Kernel::Scalar )
+    return true;
+
+#if defined(FROWSCANNER_X86_SIMD)
+  if ( kernel == FRowScanner::Kernel::SSE2 )
+    return true;  // Part of the x86-64 base instruction set
+
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------
+auto makeKernelSet (FRowScanner::Kernel kernel) noexcept -> KernelSet
+{
+  // Selects the best supported kernel up to the requested one
+
+  while ( ! isKernelSupported(kernel) )
+    kernel = FRowScanner::Kernel(uInt8(kernel) - 1);
+
+#if defined(FROWSCANNER_X86_SIMD)
+  if ( kernel == FRowScanner::Kernel::AVX2 )
+    return { kernel, &countForwardAVX2, &countReverseAVX2 };
+
+  if ( kernel == FRowScanner::Kernel::SSE2 )
+    return { kernel, &countForwardSSE2, &countReverseSSE2 };
+#endif
+
+  return { kernel, &countForwardScalar, &countReverseScalar };
+}
+
+//----------------------------------------------------------------------
+auto getKernelSet() noexcept -> KernelSet&
+{
+  static auto kernel_set = makeKernelSet(FRowScanner::Kernel::AVX2);
+  return kernel_set;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FRowScanner
+//----------------------------------------------------------------------
+
+// public methods of FRowScanner
+//----------------------------------------------------------------------
+auto FRowScanner::getKernel() noexcept -> Kernel
+{
+  return internal::getKernelSet().kernel;
+}
+
+//----------------------------------------------------------------------
+void FRowScanner::setKernel (Kernel kernel) noexcept
+{
+  internal::getKernelSet() = internal::makeKernelSet(kernel);
+}
+
+//----------------------------------------------------------------------
+auto FRowScanner::countEqual ( const FChar* first, const FChar* last
+                             , const FChar& ref ) noexcept -> std::size_t
+{
+  // Number of cells from first that are equal to ref
+
+  if ( first >= last || *first != ref )  // Short runs are the common case
+    return 0;
+
+  const auto pattern = internal::makeCellPattern(ref, getCompareBitMask(), true);
+  return 1 + internal::getKernelSet().forward(first + 1, last, pattern);
+}
+
+//----------------------------------------------------------------------
+auto FRowScanner::countEqualReverse ( const FChar* first, const FChar* last
+                                    , const FChar& ref ) noexcept -> std::size_t
+{
+  // Number of cells before last that are equal to ref
+
+  if ( first >= last || *(last - 1) != ref )
+    return 0;
+
+  const auto pattern = internal::makeCellPattern(ref, getCompareBitMask(), true);
+  return 1 + internal::getKernelSet().reverse(first, last - 1, pattern);
+}
+
+//----------------------------------------------------------------------
+auto FRowScanner::countUnchanged (const FChar* first, const FChar* last) noexcept -> std::size_t
+{
+  // Number of cells from first with the no_changes bit set
+
+  if ( first >= last )
+    return 0;
+
+  const auto& pattern = internal::getUnchangedPattern();
+  return internal::getKernelSet().forward(first, last, pattern);
+}
+
+}  // namespace finalcut
@@ -0,0 +1,76 @@
+/***********************************************************************
+* frowscanner.h - Run scanner for character cell rows                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FRowScanner ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FROWSCANNER_H
+#define FROWSCANNER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FRowScanner
+//----------------------------------------------------------------------
+
+class FRowScanner final
+{
+  public:
+    // Enumeration
+    enum class Kernel : uInt8
+    {
+      Scalar,  // Portable 64-bit word comparison
+      SSE2,    // One cell per step
+      AVX2     // Two cells per step
+    };
+
+    // Accessor
+    static auto getKernel() noexcept -> Kernel;
+
+    // Mutator
+    static void setKernel (Kernel) noexcept;
+
+    // Methods
+    static auto countEqual ( const FChar*, const FChar*
+                           , const FChar& ) noexcept -> std::size_t;
+    static auto countEqualReverse ( const FChar*, const FChar*
+                                  , const FChar& ) noexcept -> std::size_t;
+    static auto countUnchanged (const FChar*, const FChar*) noexcept -> std::size_t;
+};
+
+}  // namespace finalcut
+
+#endif  // FROWSCANNER_H
@@ -483,6 +483,16 @@ auto FTerm::moveCursor (int xold, int yold, int xnew, int ynew) -> FTermcap::Ter
   return cursor_addr;
 }
 
+//----------------------------------------------------------------------
+auto FTerm::scrollRegion (int top, int bottom, int lines) -> FTermcap::TermcapString
+{
+  // Returns the string to scroll a range of lines up (lines > 0)
+  // or down (lines < 0)
+
+  static auto& opti_move = FOptiMove::getInstance();
+  return opti_move.scrollRegion (top, bottom, lines);
+}
+
 //----------------------------------------------------------------------
 auto FTerm::cursorsVisibility (bool enable) -> FTermcap::TermcapString
 {
@@ -608,6 +618,7 @@ void FTerm::resetColorMap()
   if ( op.data )
     paddingPrint (op);
 
+  FOptiAttr::getInstance().clearTransitionCache();
   std::fflush(stdout);
 }
 
@@ -671,8 +682,11 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
   }
 #endif
 
-  if ( state )
-    std::fflush(stdout);
+  if ( ! state )
+    return;
+
+  FOptiAttr::getInstance().clearTransitionCache();
+  std::fflush(stdout);
 }
 
 //----------------------------------------------------------------------
@@ -774,16 +788,9 @@ auto FTerm::charEncode (const wchar_t& c) -> wchar_t
 //----------------------------------------------------------------------
 auto FTerm::charEncode (const wchar_t& c, const Encoding& enc) -> wchar_t
 {
-  const auto& character = FCharMap::getCharEncodeMap();
-  const auto& cend = character.cend();
-  const auto& found = \
-      std::find_if ( character.cbegin(), cend
-                   , [&c] (const auto& entry)
-                     {
-                       return entry.encoding.unicode == c;
-                     } );
+  const auto* found = FCharMap::findCharEncode(c);
 
-  if ( found == cend )
+  if ( ! found )
     return c;
 
   const auto& ch_enc = FCharMap::getCharacter(*found, enc);
@@ -1223,6 +1230,11 @@ void FTerm::init_optiMove()
 
   static auto& opti_move = FOptiMove::getInstance();
   opti_move.setTermEnvironment(optimove_env);
+  opti_move.set_scroll_forward (TCAP(t_scroll_forward));
+  opti_move.set_scroll_reverse (TCAP(t_scroll_reverse));
+  opti_move.set_parm_index (TCAP(t_parm_index));
+  opti_move.set_parm_rindex (TCAP(t_parm_rindex));
+  opti_move.set_change_scroll_region (TCAP(t_change_scroll_region));
 }
 
 //----------------------------------------------------------------------
@@ -1764,6 +1776,25 @@ inline void FTerm::disableApplicationEscKey()
     paddingPrint (CSI "?7727l");
 }
 
+//----------------------------------------------------------------------
+inline void FTerm::enableKeyboardProtocol()
+{
+  // Push the kitty keyboard protocol flag "disambiguate escape codes",
+  // so that the Esc key no longer waits for the keypress timeout
+
+  if ( FTermDetection::getInstance().hasKeyboardProtocolSupport() )
+    paddingPrint (CSI ">1u");
+}
+
+//----------------------------------------------------------------------
+inline void FTerm::disableKeyboardProtocol()
+{
+  // Restore the previous keyboard protocol flags
+
+  if ( FTermDetection::getInstance().hasKeyboardProtocolSupport() )
+    paddingPrint (CSI "<u");
+}
+
 //----------------------------------------------------------------------
 void FTerm::useAlternateScreenBuffer()
 {
@@ -1856,17 +1887,23 @@ void FTerm::init()
   enableMouse();
 
   // Activate meta key sends escape + terminal focus event
+  // + bracketed paste
   if ( FTermData::getInstance().isTermType(FTermType::xterm) )
   {
     FTermXTerminal::getInstance().metaSendsESC(true);
 
     if ( getStartOptions().terminal_focus_events )
       FTermXTerminal::getInstance().setFocusSupport(true);
+
+    FTermXTerminal::getInstance().setBracketedPaste(true);
   }
 
   // switch to application escape key mode
   enableApplicationEscKey();
 
+  // Report unambiguous key codes
+  enableKeyboardProtocol();
+
   // Enter 'keyboard_transmit' mode
   enableKeypad();
 
@@ -2054,6 +2091,9 @@ void FTerm::finish() const
   // Switch to normal escape key mode
   disableApplicationEscKey();
 
+  // Switch back to the legacy key codes
+  disableKeyboardProtocol();
+
   finishOSspecifics();
 
   if ( data.isTermType(FTermType::kde_konsole) )
@@ -2065,9 +2105,12 @@ void FTerm::finish() const
   if ( getStartOptions().mouse_support )
     disableMouse();
 
-  // Deactivate terminal focus event + meta key sends escape
+  // Deactivate bracketed paste + terminal focus event
+  // + meta key sends escape
   if ( data.isTermType(FTermType::xterm) )
   {
+    xterm.setBracketedPaste(false);
+
     if ( getStartOptions().terminal_focus_events )
       xterm.setFocusSupport(false);
 
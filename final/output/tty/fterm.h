@@ -209,6 +209,7 @@ class FTerm final
     static auto openConsole() -> int;
     static auto closeConsole() -> int;
     static auto moveCursor (int, int, int, int) -> FTermcap::TermcapString;
+    static auto scrollRegion (int, int, int) -> FTermcap::TermcapString;
     static auto cursorsVisibility (bool = true) -> FTermcap::TermcapString;
     static void detectTermSize();
     static void setTermSize (const FSize&);
@@ -286,6 +287,8 @@ class FTerm final
     static void disableMouse();
     static void enableApplicationEscKey();
     static void disableApplicationEscKey();
+    static void enableKeyboardProtocol();
+    static void disableKeyboardProtocol();
     static void enableKeypad();
     static void disableKeypad();
     static void enableAlternateCharset();
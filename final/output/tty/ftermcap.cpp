@@ -45,12 +45,14 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 
 #include "final/fc.h"
 #include "final/input/fkey_map.h"
 #include "final/output/tty/ftermcap.h"
+#include "final/output/tty/ftermcapprogram.h"
 #include "final/output/tty/ftermdata.h"
 #include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/fterm.h"
@@ -81,6 +83,13 @@ static auto getMoveCache() noexcept -> std::unordered_map<std::uint32_t, std::st
   return *move_cache;
 }
 
+static auto getProgramCache() noexcept -> std::unordered_map<const char*, FTermcapProgram>&
+{
+  using program_cache_type = std::unordered_map<const char*, FTermcapProgram>;
+  static const auto& program_cache = std::make_unique<program_cache_type>();
+  return *program_cache;
+}
+
 }  // namespace internal
 
 // Function prototypes
@@ -200,6 +209,14 @@ auto FTermcap::getString (const std::string& cap) -> char*
 //----------------------------------------------------------------------
 auto FTermcap::encodeMotionParameter (const TermcapString& cap, int col, int row) -> TermcapString
 {
+  if ( const auto* program = getProgram(cap) )
+  {
+    // tgoto() passes the row as the first parameter
+    static std::string motion{};
+    program->format ({{row, col}}, motion);
+    return {motion.data(), uInt32(motion.size())};
+  }
+
   const std::uint32_t key = (std::uint32_t(col) << 16) | std::uint16_t(row);
 
   // Cache search
@@ -225,50 +242,35 @@ auto FTermcap::paddingPrint (const char* string, uInt32 len, int affcnt) -> Stat
   if ( ! string || len == 0 || ! outc )
     return Status::Error;
 
-  bool has_delay = hasDelay(string);
-  auto iter = string;
-  auto end = std::next(string, len);
-
-  while ( iter != end )
-  {
-    if ( *iter != '$' )
-    {
-      outc (int(*iter));
-      iter = std::next(iter);
-      continue;
-    }
-
-    iter = std::next(iter);
-
-    if ( iter == end || *iter != '<' )
-    {
-      outc (int('$'));
-
-      if ( iter != end )
-        outc (int(*iter));
-      else
-        break;
-
-      iter = std::next(iter);
-      continue;
-    }
-
-    const int number = readNumber(iter, affcnt, has_delay);
-
-    if ( number == -1 )
-    {
-      outc (int('$'));
-      outc (int('<'));
-      continue;
-    }
+  processPadding ( string, len, affcnt
+                 , [] (char ch) { outc (int(ch)); }
+                 , [] (int ms) { delayOutput(ms); } );
+  return Status::OK;
+}
 
-    if ( has_delay && number > 0 )
-      delayOutput(number / 10);
+//----------------------------------------------------------------------
+auto FTermcap::paddingEncode ( const char* string, uInt32 len
+                             , int affcnt, std::string& output ) -> Status
+{
+  // Resolves the padding of a termcap string in advance, so that it
+  // can be written together with other output. A delay can only be
+  // encoded as padding characters. Without a padding character, the
+  // string must be output with paddingPrint().
 
-    iter = std::next(iter);
-  }
+  if ( ! string || len == 0 )
+    return Status::Error;
 
-  return Status::OK;
+  bool encodable{true};
+  processPadding ( string, len, affcnt
+                 , [&output] (char ch) { output.push_back(ch); }
+                 , [&output, &encodable] (int ms)
+                   {
+                     if ( no_padding_char )
+                       encodable = false;
+                     else
+                       output.append(std::size_t(getPaddingCharCount(ms)), PC);
+                   } );
+  return encodable ? Status::OK : Status::Error;
 }
 
 //----------------------------------------------------------------------
@@ -286,6 +288,7 @@ void FTermcap::init()
   buffer = internal::getStringBuffer();
   buffer_addr = &buffer;
   termcap();
+  compilePrograms();
   setDefaultPutCharFunction();
   setDefaultPutStringFunction();
 }
@@ -531,12 +534,108 @@ void FTermcap::termcapKeys()
 auto FTermcap::encodeParams ( const TermcapString& cap
                             , const std::array<int, 9>& params ) -> TermcapString
 {
+  if ( const auto* program = getProgram(cap) )
+  {
+    static std::string output{};
+    program->format (params, output);
+    return {output.data(), uInt32(output.size())};
+  }
+
   const auto str = ::tparm ( C_STR(cap.data), params[0], params[1]
                            , params[2], params[3], params[4], params[5]
                            , params[6], params[7], params[8] );
   return {str, uInt32(finalcut::stringLength(str))};
 }
 
+//----------------------------------------------------------------------
+auto FTermcap::getProgram (const TermcapString& cap) -> const FTermcapProgram*
+{
+  // Returns the compiled form of a parameterized string or nullptr
+  // if it can only be evaluated with tparm()
+
+  if ( ! cap.data )
+    return nullptr;
+
+  // Like tparm(), the length of the string is not taken from cap.length
+  static auto& program_cache = internal::getProgramCache();
+  const auto length = finalcut::stringLength(cap.data);
+  auto& program = program_cache[cap.data];
+
+  if ( ! program.isSource(cap.data, length) )  // New or changed string
+    program.compile (cap.data, length);
+
+  return program.isCompiled() ? &program : nullptr;
+}
+
+//----------------------------------------------------------------------
+void FTermcap::compilePrograms()
+{
+  // Compiles all parameterized strings of the terminal in advance
+
+  static auto& program_cache = internal::getProgramCache();
+  program_cache.clear();
+
+  for (const auto& entry : strings)
+  {
+    const auto& cap = entry.string;
+
+    if ( cap.data && std::strchr(cap.data, '%') )
+      getProgram(cap);
+  }
+}
+
+//----------------------------------------------------------------------
+template <typename PutChar, typename Delay>
+void FTermcap::processPadding ( const char* string, uInt32 len, int affcnt
+                              , PutChar&& put_char, Delay&& delay )
+{
+  // Passes the characters of string to put_char and replaces
+  // the padding specifications "$<..>" with a call of delay
+
+  bool has_delay = hasDelay(string);
+  auto iter = string;
+  auto end = std::next(string, len);
+
+  while ( iter != end )
+  {
+    if ( *iter != '$' )
+    {
+      put_char (*iter);
+      iter = std::next(iter);
+      continue;
+    }
+
+    iter = std::next(iter);
+
+    if ( iter == end || *iter != '<' )
+    {
+      put_char ('$');
+
+      if ( iter != end )
+        put_char (*iter);
+      else
+        break;
+
+      iter = std::next(iter);
+      continue;
+    }
+
+    const int number = readNumber(iter, affcnt, has_delay);
+
+    if ( number == -1 )
+    {
+      put_char ('$');
+      put_char ('<');
+      continue;
+    }
+
+    if ( has_delay && number > 0 )
+      delay (number / 10);
+
+    iter = std::next(iter);
+  }
+}
+
 //----------------------------------------------------------------------
 inline auto FTermcap::hasDelay (const std::string& string) noexcept -> bool
 {
@@ -719,6 +818,9 @@ FTermcap::TCapMapType FTermcap::strings =
   { {nullptr, 0}, {"ac"} },  // acs_chars              -> graphics charset pairs (vt100)
   { {nullptr, 0}, {"ks"} },  // keypad_xmit            -> enter 'key-board_transmit' mode
   { {nullptr, 0}, {"ke"} },  // keypad_local           -> leave 'key-board_transmit' mode
+  { {nullptr, 0}, {"SF"} },  // parm_index             -> scroll forward #1 lines (PG)
+  { {nullptr, 0}, {"SR"} },  // parm_rindex            -> scroll back #1 lines (PG)
+  { {nullptr, 0}, {"cs"} },  // change_scroll_region   -> change region to line #1 to line #2 (P)
   { {nullptr, 0}, {"Km"} }   // key_mouse              -> Mouse event has occurred
 }};
 
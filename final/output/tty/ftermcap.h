@@ -52,6 +52,9 @@
 namespace finalcut
 {
 
+// class forward declaration
+class FTermcapProgram;
+
 //----------------------------------------------------------------------
 // class FTermcap
 //----------------------------------------------------------------------
@@ -82,7 +85,7 @@ class FTermcap final
     };
 
     // Using-declaration
-    using TCapMapType = std::array<TCapMap, 86>;
+    using TCapMapType = std::array<TCapMap, 89>;
     using PutCharFunc = std::decay_t<int(int)>;
     using PutStringFunc = std::decay_t<int(const char*, uInt32)>;
 
@@ -98,6 +101,7 @@ class FTermcap final
     template <typename... Args>
     static auto  encodeParameter (const TermcapString&, Args&&...) -> TermcapString;
     static auto  paddingPrint (const char*, uInt32, int) -> Status;
+    static auto  paddingEncode (const char*, uInt32, int, std::string&) -> Status;
     static auto  stringPrint (const char*, uInt32) -> Status;
 
     // Predicate
@@ -148,7 +152,12 @@ class FTermcap final
     static void  termcapKeys();
     static auto  encodeParams ( const TermcapString&
                               , const std::array<int, 9>& ) -> TermcapString;
+    static auto  getProgram (const TermcapString&) -> const FTermcapProgram*;
+    static void  compilePrograms();
+    template <typename PutChar, typename Delay>
+    static void  processPadding (const char*, uInt32, int, PutChar&&, Delay&&);
     static auto  hasDelay (const std::string&) noexcept -> bool;
+    static auto  getPaddingCharCount (int) noexcept -> int;
     static void  delayOutput (int) noexcept;
     static auto  readNumber (const char*&, int, bool&) noexcept -> int;
     static void  readDigits (const char*&, int&) noexcept;
@@ -202,6 +211,14 @@ inline void FTermcap::setBaudrate (int baud) noexcept
   baudrate = baud;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermcap::getPaddingCharCount (int ms) noexcept -> int
+{
+  // Number of padding characters that are transmitted in ms milliseconds
+  static constexpr int baudbyte = 9;  // = 7 bit + 1 parity + 1 stop
+  return (ms * baudrate) / (baudbyte * 1000);
+}
+
 //----------------------------------------------------------------------
 inline void FTermcap::delayOutput (int ms) noexcept
 {
@@ -211,9 +228,7 @@ inline void FTermcap::delayOutput (int ms) noexcept
   }
   else
   {
-    static constexpr int baudbyte = 9;  // = 7 bit + 1 parity + 1 stop
-
-    for ( int pad_char_count = (ms * baudrate) / (baudbyte * 1000);
+    for ( int pad_char_count = getPaddingCharCount(ms);
           pad_char_count > 0;
           pad_char_count-- )
     {
@@ -0,0 +1,571 @@
+/***********************************************************************
+* ftermcapprogram.cpp - Compiled parameterized termcap strings         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include "final/output/tty/ftermcapprogram.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr std::size_t program_stack_size = 20;
+constexpr std::size_t program_variables = 26;
+constexpr std::size_t no_jump = static_cast<std::size_t>(-1);
+
+//----------------------------------------------------------------------
+auto getStaticVariables() noexcept -> std::array<int, program_variables>&
+{
+  // The static variables [A-Z] keep their values between the calls
+  static std::array<int, program_variables> static_variables{};
+  return static_variables;
+}
+
+//----------------------------------------------------------------------
+void appendDecimal (int number, std::string& output)
+{
+  std::array<char, 12> digits{};
+  auto pos = digits.size();
+  auto value = ( number < 0 ) ? 0U - uInt32(number) : uInt32(number);
+
+  do
+  {
+    digits[--pos] = char('0' + value % 10);
+    value /= 10;
+  }
+  while ( value > 0 );
+
+  if ( number < 0 )
+    digits[--pos] = '-';
+
+  output.append(&digits[pos], digits.size() - pos);
+}
+
+//----------------------------------------------------------------------
+void appendFormatted (const std::string& format, int number, std::string& output)
+{
+  std::array<char, 64> buffer{};
+  const auto length = std::snprintf (buffer.data(), buffer.size(), format.data(), number);
+
+  if ( length < 0 )
+    return;
+
+  if ( std::size_t(length) < buffer.size() )
+  {
+    output.append(buffer.data(), std::size_t(length));
+    return;
+  }
+
+  // Large field widths
+  const auto offset = output.size();
+  output.resize(offset + std::size_t(length) + 1);
+  std::snprintf (&output[offset], std::size_t(length) + 1, format.data(), number);
+  output.resize(offset + std::size_t(length));
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FTermcapProgram
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTermcapProgram::FTermcapProgram (const char* string, std::size_t length)
+{
+  compile (string, length);
+}
+
+
+// public methods of FTermcapProgram
+//----------------------------------------------------------------------
+auto FTermcapProgram::isSource (const char* string, std::size_t length) const noexcept -> bool
+{
+  return string && length == source.length()
+      && std::memcmp(string, source.data(), length) == 0;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::compile (const char* string, std::size_t length) -> bool
+{
+  // Translates a parameterized terminfo string into a sequence of
+  // instructions. Returns false for strings with unsupported
+  // directives, which must then be evaluated with tparm().
+
+  reset();
+
+  if ( ! string )
+  {
+    source.clear();
+    return false;
+  }
+
+  source.assign(string, length);
+  const auto* iter = source.data();
+  const auto* end = iter + length;
+
+  while ( iter != end )
+  {
+    if ( *iter != '%' )
+    {
+      addLiteral (*iter);
+      ++iter;
+      continue;
+    }
+
+    ++iter;
+
+    if ( iter == end || ! compileDirective(iter, end) )
+    {
+      reset();
+      return false;
+    }
+  }
+
+  bool has_parameter{false};
+  bool has_output{false};
+
+  for (const auto& instruction : code)
+  {
+    has_parameter |= ( instruction.op == Op::PushParam );
+    has_output |= ( instruction.op == Op::PrintDecimal
+                 || instruction.op == Op::PrintChar
+                 || instruction.op == Op::PrintFormat
+                 || instruction.op == Op::Increment );
+  }
+
+  // Termcap-style strings use parameters without %p
+  if ( ! conditionals.empty() || (has_output && ! has_parameter) )
+  {
+    reset();
+    return false;
+  }
+
+  compiled = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgram::format (Parameters params, std::string& output) const
+{
+  // Executes the instructions with the given parameters
+
+  output.clear();
+
+  if ( ! compiled )
+    return;
+
+  std::array<int, internal::program_stack_size> stack{};
+  std::array<int, internal::program_variables> dynamic_variables{};
+  auto& static_variables = internal::getStaticVariables();
+  std::size_t stack_size{0};
+  std::size_t pc{0};
+  bool incremented{false};
+
+  auto push = [&stack, &stack_size] (int value)
+  {
+    if ( stack_size < stack.size() )
+      stack[stack_size++] = value;
+  };
+
+  auto pop = [&stack, &stack_size] ()
+  {
+    return ( stack_size > 0 ) ? stack[--stack_size] : 0;
+  };
+
+  while ( pc < code.size() )
+  {
+    const auto& instruction = code[pc];
+    pc++;
+
+    switch ( instruction.op )
+    {
+      case Op::Literal:
+        output.append(&literals[std::size_t(instruction.value)], instruction.length);
+        break;
+
+      case Op::PrintDecimal:
+        internal::appendDecimal (pop(), output);
+        break;
+
+      case Op::PrintChar:
+      {
+        const auto ch = pop();
+        output.push_back(char(( ch == 0 ) ? 0200 : ch));  // Like tparm()
+        break;
+      }
+
+      case Op::PrintFormat:
+        internal::appendFormatted (formats[std::size_t(instruction.value)], pop(), output);
+        break;
+
+      case Op::PushParam:
+        push (params[std::size_t(instruction.value)]);
+        break;
+
+      case Op::PushConst:
+        push (instruction.value);
+        break;
+
+      case Op::GetDynamic:
+        push (dynamic_variables[std::size_t(instruction.value)]);
+        break;
+
+      case Op::GetStatic:
+        push (static_variables[std::size_t(instruction.value)]);
+        break;
+
+      case Op::SetDynamic:
+        dynamic_variables[std::size_t(instruction.value)] = pop();
+        break;
+
+      case Op::SetStatic:
+        static_variables[std::size_t(instruction.value)] = pop();
+        break;
+
+      case Op::Increment:  // Only once, like tparm()
+        if ( ! incremented )
+        {
+          params[0]++;
+          params[1]++;
+          incremented = true;
+        }
+
+        break;
+
+      case Op::LogicalNot:
+        push (int(! pop()));
+        break;
+
+      case Op::BitNot:
+        push (~pop());
+        break;
+
+      case Op::JumpIfZero:
+        if ( pop() == 0 )
+          pc = std::size_t(instruction.value);
+
+        break;
+
+      case Op::Jump:
+        pc = std::size_t(instruction.value);
+        break;
+
+      default:  // Binary operators
+      {
+        const auto y = pop();
+        const auto x = pop();
+        push (calculate(instruction.op, x, y));
+      }
+    }
+  }
+}
+
+
+// private methods of FTermcapProgram
+//----------------------------------------------------------------------
+void FTermcapProgram::reset()
+{
+  // Removes the compiled code, but keeps the source string
+
+  literals.clear();
+  formats.clear();
+  code.clear();
+  conditionals.clear();
+  jump_target = internal::no_jump;
+  compiled = false;
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgram::addLiteral (char ch)
+{
+  // Adjacent characters are combined into one literal span,
+  // unless the next instruction is a jump target
+
+  if ( ! code.empty() && code.back().op == Op::Literal
+    && code.size() != jump_target )
+  {
+    literals.push_back(ch);
+    code.back().length++;
+    return;
+  }
+
+  code.push_back({Op::Literal, int(literals.size()), 1});
+  literals.push_back(ch);
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgram::addInstruction (Op op, int value)
+{
+  code.push_back({op, value, 0});
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::compileDirective (const char*& iter, const char* end) -> bool
+{
+  const auto ch = *iter;
+  const auto remaining = std::size_t(end - iter);
+
+  if ( ch == '%' )
+  {
+    addLiteral ('%');
+  }
+  else if ( ch == 'c' )
+  {
+    addInstruction (Op::PrintChar);
+  }
+  else if ( ch == 'p' )
+  {
+    if ( remaining < 2 || iter[1] < '1' || iter[1] > '9' )
+      return false;
+
+    addInstruction (Op::PushParam, iter[1] - '1');
+    ++iter;
+  }
+  else if ( ch == 'P' || ch == 'g' )
+  {
+    if ( remaining < 2 )
+      return false;
+
+    const auto var = iter[1];
+    const bool set = ( ch == 'P' );
+
+    if ( var >= 'a' && var <= 'z' )
+      addInstruction (set ? Op::SetDynamic : Op::GetDynamic, var - 'a');
+    else if ( var >= 'A' && var <= 'Z' )
+      addInstruction (set ? Op::SetStatic : Op::GetStatic, var - 'A');
+    else
+      return false;
+
+    ++iter;
+  }
+  else if ( ch == '\'' )
+  {
+    if ( remaining < 3 || iter[2] != '\'' )
+      return false;
+
+    addInstruction (Op::PushConst, int(uChar(iter[1])));
+    iter += 2;
+  }
+  else if ( ch == '{' )
+  {
+    int number{0};
+    ++iter;
+
+    while ( iter != end && *iter >= '0' && *iter <= '9' && number < 100'000'000 )
+    {
+      number = number * 10 + (*iter - '0');
+      ++iter;
+    }
+
+    if ( iter == end || *iter != '}' )
+      return false;
+
+    addInstruction (Op::PushConst, number);
+  }
+  else if ( ch == 'i' )
+  {
+    addInstruction (Op::Increment);
+  }
+  else if ( ch == '!' )
+  {
+    addInstruction (Op::LogicalNot);
+  }
+  else if ( ch == '~' )
+  {
+    addInstruction (Op::BitNot);
+  }
+  else if ( ch == '?' )
+  {
+    conditionals.push_back({internal::no_jump, {}});
+  }
+  else if ( ch == 't' || ch == 'e' || ch == ';' )
+  {
+    if ( ! compileConditional(ch) )
+      return false;
+  }
+  else if ( getBinaryOp(ch) != Op::Literal )
+  {
+    addInstruction (getBinaryOp(ch));
+  }
+  else
+  {
+    return compileFormat(iter, end);
+  }
+
+  ++iter;
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::compileFormat (const char*& iter, const char* end) -> bool
+{
+  // Output format %[[:]flags][width[.precision]][doxX]
+
+  std::string format_string{"%"};
+  bool allow_sign{false};
+  bool has_dot{false};
+
+  while ( iter != end )
+  {
+    const auto ch = *iter;
+    ++iter;
+
+    if ( ch == ':' && format_string.length() == 1 )
+    {
+      allow_sign = true;
+    }
+    else if ( ch == '#' || ch == ' ' || ((ch == '-' || ch == '+') && allow_sign) )
+    {
+      format_string.push_back(ch);
+    }
+    else if ( ch >= '0' && ch <= '9' )
+    {
+      format_string.push_back(ch);
+    }
+    else if ( ch == '.' && ! has_dot )
+    {
+      has_dot = true;
+      format_string.push_back(ch);
+    }
+    else if ( ch == 'd' || ch == 'o' || ch == 'x' || ch == 'X' )
+    {
+      format_string.push_back(ch);
+
+      if ( format_string.length() > 6 )
+        return false;  // Unusually long format
+
+      if ( format_string == "%d" )
+      {
+        addInstruction (Op::PrintDecimal);
+      }
+      else
+      {
+        addInstruction (Op::PrintFormat, int(formats.size()));
+        formats.push_back(format_string);
+      }
+
+      return true;
+    }
+    else
+    {
+      return false;  // Unsupported directive (e.g. %s or %l)
+    }
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::compileConditional (char ch) -> bool
+{
+  // %? expr %t then-part %e else-part %;
+  // The else-part can again contain an expression with %t
+
+  if ( conditionals.empty() )
+    return false;
+
+  auto& conditional = conditionals.back();
+
+  if ( ch == 't' )
+  {
+    if ( conditional.false_jump != internal::no_jump )
+      return false;
+
+    conditional.false_jump = code.size();
+    addInstruction (Op::JumpIfZero);
+    return true;
+  }
+
+  if ( ch == 'e' )
+  {
+    conditional.end_jumps.push_back(code.size());
+    addInstruction (Op::Jump);
+  }
+
+  jump_target = code.size();
+
+  if ( conditional.false_jump != internal::no_jump )
+  {
+    code[conditional.false_jump].value = int(jump_target);
+    conditional.false_jump = internal::no_jump;
+  }
+
+  if ( ch == ';' )
+  {
+    for (const auto index : conditional.end_jumps)
+      code[index].value = int(jump_target);
+
+    conditionals.pop_back();
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::getBinaryOp (char ch) noexcept -> Op
+{
+  switch ( ch )
+  {
+    case '+': return Op::Add;
+    case '-': return Op::Subtract;
+    case '*': return Op::Multiply;
+    case '/': return Op::Divide;
+    case 'm': return Op::Modulo;
+    case '&': return Op::BitAnd;
+    case '|': return Op::BitOr;
+    case '^': return Op::BitXor;
+    case '=': return Op::Equal;
+    case '>': return Op::Greater;
+    case '<': return Op::Less;
+    case 'A': return Op::LogicalAnd;
+    case 'O': return Op::LogicalOr;
+    default: return Op::Literal;  // Not a binary operator
+  }
+}
+
+//----------------------------------------------------------------------
+auto FTermcapProgram::calculate (Op op, int x, int y) noexcept -> int
+{
+  switch ( op )
+  {
+    case Op::Add: return int(uInt32(x) + uInt32(y));
+    case Op::Subtract: return int(uInt32(x) - uInt32(y));
+    case Op::Multiply: return int(uInt32(x) * uInt32(y));
+    case Op::Divide: return ( y == 0 ) ? 0 : ( y == -1 ) ? int(0U - uInt32(x)) : x / y;
+    case Op::Modulo: return ( y == 0 || y == -1 ) ? 0 : x % y;
+    case Op::BitAnd: return x & y;
+    case Op::BitOr: return x | y;
+    case Op::BitXor: return x ^ y;
+    case Op::Equal: return int(x == y);
+    case Op::Greater: return int(x > y);
+    case Op::Less: return int(x < y);
+    case Op::LogicalAnd: return int(x && y);
+    case Op::LogicalOr: return int(x || y);
+    default: return 0;
+  }
+}
+
+}  // namespace finalcut
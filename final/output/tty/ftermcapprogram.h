@@ -0,0 +1,146 @@
+/***********************************************************************
+* ftermcapprogram.h - Compiled parameterized termcap strings           *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermcapProgram ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FTERMCAPPROGRAM_H
+#define FTERMCAPPROGRAM_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermcapProgram
+//----------------------------------------------------------------------
+
+class FTermcapProgram final
+{
+  public:
+    // Using-declaration
+    using Parameters = std::array<int, 9>;
+
+    // Constructors
+    FTermcapProgram() = default;
+    FTermcapProgram (const char*, std::size_t);
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getSource() const noexcept -> const std::string&;
+
+    // Inquiry
+    auto isCompiled() const noexcept -> bool;
+    auto isSource (const char*, std::size_t) const noexcept -> bool;
+
+    // Methods
+    auto compile (const char*, std::size_t) -> bool;
+    void format (Parameters, std::string&) const;
+
+  private:
+    // Enumeration
+    enum class Op : uInt8
+    {
+      Literal,       // Copies a literal span
+      PrintDecimal,  // %d
+      PrintChar,     // %c
+      PrintFormat,   // %[[:]flags][width[.precision]][doxX]
+      PushParam,     // %p[1-9]
+      PushConst,     // %{nn} or %'c'
+      GetDynamic,    // %g[a-z]
+      GetStatic,     // %g[A-Z]
+      SetDynamic,    // %P[a-z]
+      SetStatic,     // %P[A-Z]
+      Increment,     // %i
+      Add, Subtract, Multiply, Divide, Modulo,  // %+ %- %* %/ %m
+      BitAnd, BitOr, BitXor,                    // %& %| %^
+      Equal, Greater, Less,                     // %= %> %<
+      LogicalAnd, LogicalOr,                    // %A %O
+      LogicalNot, BitNot,                       // %! %~
+      JumpIfZero,    // %t
+      Jump           // %e
+    };
+
+    struct Instruction
+    {
+      Op     op;
+      int    value;       // Parameter, constant, variable or target
+      uInt32 length{0};   // Length of a literal span
+    };
+
+    struct Conditional
+    {
+      std::size_t              false_jump;
+      std::vector<std::size_t> end_jumps;
+    };
+
+    // Methods
+    void reset();
+    void addLiteral (char);
+    void addInstruction (Op, int = 0);
+    auto compileDirective (const char*&, const char*) -> bool;
+    auto compileFormat (const char*&, const char*) -> bool;
+    auto compileConditional (char) -> bool;
+    static auto getBinaryOp (char) noexcept -> Op;
+    static auto calculate (Op, int, int) noexcept -> int;
+
+    // Data members
+    std::string               source{};
+    std::string               literals{};
+    std::vector<std::string>  formats{};
+    std::vector<Instruction>  code{};
+    std::vector<Conditional>  conditionals{};
+    std::size_t               jump_target{static_cast<std::size_t>(-1)};
+    bool                      compiled{false};
+};
+
+// FTermcapProgram inline functions
+//----------------------------------------------------------------------
+inline auto FTermcapProgram::getClassName() const -> FString
+{ return "FTermcapProgram"; }
+
+//----------------------------------------------------------------------
+inline auto FTermcapProgram::getSource() const noexcept -> const std::string&
+{ return source; }
+
+//----------------------------------------------------------------------
+inline auto FTermcapProgram::isCompiled() const noexcept -> bool
+{ return compiled; }
+
+}  // namespace finalcut
+
+#endif  // FTERMCAPPROGRAM_H
@@ -341,6 +341,12 @@ void FTermDetection::detectTerminal()
     // Identify the terminal via the secondary device attributes (SEC_DA)
     new_term_type = parseSecDA (new_term_type);
 
+    // Query the synchronized output mode (DEC private mode 2026)
+    parseSyncOutputMode();
+
+    // Query the kitty keyboard protocol (progressive enhancement)
+    parseKeyboardProtocol();
+
     // Determines the maximum number of colors
     new_term_type = determineMaxColor(new_term_type);
 
@@ -701,6 +707,94 @@ auto FTermDetection::getSecDA() const -> FString
   return sec_da_str;
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::parseSyncOutputMode()
+{
+  // The terminal supports synchronized output if it reports
+  // the mode 2026 as set (1), reset (2) or permanently set (3)
+
+  const auto& fterm_data = FTermData::getInstance();
+  sync_output_support = false;
+
+  if ( fterm_data.isTermType(FTermType::linux_con | FTermType::cygwin) )
+    return;
+
+  const auto mode_state = getSyncOutputMode();
+  sync_output_support = ( mode_state >= 1 && mode_state <= 3 );
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getSyncOutputMode() const -> int
+{
+  const auto& stdout_no{FTermios::getStdOut()};
+  // The request mode query (DECRQM) is followed by a device
+  // attributes query (DA), which every terminal answers. So there
+  // is no need to wait for a timeout if DECRQM is unknown.
+  const std::string DECRQM{CSI "?2026$p" CSI "c"};
+
+  if ( write(stdout_no, DECRQM.data(), DECRQM.length()) == -1 )
+    return 0;
+
+  std::fflush(stdout);
+  std::array<char, 64> temp{};
+  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
+  const auto pos = captureTerminalInput(temp, 150'000, isWithout_c);
+  const auto report = std::strstr(temp.data(), CSI "?2026;");
+  static constexpr auto parse = "\033[?2026;%1d$%c";
+  int mode_state{0};
+  char final_char{'\0'};
+
+  if ( pos > 0 && report
+    && std::sscanf(report, parse, &mode_state, &final_char) == 2
+    && final_char == 'y' )
+    return mode_state;
+
+  return 0;  // Mode not recognized
+}
+
+//----------------------------------------------------------------------
+void FTermDetection::parseKeyboardProtocol()
+{
+  // The terminal supports the kitty keyboard protocol
+  // if it reports the current progressive enhancement flags
+
+  const auto& fterm_data = FTermData::getInstance();
+  keyboard_protocol_support = false;
+
+  if ( fterm_data.isTermType(FTermType::linux_con | FTermType::cygwin) )
+    return;
+
+  keyboard_protocol_support = ( getKeyboardProtocolFlags() >= 0 );
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getKeyboardProtocolFlags() const -> int
+{
+  const auto& stdout_no{FTermios::getStdOut()};
+  // As with DECRQM, the device attributes query (DA) ends the
+  // answer without a timeout on terminals without this protocol
+  const std::string query{CSI "?u" CSI "c"};
+
+  if ( write(stdout_no, query.data(), query.length()) == -1 )
+    return -1;
+
+  std::fflush(stdout);
+  std::array<char, 64> temp{};
+  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
+  const auto pos = captureTerminalInput(temp, 150'000, isWithout_c);
+  const auto report = std::strstr(temp.data(), CSI "?");
+  static constexpr auto parse = "\033[?%10d%c";
+  int flags{-1};
+  char final_char{'\0'};
+
+  if ( pos > 0 && report
+    && std::sscanf(report, parse, &flags, &final_char) == 2
+    && final_char == 'u' )
+    return flags;
+
+  return -1;  // Protocol not supported
+}
+
 //----------------------------------------------------------------------
 auto FTermDetection::secDA_Analysis (const FString& current_term_type) -> FString
 {
@@ -73,6 +73,8 @@ class FTermDetection final
     auto  canDisplay256Colors() const noexcept -> bool;
     auto  hasTerminalDetection() const noexcept -> bool;
     auto  hasSetCursorStyleSupport() const noexcept -> bool;
+    auto  hasSynchronizedOutputSupport() const noexcept -> bool;
+    auto  hasKeyboardProtocolSupport() const noexcept -> bool;
 
     // Mutators
     void  setTerminalDetection (bool = true) noexcept;
@@ -128,6 +130,10 @@ class FTermDetection final
     auto  parseSecDA (const FString&) -> FString;
     auto  str2int (const FString&) const -> int;
     auto  getSecDA() const -> FString;
+    void  parseSyncOutputMode();
+    auto  getSyncOutputMode() const -> int;
+    void  parseKeyboardProtocol();
+    auto  getKeyboardProtocolFlags() const -> int;
     auto  secDA_Analysis (const FString&) -> FString;
     auto  secDA_Analysis_0 (const FString&) const -> FString;
     auto  secDA_Analysis_1 (const FString&) -> FString;
@@ -153,6 +159,8 @@ class FTermDetection final
     FString      term_type{};
     FString      tty_type_name{"/etc/ttytype"};  // Default ttytype file
     bool         decscusr_support{false};      // Preset to false
+    bool         sync_output_support{false};   // Preset to false
+    bool         keyboard_protocol_support{false};  // Preset to false
     bool         terminal_detection{true};     // Preset to true
     bool         color256{};
     FString      answer_back{};
@@ -193,6 +201,14 @@ inline auto FTermDetection::canDisplay256Colors() const noexcept -> bool
 inline auto FTermDetection::hasSetCursorStyleSupport() const noexcept -> bool
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasSynchronizedOutputSupport() const noexcept -> bool
+{ return sync_output_support; }
+
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasKeyboardProtocolSupport() const noexcept -> bool
+{ return keyboard_protocol_support; }
+
 //----------------------------------------------------------------------
 inline auto FTermDetection::hasTerminalDetection() const noexcept -> bool
 { return terminal_detection; }
@@ -21,6 +21,9 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <cstring>
+#include <string>
+#include <sys/ioctl.h>
 #include <unistd.h>
 #include <unordered_map>
 
@@ -30,15 +33,19 @@
 #include "final/input/fmouse.h"
 #include "final/output/tty/foptiattr.h"
 #include "final/output/tty/foptimove.h"
+#include "final/output/tty/frowscanner.h"
 #include "final/output/tty/ftermcap.h"
 #include "final/output/tty/ftermdata.h"
+#include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/ftermfreebsd.h"
 #include "final/output/tty/ftermios.h"
 #include "final/output/tty/ftermoutput.h"
+#include "final/output/tty/ftermwriter.h"
 #include "final/output/tty/ftermxterminal.h"
 #include "final/util/char_ringbuffer.h"
 #include "final/util/fpoint.h"
 #include "final/util/fsize.h"
+#include "final/util/fsystem.h"
 
 namespace finalcut
 {
@@ -46,44 +53,38 @@ namespace finalcut
 namespace internal
 {
 
-template <typename T>
-constexpr auto clampValue (T value, T minVal, T maxVal) -> T
-{
-  if ( value < minVal )
-    return minVal;
-
-  return ( value > maxVal ) ? maxVal : value;
-}
-
-template <typename T>
-constexpr auto adjustValue (T current, T reference, T delta, T minLimit) -> T
-{
-  if ( current > reference )
-    return reference + delta;
-
-  if ( reference >= delta )
-    return reference - delta;
-  else
-    return minLimit;  // Avoid underflow
-}
-
 struct var
 {
   static bool is_new_font;
   static bool has_sub_map;
+  static FTermWriter* output_writer;
 };
 
 Encoding terminal::encoding{Encoding::Unknown};
 bool var::is_new_font{false};
 bool var::has_sub_map{false};
+FTermWriter* var::output_writer{nullptr};
+
+//----------------------------------------------------------------------
+auto putCharToWriter (int ch) noexcept -> int
+{
+  const auto c = char(ch);
+  var::output_writer->write(&c, 1);
+  return ch;
+}
+
+//----------------------------------------------------------------------
+auto putStringToWriter (const char* string, uInt32 len) noexcept -> int
+{
+  var::output_writer->write(string, len);
+  return int(len);
+}
 
 }  // namespace internal
 
 // static class attributes
 FVTerm::FTermRegion* FTermOutput::vterm{nullptr};
 FTermData*           FTermOutput::fterm_data{nullptr};
-constexpr uInt64     FTermOutput::MIN_FLUSH_WAIT;
-constexpr uInt64     FTermOutput::MAX_FLUSH_WAIT;
 
 //----------------------------------------------------------------------
 // class FTermOutput
@@ -100,20 +101,28 @@ FTermOutput::FTermOutput (const FVTerm& t)  // constructor
 }
 
 //----------------------------------------------------------------------
-FTermOutput::~FTermOutput() noexcept = default;  // destructor
+FTermOutput::~FTermOutput() noexcept  // destructor
+{
+  stopOutputWriter();
+}
 
 
 // public methods of FTermOutput
 //----------------------------------------------------------------------
 auto FTermOutput::isFlushTimeout() const noexcept -> bool
 {
+  // A terminal that has not yet received the last frame
+  // reduces the refresh rate
+  if ( output_writer && output_writer->hasPendingOutput() )
+    return false;
+
   const auto now_us = uInt64(duration_cast<microseconds>( clock::now()
                                                          .time_since_epoch()).count() );
   if ( now_us < time_last_flush_us )
     return false;
 
   const auto diff_us = now_us - time_last_flush_us;
-  return diff_us > flush_wait;
+  return flush_timing.isFlushTimeout(diff_us);
 }
 
 //----------------------------------------------------------------------
@@ -199,6 +208,7 @@ void FTermOutput::initTerminal (FVTerm::FTermRegion* virtual_terminal)
 
   vterm         = virtual_terminal;
   output_buffer = std::make_shared<FOutputBuffer>();
+  output_writer = std::make_shared<FTermWriter>();
   term_pos      = std::make_shared<FPoint>(-1, -1);
 
   // Hide the input cursor
@@ -211,16 +221,38 @@ void FTermOutput::initTerminal (FVTerm::FTermRegion* virtual_terminal)
   // Check for support for combined characters
   init_combined_character();
 
+  // Byte costs for the optimal line encoding
+  init_lineCostModel();
+
   // Resetting the status of terminal attributes
   clearTerminalState();
 
+  // Check for synchronized output support (DEC private mode 2026)
+  sync_output = FTermDetection::getInstance().hasSynchronizedOutputSupport();
+
   // Initialize the last flush time
   time_last_flush_us = 0;
+
+  // Minimum time between two flushes
+  flush_timing.reset();
+  flush_timing.setTargetLatency(getStartOptions().flush_latency);
+
+  // Write the terminal output in a separate thread or without blocking
+  if ( getStartOptions().threaded_output
+    || getStartOptions().non_blocking_output )
+    startOutputWriter();
+
+  // A serial line limits the output from the start
+  if ( getStartOptions().bandwidth_budget )
+    bandwidth_budget.setBaudRate(fterm_data->getBaudrate());
 }
 
 //----------------------------------------------------------------------
 void FTermOutput::finishTerminal()
 {
+  // The terminal is restored synchronously
+  stopOutputWriter();
+
   // Restore the color palette
   restoreColorPalette();
 
@@ -232,31 +264,76 @@ void FTermOutput::finishTerminal()
     clearTerminal();
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::beginSynchronizedUpdate()
+{
+  // Begin synchronized update (BSU): The terminal holds back
+  // the rendering until the frame is complete
+
+  if ( ! sync_output || sync_frame
+    || ! (vterm->has_changes || repaint_terminal) )
+    return;
+
+  static constexpr char bsu[] = CSI "?2026h";
+  appendOutputBuffer (FOutputBuffer::OutputType::String, bsu, sizeof(bsu) - 1);
+  sync_frame = true;
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::updateTerminal() -> bool
 {
   // Updates pending changes to the terminal
 
   int changedlines{0};
-  const auto first_row = vterm->changes_in_row.ymin;
-  const auto last_row  = vterm->changes_in_row.ymax;
+  const bool repaint = repaint_terminal;
 
-  for (uInt y{first_row}; y <= last_row; y++)
-  {
-    FVTerm::reduceTerminalLineUpdates(y);
+  if ( repaint )
+    prepareTerminalRepaint();
 
-    if ( updateTerminalLine(y) )
-      changedlines++;
+  // A repaint is always written completely
+  const auto frame_budget = ( repaint ) ? 0
+                                        : bandwidth_budget.getFrameBudget(flush_timing.getFlushWait());
+
+  if ( frame_budget > 0 )
+  {
+    changedlines = updateTerminalLines(frame_budget);
   }
+  else
+  {
+    const auto first_row = vterm->changes_in_row.ymin;
+    const auto last_row  = vterm->changes_in_row.ymax;
+
+    for (uInt y{first_row}; y <= last_row; y++)
+    {
+      if ( ! repaint )  // A repaint must not skip unchanged characters
+        FVTerm::reduceTerminalLineUpdates(y);
 
-  vterm->changes_in_row = {uInt(vterm->size.height), 0};  // Reset row changes
-  vterm->has_changes = false;
+      if ( updateTerminalLine(y) )
+        changedlines++;
+    }
+
+    vterm->changes_in_row = {uInt(vterm->size.height), 0};  // Reset row changes
+    vterm->has_changes = false;
+  }
 
   // sets the new input cursor position
   const auto& cursor_update = updateTerminalCursor();
   return cursor_update || changedlines > 0;
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::endSynchronizedUpdate()
+{
+  // End synchronized update (ESU)
+
+  if ( ! sync_frame )
+    return;
+
+  static constexpr char esu[] = CSI "?2026l";
+  appendOutputBuffer (FOutputBuffer::OutputType::String, esu, sizeof(esu) - 1);
+  sync_frame = false;
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::scrollTerminalForward() -> bool
 {
@@ -277,6 +354,23 @@ auto FTermOutput::scrollTerminalReverse() -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::scrollTerminalRegion ( int top, int bottom, int lines
+                                       , std::size_t repaint_length ) -> bool
+{
+  // Scrolls the lines from top to bottom up (lines > 0) or down
+  // (lines < 0) if the scroll sequence is shorter than repainting
+
+  const auto& scroll_region = FTerm::scrollRegion (top, bottom, lines);
+
+  if ( ! scroll_region.data || scroll_region.length >= repaint_length )
+    return false;
+
+  appendOutputBuffer (FTermControl{scroll_region});
+  term_pos->setPoint(-1, -1);  // The cursor position is now undefined
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::clearTerminalState()
 {
@@ -339,32 +433,47 @@ void FTermOutput::flush()
 {
   // Flush the output buffer
 
-  flushTimeAdjustment();
+  if ( output_writer )
+    output_writer->resume();  // Continue a partial non-blocking write
 
-  if ( ! output_buffer || output_buffer->isEmpty()
+  if ( ! output_writer || ! output_buffer || output_buffer->isEmpty()
     || ! (isFlushTimeout() || getFVTerm().isTerminalUpdateForced()) )
     return;
 
-  const auto* data_ptr = output_buffer->data.data();
-  std::size_t offset = 0;  // The read position in the string
+  const auto frame_size = output_buffer->data.size();
+  const auto write_start_us = uInt64(duration_cast<microseconds>( clock::now()
+                                                                 .time_since_epoch()).count() );
 
-  while ( ! output_buffer->isEmpty() )
+  if ( ! writeOutputBuffer() )
   {
-    const auto& first = output_buffer->slices.front();
-    const auto& type = first.type;
-    const auto& length = first.length;
+    // The output writer has discarded stale frames, so that the terminal
+    // content is no longer known and must be completely rewritten
+    repaint_terminal = true;
+    beginSynchronizedUpdate();
+    updateTerminal();
+    endSynchronizedUpdate();
+
+    if ( ! writeOutputBuffer() )
+    {
+      repaint_terminal = true;  // Try again with the next update
+      vterm->has_changes = true;
+    }
+  }
 
-    if ( type == FOutputBuffer::OutputType::String )
-      FTerm::stringPrint (data_ptr + offset, length);
-    else if ( type == FOutputBuffer::OutputType::Control )
-      FTerm::paddingPrint (data_ptr + offset, length);
+  const auto write_end_us = uInt64(duration_cast<microseconds>( clock::now()
+                                                               .time_since_epoch()).count() );
 
-    offset += length;
-    output_buffer->slices.pop();
+  // An asynchronous writer only measures the queuing of the frame
+  // and reports a busy terminal with its pending output
+  if ( ! output_writer->isRunning() && ! output_writer->isNonBlocking() )
+  {
+    const auto write_us = write_end_us - write_start_us;
+    flush_timing.addWrite (frame_size, write_us, getOutputQueueSize(), write_end_us);
+
+    if ( getStartOptions().bandwidth_budget )
+      bandwidth_budget.addSample (frame_size, write_us);
   }
 
-  output_buffer->data.clear();
-  std::fflush(stdout);
   static auto& mouse = FMouseControl::getInstance();
   mouse.drawPointer();
   time_last_flush_us = uInt64(duration_cast<microseconds>( clock::now()
@@ -498,6 +607,77 @@ void FTermOutput::init_combined_character()
   }
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::init_lineCostModel()
+{
+  // The line encoder weighs all output operations by their length
+  // in bytes. Cursor movements are relative to line_encoder_origin.
+
+  const auto& ec = TCAP(t_erase_chars);
+  const auto& rp = TCAP(t_repeat_char);
+  const auto& lr = TCAP(t_repeat_last_char);
+  const auto& ce = TCAP(t_clr_eol);
+  auto& model = line_cost_model;
+  model = {};
+
+  model.attribute_change = [] (const FChar& from, const FChar& to)
+  {
+    static auto& opti_attr = FOptiAttr::getInstance();
+    return uInt(opti_attr.getAttributeChangeLength(from, to));
+  };
+
+  model.character = [this] (const FChar& fchar)
+  {
+    return getCharacterLength(fchar);
+  };
+
+  model.cursor_move = [this] (uInt from, uInt to)
+  {
+    const auto x = line_encoder_origin.getX();
+    const auto y = line_encoder_origin.getY();
+    const auto move = FTerm::moveCursor(x + int(from), y, x + int(to), y);
+    return move.data ? uInt(move.length) : 0;
+  };
+
+  if ( rp.data || lr.data )
+  {
+    model.repeat_character = [this] (const FChar& fchar, uInt repetitions)
+    {
+      const auto type = getRepetitionCapability(fchar);
+
+      if ( type == Repetition::ASCII )
+      {
+        const auto& rep = TCAP(t_repeat_char);
+        const auto ch = fchar.ch.unicode_data[0];
+        return uInt(FTermcap::encodeParameter(rep, ch, repetitions).length);
+      }
+
+      if ( type == Repetition::UTF8 )
+      {
+        const auto& rep = TCAP(t_repeat_last_char);
+        return getCharacterLength(fchar)
+             + uInt(FTermcap::encodeParameter(rep, repetitions).length);
+      }
+
+      return uInt(0);
+    };
+  }
+
+  if ( ec.data )
+  {
+    model.erase_characters = [] (uInt count)
+    {
+      return uInt(FTermcap::encodeParameter(TCAP(t_erase_chars), count).length);
+    };
+  }
+
+  model.clear_to_eol = ce.data ? clr_eol_length : 0;
+  model.background_color_erase = FTermcap::background_color_erase;
+  model.cursor_address_length = cursor_address_length;
+  model.erase_char_length = erase_char_length;
+  model.repeat_char_length = repeat_char_length;
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::canClearToEOL (uInt xmin, uInt y) const -> bool
 {
@@ -510,7 +690,7 @@ auto FTermOutput::canClearToEOL (uInt xmin, uInt y) const -> bool
     return false;
 
   const auto width = uInt(vterm->size.width);
-  const auto* row_begin = &vterm->data[std::size_t(y) * width];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto* min_char = std::next(row_begin, xmin);
 
@@ -545,21 +725,14 @@ auto FTermOutput::canClearLeadingWS (uInt& xmin, uInt y) const -> bool
     return false;
 
   const auto width = uInt(vterm->size.width);
-  const auto* row_begin = &vterm->data[std::size_t(y) * width];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto& first_char = *row_begin;
 
   if ( first_char.ch.unicode_data[0] != L' ' )
     return false;
 
-  auto first_diff = std::find_if ( std::next(row_begin)
-                                 , row_end
-                                 , [&first_char] (const FChar& ch)
-                                   {
-                                     return first_char != ch;
-                                   } );
-
-  auto leading_whitespace = uInt(std::distance(row_begin, first_diff));
+  const auto leading_whitespace = uInt(FRowScanner::countEqual(row_begin, row_end, first_char));
   const auto normal = FOptiAttr::isNormal(first_char);
   const auto ut = FTermcap::background_color_erase;
 
@@ -585,24 +758,15 @@ auto FTermOutput::canClearTrailingWS (uInt& xmax, uInt y) const -> bool
     return false;
 
   const int width = vterm->size.width;
-  const auto* row_begin = &vterm->data[std::size_t(y) * unsigned(width)];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto* last_char = std::prev(row_end);
 
   if ( last_char->ch.unicode_data[0] != L' ' )
     return false;
 
-  auto r_begin = std::make_reverse_iterator(row_end);
-  auto r_end = std::make_reverse_iterator(row_begin);
-
-  auto first_diff = std::find_if ( std::next(r_begin)
-                                 , r_end
-                                 , [last_char] (const FChar& ch)
-                                   {
-                                     return *last_char != ch;
-                                   } );
-
-  const auto trailing_whitespace = uInt(std::distance(r_begin, first_diff));
+  const auto trailing_whitespace = \
+      uInt(FRowScanner::countEqualReverse(row_begin, row_end, *last_char));
   const auto normal = FOptiAttr::isNormal(*last_char);
   const auto ut = FTermcap::background_color_erase;
 
@@ -627,24 +791,9 @@ auto FTermOutput::skipUnchangedCharacters ( uInt& x, uInt xmax, uInt y
   if ( ! iter->isBitSet(mask) )
     return false;
 
-  auto ch = iter + 1;  // Skip first unchanged character
-  const auto end = ch + xmax - x;
-
-  // Unroll the loop for better performance
-  while ( ch + 4 <= end
-       && ch[0].isBitSet(mask) && ch[1].isBitSet(mask)
-       && ch[2].isBitSet(mask) && ch[3].isBitSet(mask) )
-  {
-    ch += 4;
-  }
-
-  // Handle the remaining elements
-  while ( ch < end && ch->isBitSet(mask) )
-  {
-    ++ch;
-  }
-
-  auto count = uInt(ch - iter);  // Number of unchanged characters
+  const auto* first = &*iter;
+  const auto* last = first + (xmax - x) + 1;
+  const auto count = uInt(FRowScanner::countUnchanged(first, last));  // Number of unchanged characters
 
   if ( count > cursor_address_length )
   {
@@ -681,6 +830,13 @@ void FTermOutput::printRange (uInt xmin, uInt xmax, uInt y)
     if ( skipUnchangedCharacters(x, xmax, y, iter) )
       continue;
 
+    // Print consecutive half-width characters in one piece
+    if ( printCharacterRun(x, xmax, y, iter) )
+    {
+      ++x;
+      continue;
+    }
+
     // Erase character
     if ( ec.data && iter->ch.unicode_data[0] == L' ' )
     {
@@ -702,6 +858,100 @@ void FTermOutput::printRange (uInt xmin, uInt xmax, uInt y)
   }
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutput::printSpans (uInt xmin, uInt xmax, uInt y)
+{
+  // Prints all damage spans of line y within xmin and xmax
+
+  const auto& vterm_changes = vterm->changes_in_line[y];
+  const auto span_count = vterm_changes.getSpanCount();
+
+  for (std::size_t i{0}; i < span_count; i++)
+  {
+    const auto span = vterm_changes.getSpan(i);
+    const auto from = std::max(span.xmin, xmin);
+    const auto to = std::min(span.xmax, xmax);
+
+    if ( from > to )
+      continue;
+
+    setCursor (FPoint{int(from), int(y)});
+
+    if ( ! printEncodedRange(from, to, y) )
+      printRange (from, to, y);
+  }
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::canEncodeRange (uInt xmin, uInt xmax, uInt y) -> bool
+{
+  // The line encoder handles UTF-8 output of half-width characters.
+  // Full-width characters, charset changes and the lower right
+  // corner remain with printRange().
+
+  if ( ! getStartOptions().optimal_line_encoding
+    || internal::terminal::encoding != Encoding::UTF8
+    || internal::var::is_new_font )
+    return false;
+
+  const auto width = uInt(vterm->size.width);
+  const auto height = uInt(vterm->size.height);
+
+  if ( y == height - 1 && xmax == width - 1 )
+    return false;
+
+  const auto* first = &vterm->getFChar(int(xmin), int(y));
+  const auto* last = first + (xmax - xmin) + 1;
+
+  return std::none_of ( first, last
+                      , [this] (const FChar& fchar)
+                        {
+                          return isFullWidthChar(fchar)
+                              || isFullWidthPaddingChar(fchar);
+                        } );
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::printEncodedRange (uInt xmin, uInt xmax, uInt y) -> bool
+{
+  // Prints the range [xmin, xmax] of line y with the minimum number
+  // of bytes
+
+  if ( ! canEncodeRange(xmin, xmax, y) )
+    return false;
+
+  const auto* first = &vterm->getFChar(int(xmin), int(y));
+  const auto* last = first + (xmax - xmin) + 1;
+  line_encoder_origin.setPoint(int(xmin), int(y));
+  line_cost_model.reaches_eol = ( xmax == uInt(vterm->size.width - 1) );
+
+  if ( ! line_encoder.encode(first, last, term_attribute, line_cost_model) )
+    return false;
+
+  for (const auto& step : line_encoder.getPlan())
+  {
+    const auto x = xmin + step.x;
+    const auto iter = vterm->getFCharIterator(int(x), int(y));
+
+    if ( step.op == FLineEncoder::Operation::Print )
+      appendCharacter (iter);
+    else if ( step.op == FLineEncoder::Operation::Repeat )
+      appendRepetition (iter, step.count, getRepetitionCapability(*iter));
+    else if ( step.op == FLineEncoder::Operation::Erase )
+      appendEraseCharacters (iter, step.count);
+    else if ( step.op == FLineEncoder::Operation::ClearToEOL )
+    {
+      appendAttributes (*iter);
+      appendOutputBuffer (FTermControl{TCAP(t_clr_eol)});
+    }
+    else if ( step.op == FLineEncoder::Operation::Move )
+      setCursor (FPoint{int(x), int(y)});
+  }
+
+  markAsPrinted (xmin, xmax, y);
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutput::replaceNonPrintableFullwidth ( uInt x, uInt vterm_width
                                                       , FChar& print_char ) const noexcept
@@ -723,6 +973,99 @@ inline void FTermOutput::replaceNonPrintableFullwidth ( uInt x, uInt vterm_width
   }
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::printCharacterRun ( uInt& x, uInt xmax, uInt y
+                                    , const FChar_iterator& iter ) -> bool
+{
+  // Prints a run of half-width characters without attribute changes
+  // with one UTF-8 encoding step instead of character by character
+
+  auto count = countCharacterRun(x, xmax, y, iter);
+
+  if ( count < 2 )
+    return false;
+
+  appendAttributes (*iter);
+  const auto* first = &*iter;
+  const auto* last = first + count;
+  run_chars.clear();
+
+  for (const auto* cell = first; cell < last; ++cell)
+  {
+    // Later characters must not change the terminal attributes
+    if ( cell != first
+      && ( term_attribute.color.data != cell->color.data
+        || (term_attribute.attr.data & 0x0000ffffU) != (cell->attr.data & 0x0000ffffU) ) )
+    {
+      count = uInt(cell - first);
+      break;
+    }
+
+    for (const auto& ch : cell->ch)
+    {
+      if ( ch == L'\0' )
+        break;
+
+      run_chars.push_back(ch);
+
+      if ( ! combined_char_support )
+        break;
+    }
+  }
+
+  appendOutputBuffer (run_chars.data(), run_chars.data() + run_chars.size());
+  term_pos->x_ref() += int(count);
+  const uInt end_pos = x + count - 1;
+  markAsPrinted (x, end_pos, y);
+  x = end_pos;
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::countCharacterRun ( uInt x, uInt xmax, uInt y
+                                    , const FChar_iterator& iter ) const -> uInt
+{
+  // Counts the characters from x that the general character output
+  // would print one by one without cursor movement or repetition
+
+  if ( internal::terminal::encoding != Encoding::UTF8
+    || internal::var::is_new_font )
+    return 0;
+
+  const auto& ec = TCAP(t_erase_chars);
+  const bool can_repeat = TCAP(t_repeat_char).data || TCAP(t_repeat_last_char).data;
+  const auto width = uInt(vterm->size.width);
+  const auto height = uInt(vterm->size.height);
+
+  // The lower right corner requires a special treatment
+  const auto last_x = ( y == height - 1 ) ? std::min(xmax, width - 2) : xmax;
+
+  if ( last_x < x )
+    return 0;
+
+  const auto* cell = &*iter;
+  const auto* prev = ( x > 0 ) ? cell - 1 : nullptr;
+  uInt count{0};
+
+  for (auto pos = x; pos <= last_x; pos++, prev = cell, cell++)
+  {
+    if ( isFullWidthChar(*cell) || isFullWidthPaddingChar(*cell)
+      || (prev && isFullWidthChar(*prev))
+      || cell->isBitSet(FAttribute::set::no_changes) )
+      break;
+
+    // Repeated characters and whitespace are printed as a sequence
+    const bool is_erasable = ec.data && cell->ch.unicode_data[0] == L' ';
+
+    if ( (can_repeat || is_erasable) && pos < xmax && *cell == *(cell + 1) )
+      break;
+
+    count++;
+  }
+
+  return count;
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::printCharacter ( uInt& x, uInt y, bool min_and_not_max
                                  , const FChar_iterator& iter)
@@ -878,9 +1221,7 @@ auto FTermOutput::eraseCharacters (uInt& x, uInt xmax, uInt y, const FChar_itera
 
   if ( canUseEraseCharacters(*iter, whitespace) )
   {
-    appendAttributes (*iter);
-    const auto term_ctrl = FTermcap::encodeParameter(ec, whitespace);
-    appendOutputBuffer (FTermControl{term_ctrl});
+    appendEraseCharacters (iter, whitespace);
 
     if ( end_pos <= xmax )
       setCursor (FPoint{static_cast<int>(x + whitespace), static_cast<int>(y)});
@@ -919,22 +1260,9 @@ auto FTermOutput::repeatCharacter (uInt& x, uInt xmax, uInt y, const FChar_itera
   // cannot repeat in their byte sequence
   const auto repetition_type = getRepetitionType(*iter, repetitions);
 
-  if ( rp.data && repetition_type == Repetition::ASCII )
-  {
-    newFontChanges (*iter);
-    charsetChanges (*iter);
-    appendAttributes (*iter);
-    const auto term_ctrl = FTermcap::encodeParameter(rp, iter->ch.unicode_data[0], repetitions);
-    appendOutputBuffer (FTermControl{term_ctrl});
-    term_pos->x_ref() += static_cast<int>(repetitions);
-  }
-  else if ( lr.data && repetition_type == Repetition::UTF8 )
-  {
-    appendChar (*iter);
-    const auto term_ctrl = FTermcap::encodeParameter(lr, repetitions);
-    appendOutputBuffer (FTermControl{term_ctrl});
-    term_pos->x_ref() += static_cast<int>(repetitions);
-  }
+  if ( (rp.data && repetition_type == Repetition::ASCII)
+    || (lr.data && repetition_type == Repetition::UTF8) )
+    appendRepetition (iter, repetitions, repetition_type);
   else
     appendCharacter_n (iter, repetitions);
 
@@ -951,17 +1279,9 @@ inline auto FTermOutput::countRepetitions ( FChar_const_iterator iter
   if ( to < from )
     return 0;
 
-  const FChar first = iter[0];
-  const uInt end = (to - from) + 1;
-  uInt index = 1;
-
-  for (; index < end; ++index)
-  {
-    if ( iter[index] != first )
-      break;
-  }
-
-  return index;
+  const auto* first = &*iter;
+  const auto* last = first + (to - from) + 1;
+  return uInt(FRowScanner::countEqual(first, last, *first));
 }
 
 //----------------------------------------------------------------------
@@ -1001,6 +1321,47 @@ inline auto FTermOutput::getRepetitionType ( const FChar& print_char
   return Repetition::NotOptimized;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::getRepetitionCapability (const FChar& print_char) const noexcept -> Repetition
+{
+  // Repetition type without a minimum number of repetitions
+
+  if ( print_char.ch[0] == L'\0' || print_char.ch[1] != L'\0' )
+    return Repetition::NotOptimized;
+
+  const auto ch = print_char.ch.unicode_data[0];
+
+  if ( TCAP(t_repeat_char).data && is7bit(ch) )
+    return Repetition::ASCII;
+
+  if ( TCAP(t_repeat_last_char).data && isPrintable(ch) )
+    return Repetition::UTF8;
+
+  return Repetition::NotOptimized;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getCharacterLength (const FChar& print_char) const -> uInt
+{
+  // Number of UTF-8 bytes of the character
+
+  std::array<char, 4> utf8{};
+  uInt length{0};
+
+  for (const auto& ch : print_char.ch)
+  {
+    if ( ch == L'\0' )
+      break;
+
+    length += UTF8::encode(ch, utf8);
+
+    if ( ! combined_char_support )
+      break;
+  }
+
+  return length;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::isFullWidthChar (const FChar& ch) const noexcept -> bool
 {
@@ -1070,8 +1431,8 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
   // Updates pending changes from line y to the terminal
 
   auto& vterm_changes = vterm->changes_in_line[y];
-  uInt& xmin = vterm_changes.xmin;
-  uInt& xmax = vterm_changes.xmax;
+  uInt xmin = vterm_changes.xmin;
+  uInt xmax = vterm_changes.xmax;
 
   if ( xmin > xmax )  // This line has no changes
     return false;
@@ -1099,7 +1460,7 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
       markAsPrinted (0, xmin, y);
     }
 
-    printRange (xmin, xmax, y);
+    printSpans (xmin, xmax, y);
 
     if ( draw_trailing_ws )
     {
@@ -1111,12 +1472,106 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
   }
 
   // Reset line changes and wrap the cursor
-  xmin = uInt(vterm->size.width);
-  xmax = 0;
+  vterm_changes.clear (uInt(vterm->size.width));
   cursorWrap();
   return true;
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::updateTerminalLines (std::size_t frame_budget) -> int
+{
+  // Updates the changed lines in the order of their priority until
+  // the byte budget of the frame is used up. The remaining lines keep
+  // their changes and follow with the next terminal updates. The sweep
+  // over the other lines continues at the first deferred line, so that
+  // no line waits forever for its output.
+
+  const auto first_row = vterm->changes_in_row.ymin;
+  const auto last_row  = vterm->changes_in_row.ymax;
+  std::size_t used_bytes{0};
+  int changedlines{0};
+
+  auto update_line = [&] (uInt y)
+  {
+    if ( y < first_row || y > last_row
+      || (changedlines > 0 && used_bytes >= frame_budget) )
+      return;
+
+    const auto size_before = output_buffer->data.size();
+    FVTerm::reduceTerminalLineUpdates(y);
+
+    if ( ! updateTerminalLine(y) )
+      return;
+
+    const auto size_after = output_buffer->data.size();
+    // A full output buffer was flushed in the meantime
+    used_bytes += ( size_after >= size_before ) ? size_after - size_before
+                                                : size_after;
+    changedlines++;
+  };
+
+  auto is_deferred = [this] (uInt y)
+  {
+    const auto& line_changes = vterm->changes_in_line[y];
+    return line_changes.xmin <= line_changes.xmax;
+  };
+
+  // 1. The line with the input cursor
+  if ( isInputCursorInsideTerminal() )
+    update_line (uInt(vterm->input_cursor.y));
+
+  // 2. The line that has waited the longest
+  const auto sweep_start = std::min(std::max(sweep_row, first_row), last_row);
+
+  if ( first_row <= last_row )
+    update_line (sweep_start);
+
+  // 3. The lines of the focused window
+  if ( const auto* active_region = FVTerm::getActiveRegion() )
+  {
+    const auto top = std::max(active_region->position.y, 0);
+    const auto bottom = active_region->position.y
+                      + active_region->size.height
+                      + active_region->shadow.height;
+
+    for (auto y{top}; y < bottom; y++)
+      update_line (uInt(y));
+  }
+
+  // 4. All other lines, beginning with the line of step 2
+  const auto row_count = ( first_row <= last_row ) ? last_row - first_row + 1 : 0;
+  bool sweep_row_found{false};
+  sweep_row = 0;
+
+  for (uInt i{0}; i < row_count; i++)
+  {
+    const auto y = first_row + (sweep_start - first_row + i) % row_count;
+    update_line (y);
+
+    if ( ! sweep_row_found && is_deferred(y) )
+    {
+      sweep_row = y;  // The next sweep starts here
+      sweep_row_found = true;
+    }
+  }
+
+  // Keep the deferred lines for the next terminal update
+  FVTerm::FTermRegion::FRowChanges deferred_rows{uInt(vterm->size.height), 0};
+
+  for (uInt y{first_row}; y <= last_row; y++)
+  {
+    if ( ! is_deferred(y) )
+      continue;
+
+    deferred_rows.ymin = std::min(deferred_rows.ymin, y);
+    deferred_rows.ymax = y;
+  }
+
+  vterm->changes_in_row = deferred_rows;
+  vterm->has_changes = deferred_rows.ymin <= deferred_rows.ymax;
+  return changedlines;
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::updateTerminalCursor() -> bool
 {
@@ -1134,29 +1589,147 @@ auto FTermOutput::updateTerminalCursor() -> bool
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::flushTimeAdjustment() noexcept
+auto FTermOutput::getOutputQueueSize() const -> std::size_t
 {
-  const auto now_us = uInt64(duration_cast<microseconds>( clock::now()
-                                                         .time_since_epoch()).count() );
-  const auto diff_us = now_us - time_last_flush_us;
+  // Returns the number of bytes that the terminal has not yet
+  // taken from the output queue (0 = empty or unknown)
+
+#if defined(TIOCOUTQ)
+  static const auto& fsys = FSystem::getInstance();
+  int queued{0};
+
+  if ( fsys->ioctl(FTermios::getStdOut(), TIOCOUTQ, &queued) == 0 && queued > 0 )
+    return std::size_t(queued);
+#endif
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::printOutputBuffer()
+{
+  const auto* data_ptr = output_buffer->data.data();
+  std::size_t offset = 0;  // The read position in the string
 
-  if ( diff_us > RESET_THRESHOLD )
+  while ( ! output_buffer->isEmpty() )
+  {
+    const auto& first = output_buffer->slices.front();
+    const auto& type = first.type;
+    const auto& length = first.length;
+
+    if ( type == FOutputBuffer::OutputType::String )
+      FTerm::stringPrint (data_ptr + offset, length);
+    else if ( type == FOutputBuffer::OutputType::Control )
+      FTerm::paddingPrint (data_ptr + offset, length);
+
+    offset += length;
+    output_buffer->slices.pop();
+  }
+
+  output_buffer->clear();
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::writeOutputBuffer() -> bool
+{
+  // Writes the output buffer as one frame. Returns false if the
+  // writer thread has superseded the frame.
+
+  if ( output_buffer->hasControlData() )
   {
-    flush_wait    = MIN_FLUSH_WAIT;  // Reset to minimum values after 400 ms
-    flush_average = MIN_FLUSH_WAIT;
-    flush_median  = MIN_FLUSH_WAIT;
+    // Padding delays require the output character by character
+    output_writer->beginFrame();
+    printOutputBuffer();
+    std::fflush(stdout);
+    return output_writer->commitFrame();
+  }
+
+  const auto& data = output_buffer->data;
+  const bool accepted = output_writer->writeFrame(data.data(), data.size());
+  output_buffer->clear();
+  return accepted;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::startOutputWriter()
+{
+  // Passes all terminal output to a writer thread or to the
+  // non-blocking output queue, so that a slow terminal connection
+  // does not block the event processing
+
+  const bool threaded = getStartOptions().threaded_output
+                     && output_writer->start();
+
+  if ( ! threaded )
+  {
+    if ( ! getStartOptions().non_blocking_output )
+      return;  // Continue with synchronous output
+
+    output_writer->setNonBlocking();
+  }
+
+  internal::var::output_writer = output_writer.get();
+  FTermcap::setPutCharFunction (&internal::putCharToWriter);
+  FTermcap::setPutStringFunction (&internal::putStringToWriter);
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::stopOutputWriter()
+{
+  if ( ! output_writer
+    || ! (output_writer->isRunning() || output_writer->isNonBlocking()) )
     return;
+
+  output_writer->stop();  // Writes the remaining output
+  FTermcap::setDefaultPutCharFunction();
+  FTermcap::setDefaultPutStringFunction();
+  internal::var::output_writer = nullptr;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::prepareTerminalRepaint()
+{
+  // Resets the assumed terminal state and marks all characters
+  // of the virtual terminal for output
+
+  repaint_terminal = false;
+  const auto width = uInt(vterm->size.width);
+  const auto height = uInt(vterm->size.height);
+
+  if ( width == 0 || height == 0 )
+    return;
+
+  if ( TCAP(t_exit_attribute_mode).data )
+    appendOutputBuffer (FTermControl{TCAP(t_exit_attribute_mode)});
+
+  if ( TCAP(t_exit_alt_charset_mode).data )
+    appendOutputBuffer (FTermControl{TCAP(t_exit_alt_charset_mode)});
+
+  clearTerminalState();
+  term_pos->setPoint(-1, -1);
+
+  // Resend the cursor visibility by inverting the stored state
+  const bool hidden = fterm_data->isCursorHidden();
+  fterm_data->setCursorHidden (! hidden);
+  const auto& visibility = FTerm::cursorsVisibility(hidden);
+
+  if ( visibility.data )
+    appendOutputBuffer (FTermControl{visibility});
+
+  fterm_data->setCursorHidden (hidden);
+
+  for (uInt y{0}; y < height; y++)
+  {
+    auto iter = vterm->getFCharIterator(0, int(y));
+    std::for_each ( iter, iter + width
+                  , [] (auto& fchar) noexcept
+                    {
+                      fchar.unsetBit(FAttribute::unset::no_changes);
+                    } );
+    vterm->changes_in_line[y].setSpan (0, width - 1);
   }
 
-  const uInt64 us = internal::clampValue(diff_us, MIN_FLUSH_WAIT, MAX_FLUSH_WAIT);
-  const uInt64 avg = flush_average;
-  const uInt64 delta_avg = ( us > avg ) ? (us - avg) / 10
-                                        : (avg - us) / 10;
-  flush_average = internal::adjustValue (us, avg, delta_avg, MIN_FLUSH_WAIT);
-  const uInt64 med  = flush_median;
-  const uInt64 step = flush_average / 5;
-  flush_median  = internal::adjustValue (us, med, step, MIN_FLUSH_WAIT);
-  flush_wait = flush_median;
+  vterm->changes_in_row = {0, height - 1};
 }
 
 //----------------------------------------------------------------------
@@ -1283,6 +1856,41 @@ inline void FTermOutput::appendCharacter_n (const FChar_iterator& next_char_iter
     appendCharacter (next_char_iter);
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::appendRepetition ( const FChar_iterator& next_char_iter
+                                   , uInt repetitions, Repetition type )
+{
+  if ( type == Repetition::ASCII )
+  {
+    newFontChanges (*next_char_iter);
+    charsetChanges (*next_char_iter);
+    appendAttributes (*next_char_iter);
+    const auto term_ctrl = FTermcap::encodeParameter ( TCAP(t_repeat_char)
+                                                     , next_char_iter->ch.unicode_data[0]
+                                                     , repetitions );
+    appendOutputBuffer (FTermControl{term_ctrl});
+  }
+  else
+  {
+    appendChar (*next_char_iter);
+    const auto term_ctrl = FTermcap::encodeParameter(TCAP(t_repeat_last_char), repetitions);
+    appendOutputBuffer (FTermControl{term_ctrl});
+  }
+
+  term_pos->x_ref() += static_cast<int>(repetitions);
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::appendEraseCharacters ( const FChar_iterator& next_char_iter
+                                               , uInt number )
+{
+  // The cursor position does not change
+
+  appendAttributes (*next_char_iter);
+  const auto term_ctrl = FTermcap::encodeParameter(TCAP(t_erase_chars), number);
+  appendOutputBuffer (FTermControl{term_ctrl});
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutput::appendChar (FChar& next_char)
 {
@@ -1434,8 +2042,31 @@ inline void FTermOutput::checkFreeBufferSize()
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const FTermControl& ctrl)
 {
-  appendOutputBuffer ( FOutputBuffer::OutputType::Control
-                     , ctrl.termcap.data, ctrl.termcap.length );
+  // The padding is resolved here, so that the frame can be written
+  // in one piece instead of character by character
+
+  const auto& cap = ctrl.termcap;
+
+  if ( ! cap.data || cap.length == 0 )
+    return;
+
+  if ( ! std::memchr(cap.data, '$', cap.length) )
+  {
+    appendOutputBuffer (FOutputBuffer::OutputType::String, cap.data, cap.length);
+    return;
+  }
+
+  static std::string encoded{};
+  encoded.clear();
+
+  if ( FTermcap::paddingEncode(cap.data, cap.length, 1, encoded)
+       == FTermcap::Status::OK )
+  {
+    appendOutputBuffer ( FOutputBuffer::OutputType::String
+                       , encoded.data(), uInt32(encoded.size()) );
+  }
+  else  // The padding requires a real delay
+    appendOutputBuffer (FOutputBuffer::OutputType::Control, cap.data, cap.length);
 }
 
 //----------------------------------------------------------------------
@@ -1457,6 +2088,25 @@ inline void FTermOutput::appendOutputBuffer (wchar_t ucs)
   }
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutput::appendOutputBuffer (const wchar_t* first, const wchar_t* last)
+{
+  static constexpr auto type = FOutputBuffer::OutputType::String;
+  auto& slices = output_buffer->slices;
+  auto& last_slice = slices.back();
+
+  if ( ! slices.isEmpty() && last_slice.type == type )
+  {
+    last_slice.length += output_buffer->data.appendUnicode(first, last);
+  }
+  else
+  {
+    const auto length = output_buffer->data.appendUnicode(first, last);
+    slices.emplace(type, length);
+    checkFreeBufferSize();
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const UniChar& ch)
 {
@@ -1471,6 +2121,9 @@ inline void FTermOutput::appendOutputBuffer ( FOutputBuffer::OutputType type
   auto& slices = output_buffer->slices;
   auto& last = slices.back();
 
+  if ( type == FOutputBuffer::OutputType::Control )
+    output_buffer->control_slices++;
+
   if ( ! slices.isEmpty() && last.type == type )
   {
     output_buffer->data.append(data, length);
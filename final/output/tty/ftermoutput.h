@@ -44,9 +44,14 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "final/output/foutput.h"
+#include "final/output/tty/fbandwidthbudget.h"
+#include "final/output/tty/fflushtiming.h"
+#include "final/output/tty/flineencoder.h"
 #include "final/output/tty/fterm.h"
+#include "final/output/tty/futf8encoder.h"
 #include "final/util/char_ringbuffer.h"
 
 namespace finalcut
@@ -65,6 +70,7 @@ struct terminal
 // class forward declaration
 class FStartOptions;
 class FTermData;
+class FTermWriter;
 template <typename T, std::size_t Capacity>
 class FRingBuffer;
 
@@ -89,6 +95,16 @@ class FCharBuffer
       return UTF8::encode(ucs, buffer);
     }
 
+    inline auto appendUnicode (const wchar_t* first, const wchar_t* last) -> uInt32
+    {
+      const auto old_size = buffer.size();
+      const auto max_length = FUTF8Encoder::MAX_CHAR_LENGTH * std::size_t(last - first);
+      buffer.resize(old_size + max_length);
+      const auto length = FUTF8Encoder::encode(first, last, &buffer[old_size]);
+      buffer.resize(old_size + length);
+      return uInt32(length);
+    }
+
     inline const char* data() const noexcept
     {
       return buffer.data();
@@ -153,9 +169,22 @@ struct FOutputBuffer
     return slices.isEmpty();
   }
 
+  inline auto hasControlData() const noexcept -> bool
+  {
+    return control_slices > 0;
+  }
+
+  inline void clear() noexcept
+  {
+    slices.clear();
+    data.clear();
+    control_slices = 0;
+  }
+
   // Data members
   TypeSliceBuffer slices{};
   FCharBuffer data{2 * BUFFER_SIZE};
+  std::size_t control_slices{0};  // Output with unresolved padding
 };
 
 
@@ -210,12 +239,15 @@ class FTermOutput final : public FOutput
     // Methods
     void initTerminal (FVTerm::FTermRegion*) override;
     void finishTerminal() override;
+    void beginSynchronizedUpdate() override;
     auto updateTerminal() -> bool override;
+    void endSynchronizedUpdate() override;
     void detectTerminalSize() override;
     void commitTerminalResize() override;
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalRegion (int, int, int, std::size_t) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
@@ -247,12 +279,6 @@ class FTermOutput final : public FOutput
 
     enum class CursorMoved : bool { No, Yes };
 
-    // Constants
-    //   Upper and lower flush limit
-    static constexpr uInt64 MIN_FLUSH_WAIT   = 16'667;   //  16.6 ms = 60 Hz
-    static constexpr uInt64 MAX_FLUSH_WAIT   = 200'000;  // 200.0 ms = 5 Hz
-    static constexpr uInt64 RESET_THRESHOLD  = 400'000;  // 400.0 ms = 2.5 Hz
-
     // Using-declaration
     using clock = std::chrono::steady_clock;
     using FChar_iterator = FVTerm::FTermRegion::FCharVec::iterator;
@@ -269,12 +295,18 @@ class FTermOutput final : public FOutput
     void restoreColorPalette() override;
     void init_characterLengths();
     void init_combined_character();
+    void init_lineCostModel();
     auto canClearToEOL (uInt, uInt) const -> bool;
     auto canClearLeadingWS (uInt&, uInt) const -> bool;
     auto canClearTrailingWS (uInt&, uInt) const -> bool;
     auto skipUnchangedCharacters (uInt&, uInt, uInt, FChar_iterator) -> bool;
     void printRange (uInt, uInt, uInt);
+    void printSpans (uInt, uInt, uInt);
+    auto canEncodeRange (uInt, uInt, uInt) -> bool;
+    auto printEncodedRange (uInt, uInt, uInt) -> bool;
     void replaceNonPrintableFullwidth (uInt, uInt, FChar&) const noexcept;
+    auto printCharacterRun (uInt&, uInt, uInt, const FChar_iterator&) -> bool;
+    auto countCharacterRun (uInt, uInt, uInt, const FChar_iterator&) const -> uInt;
     void printCharacter (uInt&, uInt, bool, const FChar_iterator&);
     void printFullWidthCharacter (uInt&, uInt, const FChar_iterator&);
     void printFullWidthPaddingCharacter (uInt&, uInt, const FChar_iterator&);
@@ -287,19 +319,29 @@ class FTermOutput final : public FOutput
     auto canUseEraseCharacters (const FChar&, uInt) const noexcept -> bool;
     auto canUseCharacterRepetitions (const FChar&, uInt) const noexcept -> bool;
     auto getRepetitionType (const FChar&, uInt) const noexcept -> Repetition;
+    auto getRepetitionCapability (const FChar&) const noexcept -> Repetition;
+    auto getCharacterLength (const FChar&) const -> uInt;
     auto isFullWidthChar (const FChar&) const noexcept -> bool;
     auto isFullWidthPaddingChar (const FChar&) const noexcept -> bool;
     void cursorWrap() const noexcept;
     void adjustCursorPosition (FPoint&) const noexcept;
     auto updateTerminalLine (uInt) -> bool;
+    auto updateTerminalLines (std::size_t) -> int;
     auto updateTerminalCursor() -> bool;
-    void flushTimeAdjustment() noexcept;
+    auto getOutputQueueSize() const -> std::size_t;
+    void printOutputBuffer();
+    auto writeOutputBuffer() -> bool;
+    void startOutputWriter();
+    void stopOutputWriter();
+    void prepareTerminalRepaint();
     void markAsPrinted (uInt, uInt) const noexcept;
     void markAsPrinted (uInt, uInt, uInt) const noexcept;
     void newFontChanges (FChar&) const;
     void charsetChanges (FChar&) const;
     void appendCharacter (const FChar_iterator&);
     void appendCharacter_n (const FChar_iterator&, uInt);
+    void appendRepetition (const FChar_iterator&, uInt, Repetition);
+    void appendEraseCharacters (const FChar_iterator&, uInt);
     void appendChar (FChar&);
     void appendAttributes (FChar&);
     void appendLowerRight (const FChar_iterator&);
@@ -309,6 +351,7 @@ class FTermOutput final : public FOutput
     void appendOutputBuffer (const FTermControl&);
     void appendOutputBuffer (wchar_t);
     void appendOutputBuffer (const UniChar&);
+    void appendOutputBuffer (const wchar_t*, const wchar_t*);
     void appendOutputBuffer (FOutputBuffer::OutputType, const char*, uInt32);
 
     // Data members
@@ -317,18 +360,26 @@ class FTermOutput final : public FOutput
     static FTermData*              fterm_data;
     std::shared_ptr<FOutputBuffer> output_buffer{};
     std::shared_ptr<FPoint>        term_pos{};  // terminal cursor position
+    std::shared_ptr<FTermWriter>   output_writer{};
     FChar                          term_attribute{};
+    FLineEncoder                   line_encoder{};
+    FLineEncoder::CostModel        line_cost_model{};
+    FPoint                         line_encoder_origin{};
+    FBandwidthBudget               bandwidth_budget{};
+    FFlushTiming                   flush_timing{};
+    std::vector<wchar_t>           run_chars{};
     bool                           cursor_hideable{false};
     bool                           combined_char_support{false};
+    bool                           repaint_terminal{false};
+    bool                           sync_output{false};
+    bool                           sync_frame{false};
     uInt                           erase_char_length{};
     uInt                           repeat_char_length{};
     uInt                           clr_bol_length{};
     uInt                           clr_eol_length{};
     uInt                           cursor_address_length{};
+    uInt                           sweep_row{0};  // First deferred row
     uInt64                         time_last_flush_us{};
-    uInt64                         flush_wait{MIN_FLUSH_WAIT};
-    uInt64                         flush_average{MIN_FLUSH_WAIT};
-    uInt64                         flush_median{MIN_FLUSH_WAIT};
 };
 
 // FTermOutput inline functions
@@ -0,0 +1,429 @@
+/***********************************************************************
+* ftermwriter.cpp - Writes the terminal output in a separate thread    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+#include <utility>
+
+#include "final/output/tty/ftermwriter.h"
+#include "final/util/fsystem.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+void writeToStdout (const char* data, std::size_t length)
+{
+  // Writes directly to the file descriptor without the stdio buffer.
+  // The stdout stream lock is therefore never held during a slow
+  // terminal write.
+
+  static const auto& fsys = FSystem::getInstance();
+
+  while ( length > 0 )
+  {
+    const auto bytes = fsys->write(STDOUT_FILENO, data, length);
+
+    if ( bytes > 0 )
+    {
+      data += bytes;
+      length -= std::size_t(bytes);
+      continue;
+    }
+
+    if ( bytes < 0 && errno == EINTR )
+      continue;
+
+    if ( bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+    {
+      struct pollfd fds{STDOUT_FILENO, POLLOUT, 0};
+      ::poll (&fds, 1, -1);  // Wait until the terminal accepts data
+      continue;
+    }
+
+    return;  // Write error
+  }
+}
+
+//----------------------------------------------------------------------
+auto tryWriteToStdout (const char* data, std::size_t length) -> std::size_t
+{
+  // Writes as much data as the terminal accepts without blocking and
+  // returns the number of bytes written. O_NONBLOCK is only set during
+  // the write, because stdin and the stdio stream usually share the
+  // file description with stdout.
+
+  struct pollfd fds{STDOUT_FILENO, POLLOUT, 0};
+
+  if ( ::poll(&fds, 1, 0) < 1 )
+    return 0;  // The terminal does not accept any data at the moment
+
+  if ( (fds.revents & POLLOUT) == 0 )
+    return length;  // Hangup or error: the data can no longer be written
+
+  static const auto& fsys = FSystem::getInstance();
+  const int flags = ::fcntl(STDOUT_FILENO, F_GETFL);
+  const bool set_flag = flags != -1 && (flags & O_NONBLOCK) == 0;
+
+  if ( set_flag )
+    ::fcntl(STDOUT_FILENO, F_SETFL, flags | O_NONBLOCK);
+
+  std::size_t written{0};
+
+  while ( written < length )
+  {
+    const auto bytes = fsys->write(STDOUT_FILENO, data + written, length - written);
+
+    if ( bytes > 0 )
+    {
+      written += std::size_t(bytes);
+      continue;
+    }
+
+    if ( bytes < 0 && errno == EINTR )
+      continue;
+
+    if ( bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK )
+      written = length;  // Write error
+
+    break;
+  }
+
+  if ( set_flag )
+    ::fcntl(STDOUT_FILENO, F_SETFL, flags);
+
+  return written;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FTermWriter
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FTermWriter::DEFAULT_SUPERSEDE_SIZE;
+
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTermWriter::FTermWriter()  // constructor
+  : write_function{&internal::writeToStdout}
+  , try_write_function{&internal::tryWriteToStdout}
+{ }
+
+//----------------------------------------------------------------------
+FTermWriter::FTermWriter (FWriteFunction function)  // constructor
+  : write_function{std::move(function)}
+  , try_write_function{ [this] (const char* data, std::size_t length)
+                        {
+                          write_function (data, length);
+                          return length;
+                        } }
+{ }
+
+//----------------------------------------------------------------------
+FTermWriter::FTermWriter ( FWriteFunction function
+                         , FTryWriteFunction try_function )  // constructor
+  : write_function{std::move(function)}
+  , try_write_function{std::move(try_function)}
+{ }
+
+//----------------------------------------------------------------------
+FTermWriter::~FTermWriter()  // destructor
+{
+  stop();
+}
+
+
+// public methods of FTermWriter
+//----------------------------------------------------------------------
+void FTermWriter::setNonBlocking (bool enable)
+{
+  // In non-blocking mode, the writer queues the data that the terminal
+  // does not accept immediately. resume() continues the output.
+
+  if ( non_blocking == enable )
+    return;
+
+  if ( ! enable )
+  {
+    if ( in_frame )
+      commitFrame();
+
+    waitUntilWritten();  // Writes the queue in blocking mode
+  }
+
+  non_blocking = enable;
+}
+
+//----------------------------------------------------------------------
+auto FTermWriter::start() -> bool
+{
+  // Starts the writer thread. Returns false if no thread could be
+  // created, so that the output remains synchronous.
+
+  if ( running )
+    return true;
+
+  std::fflush(stdout);  // Write out data that is still in the stream
+
+  try
+  {
+    writer = std::thread(&FTermWriter::writerLoop, this);
+  }
+  catch (const std::system_error&)
+  {
+    return false;
+  }
+
+  running = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermWriter::stop()
+{
+  // Writes all pending data and then terminates the writer thread
+
+  unsetNonBlocking();
+
+  if ( ! running )
+    return;
+
+  if ( in_frame )
+    commitFrame();
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    stop_request = true;
+  }
+
+  write_condition.notify_one();
+  writer.join();
+  running = false;
+  stop_request = false;
+}
+
+//----------------------------------------------------------------------
+void FTermWriter::write (const char* data, std::size_t length)
+{
+  // Frame data is collected without locking until commitFrame().
+  // Data outside a frame is passed on immediately.
+
+  if ( in_frame )
+  {
+    frame.append(data, length);
+    return;
+  }
+
+  if ( non_blocking && ! running )
+  {
+    queued.append(data, length);
+    retained.append(data, length);  // Never superseded
+    resume();
+    return;
+  }
+
+  if ( ! running )
+  {
+    write_function (data, length);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    pending.append(data, length);
+    retained.append(data, length);  // Never superseded
+  }
+
+  write_condition.notify_one();
+}
+
+//----------------------------------------------------------------------
+auto FTermWriter::commitFrame() -> bool
+{
+  // Writes the frame collected since beginFrame()
+
+  in_frame = false;
+  const auto accepted = writeFrame(frame.data(), frame.size());
+  frame.clear();
+  return accepted;
+}
+
+//----------------------------------------------------------------------
+auto FTermWriter::writeFrame (const char* data, std::size_t length) -> bool
+{
+  // Without a thread, the frame is written with a single write call.
+  // Otherwise, it is handed over to the writer thread. If the writer
+  // is still busy, the frame is merged with the frames that are
+  // waiting. Once the waiting data exceeds the supersede size, these
+  // stale frames are discarded together with the new frame. The
+  // return value false then requests a complete repaint.
+
+  if ( length == 0 )
+    return true;
+
+  if ( non_blocking && ! running )
+    return queueFrame(data, length);
+
+  if ( ! running )
+  {
+    std::fflush(stdout);  // Keeps the order with buffered stream output
+    write_function (data, length);
+    return true;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+
+    if ( busy && pending.size() > retained.size()
+      && pending.size() + length > supersede_size )
+    {
+      pending = retained;
+      superseded_count++;
+      return false;
+    }
+
+    pending.append(data, length);
+  }
+
+  write_condition.notify_one();
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermWriter::resume() -> bool
+{
+  // Continues a partial write in non-blocking mode.
+  // Returns true when the queue is completely written.
+
+  if ( ! hasPendingOutput() )
+    return true;
+
+  if ( queue_offset == 0 )
+    std::fflush(stdout);  // Keeps the order with buffered stream output
+
+  const auto written = try_write_function ( queued.data() + queue_offset
+                                          , getPendingSize() );
+
+  if ( written > 0 && queue_offset + written > started_size )
+  {
+    // The terminal has received the beginning of waiting frames,
+    // which must now be written completely
+    started_size = queued.size();
+    retained.clear();
+  }
+
+  queue_offset += written;
+
+  if ( queue_offset < queued.size() )
+    return false;
+
+  queued.clear();
+  retained.clear();
+  queue_offset = 0;
+  started_size = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermWriter::waitUntilWritten()
+{
+  if ( hasPendingOutput() )
+  {
+    write_function (queued.data() + queue_offset, getPendingSize());
+    queued.clear();
+    retained.clear();
+    queue_offset = 0;
+    started_size = 0;
+  }
+
+  if ( ! running )
+    return;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  idle_condition.wait (lock, [this] () { return ! busy && pending.empty(); });
+}
+
+
+// private methods of FTermWriter
+//----------------------------------------------------------------------
+auto FTermWriter::queueFrame (const char* data, std::size_t length) -> bool
+{
+  // Appends the frame to the non-blocking output queue. Frames whose
+  // output has not yet begun are merged with the new frame. Once the
+  // unwritten data exceeds the supersede size, these stale frames are
+  // discarded together with the new frame. The return value false
+  // then requests a complete repaint.
+
+  if ( queued.size() - started_size > retained.size()
+    && getPendingSize() + length > supersede_size )
+  {
+    queued.resize(started_size);
+    queued += retained;
+    superseded_count++;
+    return false;
+  }
+
+  queued.append(data, length);
+  resume();
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermWriter::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while ( true )
+  {
+    write_condition.wait ( lock
+                         , [this] ()
+                           {
+                             return stop_request || ! pending.empty();
+                           } );
+
+    if ( pending.empty() )
+      return;  // Stop request without pending data
+
+    std::swap (pending, writing);
+    retained.clear();
+    busy = true;
+    lock.unlock();
+    write_function (writing.data(), writing.size());
+    writing.clear();
+    lock.lock();
+    busy = false;
+    idle_condition.notify_all();
+  }
+}
+
+}  // namespace finalcut
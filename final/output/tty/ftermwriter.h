@@ -0,0 +1,174 @@
+/***********************************************************************
+* ftermwriter.h - Writes the terminal output in a separate thread      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermWriter ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FTERMWRITER_H
+#define FTERMWRITER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermWriter
+//----------------------------------------------------------------------
+
+class FTermWriter final
+{
+  public:
+    // Using-declaration
+    using FWriteFunction = std::function<void(const char*, std::size_t)>;
+    using FTryWriteFunction = std::function<std::size_t(const char*, std::size_t)>;
+
+    // Constant
+    static constexpr std::size_t DEFAULT_SUPERSEDE_SIZE = 262'144;  // 256 KB
+
+    // Constructors
+    FTermWriter();
+    explicit FTermWriter (FWriteFunction);
+    FTermWriter (FWriteFunction, FTryWriteFunction);
+
+    // Disable copy constructor
+    FTermWriter (const FTermWriter&) = delete;
+
+    // Disable move constructor
+    FTermWriter (FTermWriter&&) noexcept = delete;
+
+    // Destructor
+    ~FTermWriter();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FTermWriter&) -> FTermWriter& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (FTermWriter&&) noexcept -> FTermWriter& = delete;
+
+    // Accessors
+    auto getSupersedeSize() const noexcept -> std::size_t;
+    auto getSupersededCount() const noexcept -> std::size_t;
+    auto getPendingSize() const noexcept -> std::size_t;
+
+    // Mutators
+    void setSupersedeSize (std::size_t) noexcept;
+    void setNonBlocking (bool = true);
+    void unsetNonBlocking();
+
+    // Inquiries
+    auto isRunning() const noexcept -> bool;
+    auto isNonBlocking() const noexcept -> bool;
+    auto hasPendingOutput() const noexcept -> bool;
+
+    // Methods
+    auto start() -> bool;
+    void stop();
+    void write (const char*, std::size_t);
+    void beginFrame() noexcept;
+    auto commitFrame() -> bool;
+    auto writeFrame (const char*, std::size_t) -> bool;
+    auto resume() -> bool;
+    void waitUntilWritten();
+
+  private:
+    // Methods
+    auto queueFrame (const char*, std::size_t) -> bool;
+    void writerLoop();
+
+    // Data members
+    FWriteFunction           write_function{};
+    FTryWriteFunction        try_write_function{};
+    std::thread              writer{};
+    std::mutex               mutex{};
+    std::condition_variable  write_condition{};
+    std::condition_variable  idle_condition{};
+    std::string              frame{};     // Frame under construction
+    std::string              pending{};   // Committed, not yet written
+    std::string              retained{};  // Pending data outside frames
+    std::string              writing{};   // Data in the write function
+    std::string              queued{};    // Non-blocking output queue
+    std::size_t              queue_offset{0};   // Bytes already written
+    std::size_t              started_size{0};   // Queue part in progress
+    std::size_t              supersede_size{DEFAULT_SUPERSEDE_SIZE};
+    std::size_t              superseded_count{0};
+    bool                     running{false};
+    bool                     in_frame{false};
+    bool                     busy{false};
+    bool                     stop_request{false};
+    bool                     non_blocking{false};
+};
+
+// FTermWriter inline functions
+//----------------------------------------------------------------------
+inline auto FTermWriter::getSupersedeSize() const noexcept -> std::size_t
+{ return supersede_size; }
+
+//----------------------------------------------------------------------
+inline auto FTermWriter::getSupersededCount() const noexcept -> std::size_t
+{ return superseded_count; }
+
+//----------------------------------------------------------------------
+inline auto FTermWriter::getPendingSize() const noexcept -> std::size_t
+{ return queued.size() - queue_offset; }
+
+//----------------------------------------------------------------------
+inline void FTermWriter::setSupersedeSize (std::size_t size) noexcept
+{ supersede_size = size; }
+
+//----------------------------------------------------------------------
+inline void FTermWriter::unsetNonBlocking()
+{ setNonBlocking(false); }
+
+//----------------------------------------------------------------------
+inline auto FTermWriter::isRunning() const noexcept -> bool
+{ return running; }
+
+//----------------------------------------------------------------------
+inline auto FTermWriter::isNonBlocking() const noexcept -> bool
+{ return non_blocking; }
+
+//----------------------------------------------------------------------
+inline auto FTermWriter::hasPendingOutput() const noexcept -> bool
+{ return queue_offset < queued.size(); }
+
+//----------------------------------------------------------------------
+inline void FTermWriter::beginFrame() noexcept
+{ in_frame = true; }
+
+}  // namespace finalcut
+
+#endif  // FTERMWRITER_H
@@ -0,0 +1,202 @@
+/***********************************************************************
+* futf8encoder.cpp - Bulk UTF-32 to UTF-8 encoder                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cwchar>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #define FUTF8ENCODER_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+#include "final/output/tty/futf8encoder.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+using EncodeFunc = std::size_t (*)(const wchar_t*, const wchar_t*, char*);
+
+struct EncoderKernel
+{
+  FUTF8Encoder::Kernel kernel;
+  EncodeFunc           encode;
+};
+
+//----------------------------------------------------------------------
+inline auto encodeCharacter (wchar_t ch, char* dest) -> std::size_t
+{
+  // Writes the UTF-8 bytes of one character and returns the length
+
+  std::array<char, 4> buffer{};
+  const auto length = UTF8::encode(ch, buffer);
+  std::copy_n (buffer.cbegin(), length, dest);
+  return length;
+}
+
+//----------------------------------------------------------------------
+auto encodeScalar ( const wchar_t* first, const wchar_t* last
+                  , char* dest ) -> std::size_t
+{
+  auto* out = dest;
+
+  while ( first < last )
+  {
+    // ASCII fast path
+    while ( first < last && uInt32(*first) < 0x80 )
+    {
+      *out = char(*first);
+      ++out;
+      ++first;
+    }
+
+    if ( first < last )
+    {
+      out += encodeCharacter (*first, out);
+      ++first;
+    }
+  }
+
+  return std::size_t(out - dest);
+}
+
+#if defined(FUTF8ENCODER_X86_SIMD) && WCHAR_MAX > 0xffff
+//----------------------------------------------------------------------
+auto encodeSSE2 ( const wchar_t* first, const wchar_t* last
+                , char* dest ) -> std::size_t
+{
+  // Narrows eight 32-bit ASCII characters per step to bytes
+
+  const auto non_ascii_mask = _mm_set1_epi32(~0x7f);
+  const auto zero = _mm_setzero_si128();
+  auto* out = dest;
+
+  while ( first < last )
+  {
+    while ( last - first >= 8 )
+    {
+      const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + 4));
+      const auto high_bits = _mm_and_si128(_mm_or_si128(lo, hi), non_ascii_mask);
+
+      if ( _mm_movemask_epi8(_mm_cmpeq_epi32(high_bits, zero)) != 0xffff )
+        break;  // At least one non-ASCII character
+
+      const auto words = _mm_packs_epi32(lo, hi);
+      _mm_storel_epi64 (reinterpret_cast<__m128i*>(out), _mm_packus_epi16(words, words));
+      out += 8;
+      first += 8;
+    }
+
+    // Scalar step up to the next non-ASCII character
+    const auto* stop = ( last - first >= 8 ) ? first + 8 : last;
+
+    while ( first < stop )
+    {
+      out += encodeCharacter (*first, out);
+      ++first;
+    }
+  }
+
+  return std::size_t(out - dest);
+}
+#endif  // defined(FUTF8ENCODER_X86_SIMD) && WCHAR_MAX > 0xffff
+
+//----------------------------------------------------------------------
+auto isKernelSupported (FUTF8Encoder::Kernel kernel) noexcept -> bool
+{
+  if ( kernel == FUTF8Encoder::Kernel::Scalar )
+    return true;
+
+#if defined(FUTF8ENCODER_X86_SIMD) && WCHAR_MAX > 0xffff
+  return true;  // SSE2 is part of the x86-64 base instruction set
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------
+auto makeEncoderKernel (FUTF8Encoder::Kernel kernel) noexcept -> EncoderKernel
+{
+  // Selects the best supported kernel up to the requested one
+
+  while ( ! isKernelSupported(kernel) )
+    kernel = FUTF8Encoder::Kernel(uInt8(kernel) - 1);
+
+#if defined(FUTF8ENCODER_X86_SIMD) && WCHAR_MAX > 0xffff
+  if ( kernel == FUTF8Encoder::Kernel::SSE2 )
+    return { kernel, &encodeSSE2 };
+#endif
+
+  return { kernel, &encodeScalar };
+}
+
+//----------------------------------------------------------------------
+auto getEncoderKernel() noexcept -> EncoderKernel&
+{
+  static auto encoder_kernel = makeEncoderKernel(FUTF8Encoder::Kernel::SSE2);
+  return encoder_kernel;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FUTF8Encoder
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FUTF8Encoder::MAX_CHAR_LENGTH;
+
+
+// public methods of FUTF8Encoder
+//----------------------------------------------------------------------
+auto FUTF8Encoder::getKernel() noexcept -> Kernel
+{
+  return internal::getEncoderKernel().kernel;
+}
+
+//----------------------------------------------------------------------
+void FUTF8Encoder::setKernel (Kernel kernel) noexcept
+{
+  internal::getEncoderKernel() = internal::makeEncoderKernel(kernel);
+}
+
+//----------------------------------------------------------------------
+auto FUTF8Encoder::encode ( const wchar_t* first, const wchar_t* last
+                          , char* dest ) noexcept -> std::size_t
+{
+  // Writes the UTF-8 bytes of the characters [first, last) to dest
+  // and returns the number of bytes. dest must have space for
+  // MAX_CHAR_LENGTH bytes per character.
+
+  if ( first >= last )
+    return 0;
+
+  return internal::getEncoderKernel().encode(first, last, dest);
+}
+
+}  // namespace finalcut
@@ -0,0 +1,76 @@
+/***********************************************************************
+* futf8encoder.h - Bulk UTF-32 to UTF-8 encoder                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FUTF8Encoder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FUTF8ENCODER_H
+#define FUTF8ENCODER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FUTF8Encoder
+//----------------------------------------------------------------------
+
+class FUTF8Encoder final
+{
+  public:
+    // Enumeration
+    enum class Kernel : uInt8
+    {
+      Scalar,  // One character per step
+      SSE2     // Eight ASCII characters per step
+    };
+
+    // Constant
+    static constexpr std::size_t MAX_CHAR_LENGTH = 4;  // Bytes per character
+
+    // Accessor
+    static auto getKernel() noexcept -> Kernel;
+
+    // Mutator
+    static void setKernel (Kernel) noexcept;
+
+    // Method
+    static auto encode ( const wchar_t*, const wchar_t*
+                       , char* ) noexcept -> std::size_t;
+};
+
+}  // namespace finalcut
+
+#endif  // FUTF8ENCODER_H
@@ -404,14 +404,56 @@ class CharRingBuffer final : public FRingBuffer<char, Capacity>
     using FRingBuffer<char, Capacity>::buffer;
     using FRingBuffer<char, Capacity>::tail;
     using FRingBuffer<char, Capacity>::head;
+    using FRingBuffer<char, Capacity>::last_index;
+    using FRingBuffer<char, Capacity>::elements;
 
-    // Accessor
+    // Accessors
     inline auto getClassName() const -> FString override
     {
       return "CharRingBuffer";
     }
 
-    // Method
+    inline auto getWritePosition() noexcept -> char*
+    {
+#if defined(__clang__)
+  #pragma clang diagnostic push
+  #if __has_warning("-Wunsafe-buffer-usage")
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+  #endif
+#endif
+      return buffer.data() + tail;
+#if defined(__clang__)
+  #pragma clang diagnostic pop
+#endif
+    }
+
+    inline auto getContiguousFreeSpace() const noexcept -> std::size_t
+    {
+      // Number of characters that can be written
+      // to getWritePosition() without wrap-around
+
+      if ( elements == Capacity )
+        return 0;
+
+      return ( tail < head ) ? head - tail : Capacity - tail;
+    }
+
+    // Methods
+    inline void commit (std::size_t length) noexcept
+    {
+      // Appends characters that were written directly
+      // to getWritePosition()
+
+      length = std::min(length, getContiguousFreeSpace());
+
+      if ( length == 0 )
+        return;
+
+      last_index = tail + length - 1;
+      tail = FRingBuffer<char, Capacity>::template ring_index<>::add(tail, length);
+      elements += length;
+    }
+
     auto strncmp_front ( const char* string
                        , std::size_t length ) const noexcept -> bool
     {
@@ -71,6 +71,7 @@ class FSystem
     virtual void outPortByte (uChar, uShort) = 0;
     virtual auto isTTY (int) const -> int = 0;
     virtual auto ioctl (int, uLong, ...) -> int = 0;
+    virtual auto fcntl (int, int, ...) -> int = 0;
     virtual auto pipe (PipeData&) -> int = 0;
     virtual auto open (const char*, int, ...) -> int = 0;
     virtual auto close (int) -> int = 0;
@@ -79,6 +80,8 @@ class FSystem
     virtual auto fputs (const char*, FILE*) -> int = 0;
     virtual auto putchar (int) -> int = 0;
     virtual auto putstring (const char* str, std::size_t len) noexcept -> int = 0;
+    virtual auto read (int, void*, std::size_t) -> ssize_t = 0;
+    virtual auto write (int, const void*, std::size_t) -> ssize_t = 0;
     virtual auto sigaction ( int, const struct sigaction*
                            , struct sigaction* ) -> int = 0;
     virtual auto timer_create ( clockid_t, struct sigevent*
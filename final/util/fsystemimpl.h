@@ -123,6 +123,31 @@ class FSystemImpl : public FSystem
       return ret;
     }
 
+    inline auto fcntl (int file_descriptor, int cmd, ...) noexcept -> int override
+    {
+      // Fetch the third argument only for commands that take one
+      if ( cmd == F_GETFD || cmd == F_GETFL || cmd == F_GETOWN )
+        return ::fcntl (file_descriptor, cmd);
+
+      va_list args{};
+      va_start (args, cmd);
+      int ret{};
+
+      if ( cmd == F_GETLK || cmd == F_SETLK || cmd == F_SETLKW )
+      {
+        auto lock = va_arg (args, struct flock*);
+        ret = ::fcntl (file_descriptor, cmd, lock);
+      }
+      else
+      {
+        auto arg = va_arg (args, int);
+        ret = ::fcntl (file_descriptor, cmd, arg);
+      }
+
+      va_end (args);
+      return ret;
+    }
+
     inline auto pipe (PipeData& pipe) noexcept -> int override
     {
       return ::pipe(pipe.getArrayData());
@@ -172,6 +197,16 @@ class FSystemImpl : public FSystem
       return int(std::fwrite(str, 1, len, stdout));
     }
 
+    inline auto read (int fd, void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      return ::read(fd, buf, count);
+    }
+
+    inline auto write (int fd, const void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      return ::write(fd, buf, count);
+    }
+
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction* ) noexcept -> int override;
     auto timer_create ( clockid_t, struct sigevent*
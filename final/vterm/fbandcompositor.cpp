@@ -0,0 +1,217 @@
+/***********************************************************************
+* fbandcompositor.cpp - Worker pool for composing horizontal bands     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <system_error>
+
+#include "final/vterm/fbandcompositor.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FBandCompositor
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr std::size_t FBandCompositor::MAX_THREADS;
+constexpr std::size_t FBandCompositor::DEFAULT_MIN_BAND_SIZE;
+#if defined(UNIT_TEST)
+bool FBandCompositor::simulated_system_error{false};
+#endif
+
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FBandCompositor::~FBandCompositor()  // destructor
+{
+  stopWorkers();
+}
+
+
+// public methods of FBandCompositor
+//----------------------------------------------------------------------
+auto FBandCompositor::getBandCount (int rows, int columns) const noexcept -> std::size_t
+{
+  // Each band must contain at least min_band_size cells, otherwise
+  // waking up a worker costs more than it saves
+
+  if ( workers.empty() || rows < 2 || columns < 1 )
+    return 1;
+
+  const auto cells = std::size_t(rows) * std::size_t(columns);
+  const auto count = std::min ({ getThreadCount()
+                               , cells / min_band_size
+                               , std::size_t(rows) });
+  return std::max(count, std::size_t(1));
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::setThreadCount (std::size_t count)
+{
+  // A thread count of 0 selects the number of hardware threads
+
+  if ( count == 0 )
+    count = std::size_t(std::thread::hardware_concurrency());
+
+  count = std::max(std::min(count, MAX_THREADS), std::size_t(1));
+
+  if ( count == getThreadCount() )
+    return;
+
+  stopWorkers();
+  startWorkers (count - 1);  // The calling thread composes the first band
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::run ( int begin, int end, int columns
+                          , const FBandFunction& function )
+{
+  // Splits the rows from begin to end - 1 into bands of equal height.
+  // The bands do not overlap, so the result is the same as with a
+  // single call of function (begin, end). A std::system_error is
+  // only thrown before the first band is started.
+
+  if ( end <= begin )
+    return;
+
+  const auto count = getBandCount(end - begin, columns);
+
+  if ( count < 2 )
+  {
+    function (begin, end);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+
+#if defined(UNIT_TEST)
+    if ( simulated_system_error )
+      throw std::system_error (std::make_error_code(std::errc::resource_deadlock_would_occur));
+#endif
+
+    band_function = &function;
+    band_count = count;
+    pending_bands = count - 1;
+    y_begin = begin;
+    y_end = end;
+    ++generation;
+  }
+
+  start_condition.notify_all();
+  runBand (0);
+  waitForBands();
+}
+
+
+// private methods of FBandCompositor
+//----------------------------------------------------------------------
+void FBandCompositor::startWorkers (std::size_t count)
+{
+  workers.reserve(count);
+
+  for (std::size_t index{0}; index < count; index++)
+  {
+    try
+    {
+      workers.emplace_back (&FBandCompositor::workerLoop, this, index, generation);
+    }
+    catch (const std::system_error&)
+    {
+      break;  // Continue with the already started workers
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::stopWorkers()
+{
+  if ( workers.empty() )
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    stop = true;
+  }
+
+  start_condition.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+
+  workers.clear();
+  stop = false;
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::workerLoop (std::size_t index, std::size_t seen)
+{
+  const auto band = index + 1;
+
+  while ( true )
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    start_condition.wait ( lock
+                         , [this, seen] ()
+                           {
+                             return stop || generation != seen;
+                           } );
+
+    if ( stop )
+      return;
+
+    seen = generation;
+
+    if ( band >= band_count )
+      continue;  // This worker is not needed for the current run
+
+    lock.unlock();
+    runBand (band);
+    lock.lock();
+
+    if ( --pending_bands == 0 )
+      done_condition.notify_one();
+  }
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::waitForBands() noexcept
+{
+  // The workers use the band function of the caller, so run()
+  // must not return before all bands are finished
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done_condition.wait (lock, [this] () { return pending_bands == 0; });
+  band_function = nullptr;
+}
+
+//----------------------------------------------------------------------
+void FBandCompositor::runBand (std::size_t band) const
+{
+  const auto rows = std::size_t(y_end - y_begin);
+  const auto first = y_begin + int(rows * band / band_count);
+  const auto last = y_begin + int(rows * (band + 1) / band_count);
+  (*band_function) (first, last);
+}
+
+}  // namespace finalcut
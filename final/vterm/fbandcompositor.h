@@ -0,0 +1,149 @@
+/***********************************************************************
+* fbandcompositor.h - Worker pool for composing horizontal bands       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FBandCompositor ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FBANDCOMPOSITOR_H
+#define FBANDCOMPOSITOR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FBandCompositor
+//----------------------------------------------------------------------
+
+class FBandCompositor final
+{
+  public:
+    // Using-declaration
+    using FBandFunction = std::function<void(int, int)>;
+
+    // Constants
+    static constexpr std::size_t MAX_THREADS = 16;
+    static constexpr std::size_t DEFAULT_MIN_BAND_SIZE = 8192;  // Cells
+
+    // Constructor
+    FBandCompositor() = default;
+
+    // Disable copy constructor
+    FBandCompositor (const FBandCompositor&) = delete;
+
+    // Disable move constructor
+    FBandCompositor (FBandCompositor&&) noexcept = delete;
+
+    // Destructor
+    ~FBandCompositor();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FBandCompositor&) -> FBandCompositor& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (FBandCompositor&&) noexcept -> FBandCompositor& = delete;
+
+    // Accessors
+    auto getThreadCount() const noexcept -> std::size_t;
+    auto getMinimumBandSize() const noexcept -> std::size_t;
+    auto getBandCount (int, int) const noexcept -> std::size_t;
+
+    // Mutators
+    void setThreadCount (std::size_t);
+    void setMinimumBandSize (std::size_t) noexcept;
+
+    // Inquiry
+    auto isParallel() const noexcept -> bool;
+
+    // Methods
+    void run (int, int, int, const FBandFunction&);
+#if defined(UNIT_TEST)
+    static void simulateSystemError (bool = true) noexcept;
+#endif
+
+  private:
+    // Methods
+    void startWorkers (std::size_t);
+    void stopWorkers();
+    void workerLoop (std::size_t, std::size_t);
+    void runBand (std::size_t) const;
+    void waitForBands() noexcept;
+
+    // Data members
+    std::vector<std::thread> workers{};
+    std::mutex               mutex{};
+    std::condition_variable  start_condition{};
+    std::condition_variable  done_condition{};
+    const FBandFunction*     band_function{nullptr};
+    std::size_t              band_count{0};
+    std::size_t              pending_bands{0};
+    std::size_t              generation{0};
+    std::size_t              min_band_size{DEFAULT_MIN_BAND_SIZE};
+    int                      y_begin{0};
+    int                      y_end{0};
+    bool                     stop{false};
+#if defined(UNIT_TEST)
+    static bool              simulated_system_error;
+#endif
+};
+
+// FBandCompositor inline functions
+//----------------------------------------------------------------------
+inline auto FBandCompositor::getThreadCount() const noexcept -> std::size_t
+{ return workers.size() + 1; }
+
+//----------------------------------------------------------------------
+inline auto FBandCompositor::getMinimumBandSize() const noexcept -> std::size_t
+{ return min_band_size; }
+
+//----------------------------------------------------------------------
+inline void FBandCompositor::setMinimumBandSize (std::size_t size) noexcept
+{ min_band_size = size == 0 ? 1 : size; }
+
+//----------------------------------------------------------------------
+inline auto FBandCompositor::isParallel() const noexcept -> bool
+{ return ! workers.empty(); }
+
+#if defined(UNIT_TEST)
+//----------------------------------------------------------------------
+inline void FBandCompositor::simulateSystemError (bool enable) noexcept
+{ simulated_system_error = enable; }
+#endif
+
+}  // namespace finalcut
+
+#endif  // FBANDCOMPOSITOR_H
@@ -0,0 +1,257 @@
+/***********************************************************************
+* fcellblender.cpp - Blends transparent cells onto covered cells       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) \
+    && __SIZEOF_WCHAR_T__ == 4
+  #define FCELLBLENDER_X86_SIMD
+  #include <emmintrin.h>
+#endif
+
+#include "final/vterm/fcellblender.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr uInt32 blend_print_reset_mask = \
+    ~(FAttribute::set::no_changes | FAttribute::set::printed);
+constexpr uInt32 blend_color_overlay_reset_mask = \
+    ~( FAttribute::set::color_overlay | FAttribute::set::reverse
+     | FAttribute::set::standout | FAttribute::set::no_changes
+     | FAttribute::set::printed );
+
+constexpr uInt32 blend_transparent_mask = \
+    FAttribute::set::transparent | FAttribute::set::color_overlay
+  | FAttribute::set::inherit_background;
+
+enum class CellClass : uInt8
+{
+  Opaque,       // Source cell
+  Transparent,  // Covered cell
+  Overlay,      // Covered character with the source color
+  Inherit       // Source cell with the covered background
+};
+
+using BlendFunc = void (*)(const FChar*, FChar*, std::size_t);
+
+struct BlendKernelSet
+{
+  FCellBlender::Kernel kernel;
+  BlendFunc            blend;
+};
+
+//----------------------------------------------------------------------
+constexpr auto getCellClass (uInt32 trans_bits) noexcept -> CellClass
+{
+  // The transparent bit has priority over color_overlay,
+  // and color_overlay has priority over inherit_background
+
+  return ( trans_bits & FAttribute::set::transparent ) ? CellClass::Transparent
+       : ( trans_bits & FAttribute::set::color_overlay ) ? CellClass::Overlay
+       : ( trans_bits & FAttribute::set::inherit_background ) ? CellClass::Inherit
+       : CellClass::Opaque;
+}
+
+//----------------------------------------------------------------------
+inline void hideInvisibleCharacter (FChar& cell) noexcept
+{
+  // A color overlay on a block element shows a space character
+
+  const auto ch = uInt32(cell.ch.unicode_data[0]);
+  const auto hide = 0U - uInt32(FCellBlender::isTransparentInvisible(wchar_t(ch)));
+  cell.ch.unicode_data[0] = wchar_t((ch & ~hide) | (uInt32(L' ') & hide));
+}
+
+//----------------------------------------------------------------------
+inline void opaqueRun (const FChar* src, FChar* dst, std::size_t length) noexcept
+{
+  // Short runs are copied inline without a library call
+
+  if ( length > 4 )
+  {
+    std::memcpy (static_cast<void*>(dst), src, length * sizeof(FChar));
+    return;
+  }
+
+  for (std::size_t i{0}; i < length; i++)
+    dst[i] = src[i];
+}
+
+//----------------------------------------------------------------------
+inline void overlayRun (const FChar* src, FChar* dst, std::size_t length) noexcept
+{
+  // Only the color and the attributes of the covered cell change
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    dst[i].color.data = src[i].color.data;
+    dst[i].attr.data = src[i].attr.data & blend_color_overlay_reset_mask;
+    hideInvisibleCharacter (dst[i]);
+  }
+}
+
+//----------------------------------------------------------------------
+inline void inheritRunScalar (const FChar* src, FChar* dst, std::size_t length) noexcept
+{
+  for (std::size_t i{0}; i < length; i++)
+  {
+    const auto bg_bits = dst[i].color.data & 0xffff0000U;
+    std::memcpy (static_cast<void*>(&dst[i]), &src[i], sizeof(FChar));
+    dst[i].color.data = (dst[i].color.data & 0x0000ffffU) | bg_bits;
+    dst[i].attr.data &= blend_print_reset_mask;
+  }
+}
+
+#if defined(FCELLBLENDER_X86_SIMD)
+// The SSE2 kernel expects color and attr in the last 8 bytes of a cell
+static_assert ( sizeof(FChar) == 3 * sizeof(__m128i)
+              , "The cell blender expects a 48-byte FChar" );
+static_assert ( offsetof(FChar, color) == sizeof(FChar) - 2 * sizeof(uInt32)
+             && offsetof(FChar, attr) == sizeof(FChar) - sizeof(uInt32)
+              , "The cell blender expects color and attr at the end of a cell" );
+
+//----------------------------------------------------------------------
+inline void inheritRunSSE2 (const FChar* src, FChar* dst, std::size_t length) noexcept
+{
+  // The 48-byte cell is processed as three 128-bit parts. Only the
+  // last part, with the color and the attributes, needs a mask:
+  // (src & src_mask) | (dst & dst_mask)
+
+  const auto src_mask = _mm_set_epi32 ( int(blend_print_reset_mask), 0x0000ffff, -1, -1 );
+  const auto dst_mask = _mm_set_epi32 ( 0, int(0xffff0000U), 0, 0 );
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    const auto* s = reinterpret_cast<const __m128i*>(&src[i]);
+    auto* d = reinterpret_cast<__m128i*>(&dst[i]);
+    const auto part2 = _mm_or_si128 ( _mm_and_si128(_mm_loadu_si128(s + 2), src_mask)
+                                    , _mm_and_si128(_mm_loadu_si128(d + 2), dst_mask) );
+    _mm_storeu_si128 (d, _mm_loadu_si128(s));
+    _mm_storeu_si128 (d + 1, _mm_loadu_si128(s + 1));
+    _mm_storeu_si128 (d + 2, part2);
+  }
+}
+#endif  // defined(FCELLBLENDER_X86_SIMD)
+
+//----------------------------------------------------------------------
+template <void (*InheritRun)(const FChar*, FChar*, std::size_t)>
+void blendSpan (const FChar* src, FChar* dst, std::size_t length)
+{
+  // Cells with the same transparency bits form a run, which
+  // is then processed without per-character branches
+
+  std::size_t pos{0};
+
+  while ( pos < length )
+  {
+    const auto trans_bits = src[pos].attr.data & blend_transparent_mask;
+    auto end = pos + 1;
+
+    while ( end < length
+         && (src[end].attr.data & blend_transparent_mask) == trans_bits )
+      ++end;
+
+    const auto cell_class = getCellClass(trans_bits);
+    const auto count = end - pos;
+
+    if ( cell_class == CellClass::Opaque )
+      opaqueRun (src + pos, dst + pos, count);
+    else if ( cell_class == CellClass::Overlay )
+      overlayRun (src + pos, dst + pos, count);
+    else if ( cell_class == CellClass::Inherit )
+      InheritRun (src + pos, dst + pos, count);
+
+    // Transparent runs leave the covered cells untouched
+    pos = end;
+  }
+}
+
+//----------------------------------------------------------------------
+auto isBlendKernelSupported (FCellBlender::Kernel kernel) noexcept -> bool
+{
+  if ( kernel == FCellBlender::Kernel::Scalar )
+    return true;
+
+#if defined(FCELLBLENDER_X86_SIMD)
+  return true;  // SSE2 is part of the x86-64 base instruction set
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------
+auto makeBlendKernelSet (FCellBlender::Kernel kernel) noexcept -> BlendKernelSet
+{
+  // Selects the best supported kernel up to the requested one
+
+  while ( ! isBlendKernelSupported(kernel) )
+    kernel = FCellBlender::Kernel(uInt8(kernel) - 1);
+
+#if defined(FCELLBLENDER_X86_SIMD)
+  if ( kernel == FCellBlender::Kernel::SSE2 )
+    return { kernel, &blendSpan<inheritRunSSE2> };
+#endif
+
+  return { kernel, &blendSpan<inheritRunScalar> };
+}
+
+//----------------------------------------------------------------------
+auto getBlendKernelSet() noexcept -> BlendKernelSet&
+{
+  static auto kernel_set = makeBlendKernelSet(FCellBlender::Kernel::SSE2);
+  return kernel_set;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FCellBlender
+//----------------------------------------------------------------------
+
+// public methods of FCellBlender
+//----------------------------------------------------------------------
+auto FCellBlender::getKernel() noexcept -> Kernel
+{
+  return internal::getBlendKernelSet().kernel;
+}
+
+//----------------------------------------------------------------------
+void FCellBlender::setKernel (Kernel kernel) noexcept
+{
+  internal::getBlendKernelSet() = internal::makeBlendKernelSet(kernel);
+}
+
+//----------------------------------------------------------------------
+void FCellBlender::blend (const FChar* src, FChar* dst, std::size_t length) noexcept
+{
+  // Puts length source cells with transparency onto the covered cells
+
+  if ( length > 0 )
+    internal::getBlendKernelSet().blend(src, dst, length);
+}
+
+}  // namespace finalcut
@@ -0,0 +1,93 @@
+/***********************************************************************
+* fcellblender.h - Blends transparent cells onto covered cells         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FCellBlender ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FCELLBLENDER_H
+#define FCELLBLENDER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCellBlender
+//----------------------------------------------------------------------
+
+class FCellBlender final
+{
+  public:
+    // Enumeration
+    enum class Kernel : uInt8
+    {
+      Scalar,  // Portable word-wise selection
+      SSE2     // Three 128-bit selections per cell
+    };
+
+    // Accessor
+    static auto getKernel() noexcept -> Kernel;
+
+    // Mutator
+    static void setKernel (Kernel) noexcept;
+
+    // Inquiry
+    static constexpr auto isTransparentInvisible (wchar_t) noexcept -> bool;
+
+    // Method
+    static void blend (const FChar*, FChar*, std::size_t) noexcept;
+};
+
+// FCellBlender inline functions
+//----------------------------------------------------------------------
+constexpr auto FCellBlender::isTransparentInvisible (wchar_t ch) noexcept -> bool
+{
+  // Block elements that would completely hide the covered character
+
+  constexpr auto first = uInt32(UniChar::UpperHalfBlock);  // U+2580
+  constexpr uInt32 invisible_set = \
+      (1U << (uInt32(UniChar::UpperHalfBlock) - first))
+    | (1U << (uInt32(UniChar::LowerHalfBlock) - first))
+    | (1U << (uInt32(UniChar::FullBlock) - first))
+    | (1U << (uInt32(UniChar::LeftHalfBlock) - first))
+    | (1U << (uInt32(UniChar::RightHalfBlock) - first))
+    | (1U << (uInt32(UniChar::MediumShade) - first));
+  const auto offset = uInt32(ch) - first;
+  return offset < 32 && ((invisible_set >> offset) & 1U) != 0;
+}
+
+}  // namespace finalcut
+
+#endif  // FCELLBLENDER_H
@@ -0,0 +1,182 @@
+/***********************************************************************
+* fscrolldetector.cpp - Finds vertically shifted blocks of lines       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "final/vterm/fscrolldetector.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FScrollDetector
+//----------------------------------------------------------------------
+
+// public methods of FScrollDetector
+//----------------------------------------------------------------------
+auto FScrollDetector::findScrollBlock() -> FScrollBlock
+{
+  // Compares the line hashes of the last and the new frame and
+  // returns the largest block of lines that has been moved vertically.
+  // Like the ncurses hashmap algorithm, lines that occur only once in
+  // both frames serve as anchors, which are then extended to
+  // their neighbor lines.
+
+  if ( old_lines.size() != new_lines.size() || new_lines.size() < 2 )
+    return {};
+
+  matchUniqueLines();
+  growMatches();
+  return findLongestRun();
+}
+
+
+// private methods of FScrollDetector
+//----------------------------------------------------------------------
+void FScrollDetector::matchUniqueLines()
+{
+  shift.assign(new_lines.size(), 0);
+  sortHashes (old_lines, old_sorted);
+  sortHashes (new_lines, new_sorted);
+
+  const auto run_end = [] (auto iter, const auto& end)
+  {
+    const auto hash = iter->first;
+
+    while ( iter != end && iter->first == hash )
+      ++iter;
+
+    return iter;
+  };
+
+  auto old_iter = old_sorted.cbegin();
+  auto new_iter = new_sorted.cbegin();
+  const auto old_end = old_sorted.cend();
+  const auto new_end = new_sorted.cend();
+
+  while ( old_iter != old_end && new_iter != new_end )
+  {
+    if ( old_iter->first < new_iter->first )
+    {
+      old_iter = run_end(old_iter, old_end);
+      continue;
+    }
+
+    if ( new_iter->first < old_iter->first )
+    {
+      new_iter = run_end(new_iter, new_end);
+      continue;
+    }
+
+    const auto old_next = run_end(old_iter, old_end);
+    const auto new_next = run_end(new_iter, new_end);
+
+    // Only lines that are unique in both frames are unambiguous
+    if ( old_next - old_iter == 1 && new_next - new_iter == 1 )
+      shift[std::size_t(new_iter->second)] = old_iter->second - new_iter->second;
+
+    old_iter = old_next;
+    new_iter = new_next;
+  }
+}
+
+//----------------------------------------------------------------------
+void FScrollDetector::growMatches()
+{
+  // Extends the anchors to adjacent lines with the same shift
+  // (e.g. empty lines, which are not unique)
+
+  const auto count = int(shift.size());
+
+  const auto grow = [this, count] (int from, int to)
+  {
+    const auto s = shift[std::size_t(from)];
+    const auto old_line = to + s;
+
+    if ( s == 0 || shift[std::size_t(to)] != 0
+      || old_line < 0 || old_line >= count
+      || new_lines[std::size_t(to)] != old_lines[std::size_t(old_line)] )
+      return;
+
+    shift[std::size_t(to)] = s;
+  };
+
+  for (auto y{0}; y < count - 1; y++)
+    grow (y, y + 1);
+
+  for (auto y{count - 1}; y > 0; y--)
+    grow (y, y - 1);
+}
+
+//----------------------------------------------------------------------
+auto FScrollDetector::findLongestRun() const noexcept -> FScrollBlock
+{
+  FScrollBlock block{};
+  const auto count = int(shift.size());
+  int best_size{0};
+  int y{0};
+
+  while ( y < count )
+  {
+    const auto s = shift[std::size_t(y)];
+    auto end = y + 1;
+
+    while ( end < count && shift[std::size_t(end)] == s )
+      end++;
+
+    const auto size = end - y;
+
+    if ( s != 0
+      && ( size > best_size
+        || (size == best_size && std::abs(s) < std::abs(block.distance)) ) )
+    {
+      // The scrolling region includes the moved and the exposed lines
+      best_size = size;
+      block = ( s > 0 ) ? FScrollBlock{y, end - 1 + s, s}
+                        : FScrollBlock{y + s, end - 1, s};
+    }
+
+    y = end;
+  }
+
+  return block;
+}
+
+//----------------------------------------------------------------------
+void FScrollDetector::sortHashes ( const FHashList& lines
+                                 , FHashIndexList& sorted )
+{
+  sorted.clear();
+  sorted.reserve(lines.size());
+  int index{0};
+
+  for (const auto& hash : lines)
+  {
+    sorted.emplace_back(hash, index);
+    index++;
+  }
+
+  std::sort (sorted.begin(), sorted.end());
+}
+
+}  // namespace finalcut
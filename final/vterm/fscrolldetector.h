@@ -0,0 +1,103 @@
+/***********************************************************************
+* fscrolldetector.h - Finds vertically shifted blocks of lines         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FScrollDetector ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FSCROLLDETECTOR_H
+#define FSCROLLDETECTOR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <utility>
+#include <vector>
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FScrollDetector
+//----------------------------------------------------------------------
+
+class FScrollDetector final
+{
+  public:
+    // Using-declaration
+    using FHashList = std::vector<uInt64>;
+
+    struct FScrollBlock
+    {
+      int top{0};       // First line of the scrolling region
+      int bottom{0};    // Last line of the scrolling region
+      int distance{0};  // > 0: scroll up, < 0: scroll down, 0: no scrolling
+    };
+
+    // Constructor
+    FScrollDetector() = default;
+
+    // Accessors
+    auto getOldLines() noexcept -> FHashList&;
+    auto getNewLines() noexcept -> FHashList&;
+
+    // Method
+    auto findScrollBlock() -> FScrollBlock;
+
+  private:
+    // Using-declaration
+    using FHashIndex = std::pair<uInt64, int>;
+    using FHashIndexList = std::vector<FHashIndex>;
+
+    // Methods
+    void matchUniqueLines();
+    void growMatches();
+    auto findLongestRun() const noexcept -> FScrollBlock;
+    static void sortHashes (const FHashList&, FHashIndexList&);
+
+    // Data members
+    FHashList        old_lines{};   // Line hashes of the last frame
+    FHashList        new_lines{};   // Line hashes of the new frame
+    FHashIndexList   old_sorted{};
+    FHashIndexList   new_sorted{};
+    std::vector<int> shift{};       // Old line number - new line number
+};
+
+// FScrollDetector inline functions
+//----------------------------------------------------------------------
+inline auto FScrollDetector::getOldLines() noexcept -> FHashList&
+{ return old_lines; }
+
+//----------------------------------------------------------------------
+inline auto FScrollDetector::getNewLines() noexcept -> FHashList&
+{ return new_lines; }
+
+}  // namespace finalcut
+
+#endif  // FSCROLLDETECTOR_H
@@ -21,13 +21,14 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <exception>
 #include <numeric>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/fstartoptions.h"
 #include "final/ftypes.h"
 #include "final/output/tty/ftermoutput.h"
 #include "final/util/flog.h"
@@ -35,6 +36,7 @@
 #include "final/util/frect.h"
 #include "final/util/fsize.h"
 #include "final/util/fsystem.h"
+#include "final/vterm/fcellblender.h"
 #include "final/vterm/fcolorpair.h"
 #include "final/vterm/fstyle.h"
 #include "final/vterm/fvterm.h"
@@ -108,28 +110,8 @@ bool                 FVTerm::no_terminal_updates{false};
 bool                 FVTerm::force_terminal_update{false};
 FVTerm::FTermRegion* FVTerm::active_region{nullptr};
 int                  FVTerm::tabstop{8};
-
-using TransparentInvisibleLookupMap = std::unordered_set<wchar_t>;
-
-//----------------------------------------------------------------------
-static auto getTransparentInvisibleLookupMap() -> TransparentInvisibleLookupMap
-{
-  // Encapsulate global unordered_map object
-  static const auto& trans_inv_lookup = std::make_unique<TransparentInvisibleLookupMap>
-  (
-    std::initializer_list<wchar_t>
-    ({
-      wchar_t(UniChar::LowerHalfBlock),
-      wchar_t(UniChar::UpperHalfBlock),
-      wchar_t(UniChar::LeftHalfBlock),
-      wchar_t(UniChar::RightHalfBlock),
-      wchar_t(UniChar::MediumShade),
-      wchar_t(UniChar::FullBlock)
-    })
-  );
-
-  return *trans_inv_lookup;
-}
+constexpr std::size_t FVTerm::FTermRegion::FLineChanges::MAX_SPANS;
+constexpr uInt        FVTerm::FTermRegion::FLineChanges::SPAN_MERGE_GAP;
 
 //----------------------------------------------------------------------
 // class FVTerm
@@ -172,6 +154,13 @@ auto FVTerm::getFOutput() -> std::shared_ptr<FOutput>
   return init_object->foutput;
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::getBandCompositor() -> FBandCompositor&
+{
+  static FBandCompositor band_compositor{};
+  return band_compositor;
+}
+
 //----------------------------------------------------------------------
 auto FVTerm::getPrintCursor() -> FPoint
 {
@@ -263,7 +252,9 @@ void FVTerm::createVTerm (const FSize& size) noexcept
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   vterm = createRegion(box);
-  vterm_old = createRegion(box);
+  vterm_old = std::make_shared<FCompactRegion>();
+  vterm_old->resize(size);
+  vterm_old->save(*vterm);
 }
 
 //----------------------------------------------------------------------
@@ -273,7 +264,9 @@ void FVTerm::resizeVTerm (const FSize& size) const noexcept
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   resizeRegion (box, vterm.get());
-  resizeRegion (box, vterm_old.get());
+
+  if ( vterm_old->resize(size) )
+    vterm_old->save(*vterm);
 }
 
 //----------------------------------------------------------------------
@@ -288,8 +281,7 @@ void FVTerm::putVTerm() const
                 , vterm_changes + vterm->size.height
                 , [&xmax] (auto& vterm_changes_line) noexcept
                   {
-                    vterm_changes_line.xmin = 0;
-                    vterm_changes_line.xmax = xmax;
+                    vterm_changes_line.setSpan (0, xmax);
                   } );
   vterm->changes_in_row = {0, ymax};
   updateTerminal();
@@ -300,12 +292,17 @@ auto FVTerm::updateTerminal() const -> bool
 {
   // Update terminal screen when modified
 
-  auto terminal_updated = canUpdateTerminalNow()
-                        ? foutput->updateTerminal()
-                        : false;
+  if ( ! canUpdateTerminalNow() )
+    return false;
+
+  // The scrolling belongs to the same synchronized frame
+  foutput->beginSynchronizedUpdate();
+  scrollShiftedLines();  // Use terminal scrolling for moved lines
+  const auto terminal_updated = foutput->updateTerminal();
+  foutput->endSynchronizedUpdate();
 
   if ( terminal_updated )
-    saveCurrentVTerm();
+    vterm_old->saveOutputLines(*vterm);  // Without deferred lines
 
   return terminal_updated;
 }
@@ -315,41 +312,81 @@ void FVTerm::reduceTerminalLineUpdates (uInt y)
 {
   static const auto& init_object = getGlobalFVTermInstance();
   static const auto& vterm = init_object->vterm;
-  static const auto& vterm_old = init_object->vterm_old;
   auto& vterm_changes = vterm->changes_in_line[unsigned(y)];
-  uInt& xmin = vterm_changes.xmin;
-  uInt& xmax = vterm_changes.xmax;
+  const auto span_count = vterm_changes.getSpanCount();
+
+  if ( span_count == 0 )  // No changes
+    return;
+
+  // Reduce each damage span to the really changed characters
+  FTermRegion::FLineChanges::FSpanList reduced_spans{};
+  std::size_t count{0};
+  uInt last_xmin{0};
+
+  for (std::size_t i{0}; i < span_count; i++)
+  {
+    auto span = vterm_changes.getSpan(i);
+
+    if ( reduceTerminalSpan(span.xmin, span.xmax, y) )
+    {
+      reduced_spans[count] = span;
+      count++;
+    }
+
+    last_xmin = span.xmin;
+  }
 
-  if ( xmin > xmax )  // No changes
+  if ( count == 0 && last_xmin > 0 )
+  {
+    // Empty range at the last compared position
+    vterm_changes.setEmpty (last_xmin);
     return;
+  }
+
+  vterm_changes.setSpans (reduced_spans, count, uInt(vterm->size.width));
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::reduceTerminalSpan (uInt& xmin, uInt& xmax, uInt y) -> bool
+{
+  // Returns false if the span has no more changes
 
+  static const auto& init_object = getGlobalFVTermInstance();
+  static const auto& vterm = init_object->vterm;
+  static const auto& vterm_old = init_object->vterm_old;
+  const auto row_offset = std::size_t(y) * std::size_t(vterm->size.width);
   auto first = vterm->getFCharIterator(int(xmin), int(y));
-  auto first_old = vterm_old->getFCharIterator(int(xmin), int(y));
+  auto first_old = row_offset + xmin;  // Index in the compact copy
   auto last = vterm->getFCharIterator(int(xmax), int(y));
-  auto last_old = vterm_old->getFCharIterator(int(xmax), int(y));
+  auto last_old = row_offset + xmax;
 
-  while ( xmin < xmax && *first == *first_old )
+  while ( xmin < xmax && vterm_old->isEqual(first_old, *first) )
   {
     xmin++;
     ++first;
     ++first_old;
   }
 
-  while ( last >= first && *last == *last_old )
+  while ( xmax > xmin && vterm_old->isEqual(last_old, *last) )
   {
     xmax--;
     --last;
     --last_old;
   }
 
+  if ( xmin == xmax && vterm_old->isEqual(first_old, *first) )
+    return false;
+
   while ( last > first )
   {
-    if ( *last == *last_old )
+    if ( vterm_old->isEqual(last_old, *last) )
       last->setBit(FAttribute::set::no_changes);
 
     --last;
     --last_old;
   }
+
+  return true;
 }
 
 //----------------------------------------------------------------------
@@ -464,8 +501,7 @@ auto FVTerm::print (FTermRegion* region, const FVTermBuffer& buffer) const noexc
   if ( ! region || buffer.isEmpty() )
     return -1;
 
-  auto ac = region->getFCharIterator( region->cursor.x - 1
-                                    , region->cursor.y - 1 );  // Region character iterator
+  auto ac = region->getCursorIterator();  // Region character iterator
 
   for (const auto& fchar : buffer)
   {
@@ -513,8 +549,7 @@ auto FVTerm::print (FTermRegion* region, const FChar& term_char) const noexcept
   if ( ! region )
     return -1;  // No region
 
-  auto ac = region->getFCharIterator( region->cursor.x - 1
-                                    , region->cursor.y - 1 );  // Region character iterator
+  auto ac = region->getCursorIterator();  // Region character iterator
   return printCharacter(region, ac, term_char);
 }
 
@@ -581,6 +616,8 @@ void FVTerm::resizeRegion ( const FShadowBox& shadowbox
   if ( ! region )
     return;
 
+  invalidateWindowIndex();
+
   if ( isSizeEqual(region, shadowbox) )
   {
     region->position.x = shadowbox.box.getX();
@@ -703,20 +740,15 @@ void FVTerm::getRegion (const FPoint& pos, FTermRegion* region) const noexcept
 
   const int y_end  = std::min(vterm->size.height - ay, region->size.height);
   const int length = std::min(vterm->size.width - ax, region->size.width);
-  const auto region_width = getFullRegionWidth(region);
-  const auto vterm_width = getFullRegionWidth(vterm.get());
   auto line_changes = region->changes_in_line.begin();
-  auto ac = region->data.begin();  // Region character
-  auto tc = vterm->data.cbegin() + (ay * vterm_width);  // Terminal character
 
   for (auto y{0}; y < y_end; y++)  // line loop
   {
-    putRegionLine (*(tc + unsigned(ax)), *ac, length);
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(length - 1);
+    const auto& tc = vterm->getFChar(ax, ay + y);  // Terminal character
+    auto& ac = region->getFChar(0, y);  // Region character
+    putRegionLine (tc, ac, length);
+    line_changes->setSpan (0, uInt(length - 1));
     ++line_changes;
-    ac += region_width;
-    tc += vterm_width;
   }
 
   auto& changes_in_row = region->changes_in_row;
@@ -746,10 +778,6 @@ void FVTerm::getRegion (const FRect& box, FTermRegion* region) const noexcept
   if ( dy < 0 ) { h += dy; y -= dy; dy = 0; }
   const int y_end = std::min(vterm->size.height - y, h);
   const int length = std::min(vterm->size.width - x, w);
-  const auto region_width = getFullRegionWidth(region);
-  const auto vterm_width = getFullRegionWidth(vterm.get());
-  auto ac = region->data.begin() + (dy * region_width);  // Region character
-  auto tc = vterm->data.cbegin() + (y * vterm_width);  // Terminal character
 
   if ( length < 1 )
     return;
@@ -758,12 +786,11 @@ void FVTerm::getRegion (const FRect& box, FTermRegion* region) const noexcept
 
   for (auto line{0}; line < y_end; line++)  // line loop
   {
-    putRegionLine (*(tc + x), *(ac + dx), length);
-    line_changes->xmin = std::min(line_changes->xmin, uInt(dx));
-    line_changes->xmax = std::max(line_changes->xmax, uInt(dx + length - 1));
+    const auto& tc = vterm->getFChar(x, y + line);  // Terminal character
+    auto& ac = region->getFChar(dx, dy + line);  // Region character
+    putRegionLine (tc, ac, length);
+    line_changes->addSpan (uInt(dx), uInt(dx + length - 1));
     ++line_changes;
-    ac += region_width;
-    tc += vterm_width;
   }
 
   auto& changes_in_row = region->changes_in_row;
@@ -827,7 +854,6 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
     skip_one_vterm_update = true;
 
   const int src_width = getFullRegionWidth(src);
-  const int dst_width = getFullRegionWidth(dst);
   const int src_height = src->minimized ? src->min_size.height : getFullRegionHeight(src);
   const int ax = std::max(0, pos.getX() - 1);
   const int ay = std::max(0, pos.getY() - 1);
@@ -839,20 +865,32 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
   if ( length < 1 || y_end < 1 )
     return;
 
-  auto src_changes = src->changes_in_line.cbegin();
+  auto src_changes = src->changes_in_line.cbegin() + ot;
   auto dst_changes = dst->changes_in_line.begin() + ay;
-  auto sc = src->data.cbegin() + (src_width * ot) + ol;  // src character ptr
-  auto dc = dst->data.begin() + (dst_width * ay) + ax;  // dst character ptr
 
   if ( skip_one_vterm_update )  // dst is the virtual terminal
     determineCoveredRegions(src);
 
   for (int y{0}; y < y_end; y++)  // line loop
   {
+    auto sc = src->getFCharIterator(ol, ot + y);  // src character ptr
+    auto dc = dst->getFCharIterator(ax, ay + y);  // dst character ptr
+
     if ( skip_one_vterm_update && src_changes->trans_count > 0 )
     {
+      // Only the shadow of an uncovered line needs the per-character path
+      const bool opaque_front = ! src_changes->covered
+                             && src->getLineOpacity(ot + y) == FTermRegion::Opacity::Shadow;
+      const int opaque_length = opaque_front
+                              ? std::max(0, std::min(length, src->size.width - ol))
+                              : 0;
+      putRegionLine (*sc, *dc, opaque_length);
+
       // Line with hidden and transparent characters
-      putRegionLineWithTransparency (sc, dc, length, {ax, ay + y}, src_changes->covered);
+      putRegionLineWithTransparency ( sc + opaque_length, dc + opaque_length
+                                    , length - opaque_length
+                                    , {ax + opaque_length, ay + y}
+                                    , src_changes->covered );
     }
     else
     {
@@ -860,12 +898,9 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
       putRegionLine (*sc, *dc, length);
     }
 
-    dst_changes->xmin = std::min(dst_changes->xmin, uInt(ax));
-    dst_changes->xmax = std::max(dst_changes->xmax, uInt(ax + length - 1));
+    dst_changes->addSpan (uInt(ax), uInt(ax + length - 1));
     ++src_changes;
     ++dst_changes;
-    sc += src_width;
-    dc += dst_width;
   }
 
   dst->changes_in_row.ymin = std::min(dst->changes_in_row.ymin, uInt(ay));
@@ -892,6 +927,17 @@ void FVTerm::determineWindowLayers() noexcept
     (*iter)->getPrintRegion()->layer = int(std::distance(begin, iter) + 1);
     ++iter;
   }
+
+  invalidateWindowIndex();
+}
+
+//----------------------------------------------------------------------
+void FVTerm::invalidateWindowIndex() noexcept
+{
+  // The window index is rebuilt on the next access after a window
+  // has been moved, resized, raised, lowered, shown or hidden
+
+  getWindowIndex().invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -904,19 +950,17 @@ void FVTerm::scrollRegionForward (FTermRegion* region)
 
   const int y_max = region->size.height - 1;
   const int x_max = region->size.width - 1;
-  auto line_changes = region->changes_in_line.begin();
-  const auto region_width = getFullRegionWidth(region);
-  auto sc = region->data.cbegin() + region_width;  // source character
-  auto dc = region->data.begin();  // destination character
 
-  for (auto y{0}; y < y_max; y++)
+  if ( region->shadow.width == 0 )
   {
-    putRegionLine (*sc, *dc, region->size.width);
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    ++line_changes;
-    sc += region_width;
-    dc += region_width;
+    // Rotate the line offsets instead of copying the characters
+    region->rotateRows(1);
+  }
+  else
+  {
+    // The right shadow keeps its position
+    for (auto y{0}; y < y_max; y++)
+      putRegionLine (region->getFChar(0, y + 1), region->getFChar(0, y), region->size.width);
   }
 
   // insert a new line below
@@ -925,13 +969,7 @@ void FVTerm::scrollRegionForward (FTermRegion* region)
   nc.attr = lc.attr;
   nc.ch[0] = L' ';
   nc.ch[1] = L'\0';
-  dc = region->data.begin() + (region_width * y_max);  // destination character
-  std::fill (dc, dc + region->size.width, nc);
-  auto new_line_changes = region->changes_in_line.begin() + y_max;
-  new_line_changes->xmin = 0;
-  new_line_changes->xmax = uInt(x_max);
-  region->changes_in_row = {0, uInt(y_max)};
-  region->has_changes = true;
+  insertScrolledLine (region, y_max, nc);
 
   if ( region == vdesktop.get() )
     scrollTerminalForward();  // Scrolls the terminal up one line
@@ -946,20 +984,17 @@ void FVTerm::scrollRegionReverse (FTermRegion* region)
     return;
 
   const int y_max = region->size.height - 1;
-  const int x_max = region->size.width - 1;
-  auto line_changes = region->changes_in_line.begin() + y_max;
-  const auto region_width = getFullRegionWidth(region);
-  auto sc = region->data.cbegin() + (region_width * (y_max - 1));  // source character
-  auto dc = region->data.begin() + (region_width * y_max);  // destination character
 
-  for (auto y = y_max; y > 0; y--)
+  if ( region->shadow.width == 0 )
+  {
+    // Rotate the line offsets instead of copying the characters
+    region->rotateRows(-1);
+  }
+  else
   {
-    putRegionLine (*sc, *dc, region->size.width);
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    --line_changes;
-    sc -= region_width;
-    dc -= region_width;
+    // The right shadow keeps its position
+    for (auto y = y_max; y > 0; y--)
+      putRegionLine (region->getFChar(0, y - 1), region->getFChar(0, y), region->size.width);
   }
 
   // insert a new line above
@@ -968,13 +1003,7 @@ void FVTerm::scrollRegionReverse (FTermRegion* region)
   nc.attr = lc.attr;
   nc.ch[0] = L' ';
   nc.ch[1] = L'\0';
-  dc = region->data.begin();  // destination character
-  std::fill (dc, dc + region->size.width, nc);
-  auto new_line_changes = region->changes_in_line.begin() + y_max;
-  new_line_changes->xmin = 0;
-  new_line_changes->xmax = uInt(x_max);
-  region->changes_in_row = {0, uInt(y_max)};
-  region->has_changes = true;
+  insertScrolledLine (region, 0, nc);
 
   if ( region == vdesktop.get() )
     scrollTerminalReverse();  // Scrolls the terminal down one line
@@ -1012,8 +1041,7 @@ void FVTerm::clearRegion (FTermRegion* region, wchar_t fillchar) noexcept
 
   for (auto i{0}; i < region->size.height; i++)
   {
-    line_changes->xmin = 0;
-    line_changes->xmax = width - 1;
+    line_changes->setSpan (0, width - 1);
 
     if ( nc.isBitSet(FAttribute::set::transparent)
       || nc.isBitSet(FAttribute::set::color_overlay)
@@ -1031,14 +1059,14 @@ void FVTerm::clearRegion (FTermRegion* region, wchar_t fillchar) noexcept
 
   for (auto i{0}; i < region->shadow.height; i++)
   {
-    line_changes->xmin = 0;
-    line_changes->xmax = width - 1;
+    line_changes->setSpan (0, width - 1);
     line_changes->trans_count = width;
     ++line_changes;
   }
 
   region->changes_in_row = {0, uInt(getFullRegionHeight(region) - 1)};
   region->has_changes = true;
+  region->invalidateOpacity();
 }
 
 //----------------------------------------------------------------------
@@ -1068,6 +1096,77 @@ auto FVTerm::processTerminalUpdate() const -> bool
   return updateTerminal();
 }
 
+//----------------------------------------------------------------------
+void FVTerm::scrollShiftedLines() const
+{
+  // Searches for a block of lines that has moved vertically since the
+  // last terminal update. If it is shorter than redrawing, the terminal
+  // scrolls these lines, and only the exposed lines are printed again.
+
+  const auto ymin = int(vterm->changes_in_row.ymin);
+  const auto ymax = int(vterm->changes_in_row.ymax);
+
+  if ( ymax <= ymin
+    || vterm_old->size.width != vterm->size.width
+    || vterm_old->size.height != vterm->size.height )
+    return;
+
+  auto& detector = getScrollDetector();
+  auto& old_lines = detector.getOldLines();
+  auto& new_lines = detector.getNewLines();
+  const auto count = std::size_t(ymax - ymin + 1);
+  old_lines.resize(count);
+  new_lines.resize(count);
+
+  for (std::size_t i{0}; i < count; i++)
+  {
+    const auto y = ymin + int(i);
+    old_lines[i] = vterm_old->getLineHash(y);
+    new_lines[i] = FCompactRegion::getLineHash(*vterm, y);
+  }
+
+  const auto block = detector.findScrollBlock();
+
+  if ( block.distance == 0 )
+    return;
+
+  const auto top = ymin + block.top;
+  const auto bottom = ymin + block.bottom;
+  const auto exposed_first = ( block.distance > 0 ) ? bottom - block.distance + 1 : top;
+  const auto exposed_last = ( block.distance > 0 ) ? bottom : top - block.distance - 1;
+  const auto width = std::size_t(vterm->size.width);
+  std::size_t moved_changes{0};
+  std::size_t exposed_unchanged{0};
+
+  for (auto y{top}; y <= bottom; y++)
+  {
+    const auto changes = vterm_old->countChanges(*vterm, y);
+
+    if ( y >= exposed_first && y <= exposed_last )
+      exposed_unchanged += width - changes;  // Must be printed again
+    else
+      moved_changes += changes;  // Would be printed without scrolling
+  }
+
+  if ( moved_changes <= exposed_unchanged
+    || ! foutput->scrollTerminalRegion ( top, bottom, block.distance
+                                       , moved_changes - exposed_unchanged ) )
+    return;
+
+  // Apply the scrolling to the copy of the last terminal frame
+  vterm_old->scrollLines (top, bottom, block.distance);
+
+  for (auto y{exposed_first}; y <= exposed_last; y++)
+    vterm->changes_in_line[unsigned(y)].setSpan (0, uInt(width - 1));
+}
+
+//----------------------------------------------------------------------
+void FVTerm::saveCurrentVTerm() const noexcept
+{
+  // Save the content of the virtual terminal in compact form
+  vterm_old->save(*vterm);
+}
+
 //----------------------------------------------------------------------
 void FVTerm::startDrawing() noexcept
 {
@@ -1088,6 +1187,7 @@ void FVTerm::initTerminal()
   foutput->initTerminal(vterm.get());
   tabstop = foutput->getTabstop();
   resetRegionEncoding();
+  getBandCompositor().setThreadCount(FStartOptions::getInstance().compositor_threads);
 }
 
 
@@ -1098,6 +1198,20 @@ void FVTerm::setGlobalFVTermInstance (FVTerm* ptr) noexcept
   getGlobalFVTermInstance() = ptr;
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::getWindowIndex() -> FWindowIndex&
+{
+  static FWindowIndex window_index{};
+  return window_index;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::getScrollDetector() -> FScrollDetector&
+{
+  static FScrollDetector scroll_detector{};
+  return scroll_detector;
+}
+
 //----------------------------------------------------------------------
 auto FVTerm::getGlobalFVTermInstance() noexcept -> FVTerm*&
 {
@@ -1147,6 +1261,7 @@ inline void FVTerm::resetTextRegionToDefault ( FTermRegion* region
     { 0x00080000U }  // char_width = 1
   };
   std::fill (region->data.begin(), region->data.end(), default_char);
+  region->resetRowOffsets();
 
   const FTermRegion::FLineChanges unchanged { uInt(size.getWidth())
                                           , 0, 0, false };
@@ -1223,9 +1338,7 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermRegion* region) const noex
     // Position is covered by this window - check for transparency
     const auto delta_x = pos_x - win->position.x;
     const auto delta_y = pos_y - win->position.y;
-    const auto width = getFullRegionWidth(win);
-    const auto index = unsigned(delta_y) * unsigned(width) + unsigned(delta_x);
-    const auto& character = win->data[index];
+    const auto& character = win->getFChar(delta_x, delta_y);
 
     if ( character.isBitSet(FAttribute::set::transparent) )
       continue;
@@ -1297,6 +1410,7 @@ inline void FVTerm::updateRegionProperties ( FTermRegion* region
   region->shadow.width    = int(shadowbox.shadow.getWidth());
   region->shadow.height   = int(shadowbox.shadow.getHeight());
   region->has_changes     = false;
+  region->invalidateOpacity();
 }
 
 //----------------------------------------------------------------------
@@ -1326,23 +1440,26 @@ void FVTerm::passChangesToOverlap (const FTermRegion* region) const
 inline void FVTerm::processOverlappingWindows ( const FTermRegion* region
                                               , const FVTermList& vterm_win_list ) const
 {
-  bool found{false};
-
   if ( ! region )
     return;
 
-  for (const auto& vterm_obj : vterm_win_list)
-  {
-    auto* win = vterm_obj->getVWin();
+  auto& window_index = getWindowIndex();
 
-    if ( found && win && win->visible && win->isOverlapped(region) )
-    {
-      // Pass changes to the found window
-      passChangesToOverlappingWindow (win, region);
-    }
+  window_index.update(vterm_win_list);  // Rebuilds only after changes
+
+  const auto& overlapping_windows = window_index.findOverlapping(region);
+  const int region_z = window_index.findPosition(region);
+
+  if ( region_z < 0 )
+    return;
+
+  for (const auto* entry : overlapping_windows)
+  {
+    if ( entry->z <= region_z )
+      break;  // Sorted from top to bottom
 
-    if ( region == win )
-      found = true;
+    // Pass changes to the window above the region
+    passChangesToOverlappingWindow (entry->win, region);
   }
 }
 
@@ -1389,9 +1506,7 @@ inline void FVTerm::passChangesToOverlappingWindowLine ( FTermRegion* win
   const int x_end = calculateEndCoordinate (vterm_x_max, region_x_max, win_x_min, win_x_max);
 
   // Sets the new change boundaries
-  auto& line_changes = win->changes_in_line[unsigned(y)];
-  line_changes.xmin = uInt(std::min(int(line_changes.xmin), x_start));
-  line_changes.xmax = uInt(std::max(int(line_changes.xmax), x_end));
+  win->changes_in_line[unsigned(y)].addSpan (uInt(x_start), uInt(x_end));
 }
 
 //----------------------------------------------------------------------
@@ -1416,6 +1531,9 @@ void FVTerm::updateVTerm() const
   if ( ! vterm_window_list || vterm_window_list->empty() )
     return;
 
+  // Take over the current window geometry
+  getWindowIndex().update(*vterm_window_list);
+
   for (const auto& vterm_obj : *vterm_window_list)  // List from bottom to top
   {
     auto v_win = vterm_obj->getVWin();
@@ -1500,53 +1618,75 @@ inline auto FVTerm::isLayerOutsideVTerm (const LayerGeometry& geo) const noexcep
 inline void FVTerm::buildLineChangeBatch ( const FTermRegion* region
                                          , const LayerGeometry& geo ) const noexcept
 {
+  // Opaque spans are composed later with a block copy. In lines whose
+  // transparent characters are all in the right shadow, only the
+  // shadow columns take the per-character transparency path.
+
+  using Opacity = FTermRegion::Opacity;
+  const auto region_opacity = region->getOpacity();
+  const auto shadow_x = region->size.width;  // First right shadow column
   int prev_xmin{-1};
   int prev_xmax{-1};
   NoTrans prev_has_no_trans{NoTrans::Undefined};
 
+  const auto get_no_trans = [shadow_x] ( Opacity opacity
+                                       , int xmin, int xmax ) -> NoTrans
+  {
+    if ( opacity == Opacity::Opaque )
+      return NoTrans::Set;
+
+    if ( opacity == Opacity::Mixed || xmin >= shadow_x )
+      return NoTrans::Unset;
+
+    return ( xmax < shadow_x ) ? NoTrans::Set : NoTrans::Shadow;
+  };
+
   auto line_changes = region->changes_in_line.begin() + geo.y_start;
 
   for (auto y{geo.y_start}; y < geo.y_end; y++)  // Line loop
   {
-    const auto line_xmin_raw = int(line_changes->xmin);
-    const auto line_xmax_raw = int(line_changes->xmax);
+    const auto span_count = line_changes->getSpanCount();
+    const auto opacity = ( region_opacity == Opacity::Opaque )
+                       ? Opacity::Opaque
+                       : region->getLineOpacity(y);
+    std::size_t visible_spans{0};
 
-    if ( line_xmin_raw > line_xmax_raw )
+    for (std::size_t i{0}; i < span_count; i++)  // Damage span loop
     {
-      ++line_changes;
-      prev_xmin = -1;
-      prev_xmax = -1;
-      prev_has_no_trans = NoTrans::Undefined;
-      continue;
-    }
+      const auto span = line_changes->getSpan(i);
+      const auto line_xmin = std::max(int(span.xmin), geo.ol);
+      const auto line_xmax = std::min(int(span.xmax), geo.xmax_inside_vterm);
 
-    const auto line_xmin = std::max(line_xmin_raw, geo.ol);
-    const auto line_xmax = std::min(line_xmax_raw, geo.xmax_inside_vterm);
+      if ( line_xmin > line_xmax )
+        continue;
+
+      visible_spans++;
+      const auto has_no_trans = get_no_trans(opacity, line_xmin, line_xmax);
 
-    if ( line_xmin > line_xmax )
+      // Consecutive lines with the same single span are combined
+      if ( span_count == 1
+        && prev_xmin == line_xmin
+        && prev_xmax == line_xmax
+        && prev_has_no_trans == has_no_trans )
+      {
+        line_changes_batch.back().count++;
+        continue;
+      }
+
+      line_changes_batch.push_back({1, y, line_xmin, line_xmax, has_no_trans});
+      prev_xmin = line_xmin;
+      prev_xmax = line_xmax;
+      prev_has_no_trans = has_no_trans;
+    }
+
+    if ( span_count != 1 || visible_spans == 0 )
     {
-      ++line_changes;
       prev_xmin = -1;
       prev_xmax = -1;
       prev_has_no_trans = NoTrans::Undefined;
-      continue;
     }
 
-    const NoTrans has_no_trans = line_changes->trans_count == 0 ? NoTrans::Set : NoTrans::Unset;
     ++line_changes;
-
-    if ( prev_xmin == line_xmin
-      && prev_xmax == line_xmax
-      && prev_has_no_trans == has_no_trans )
-    {
-      line_changes_batch.back().count++;
-      continue;
-    }
-
-    line_changes_batch.push_back({1, y, line_xmin, line_xmax, has_no_trans});
-    prev_xmin = line_xmin;
-    prev_xmax = line_xmax;
-    prev_has_no_trans = has_no_trans;
   }
 }
 
@@ -1554,45 +1694,89 @@ inline void FVTerm::buildLineChangeBatch ( const FTermRegion* region
 inline void FVTerm::applyLineBatch ( FTermRegion* region
                                    , const LayerGeometry& geo ) const noexcept
 {
+  const auto& first = line_changes_batch.front();
+  const auto& last  = line_changes_batch.back();
+  const auto y_begin = first.ypos;
+  const auto y_end = last.ypos + last.count;
+  auto& band_compositor = getBandCompositor();
+
+  if ( ! band_compositor.isParallel() )
+  {
+    applyLineBatchBand (region, geo, y_begin, y_end);
+    return;
+  }
+
+  // Rows are independent of each other, so horizontal bands
+  // of the region can be composed at the same time
+  try
+  {
+    band_compositor.run ( y_begin, y_end, geo.width
+                        , [this, region, &geo] (int band_begin, int band_end)
+                          {
+                            applyLineBatchBand (region, geo, band_begin, band_end);
+                          } );
+  }
+  catch (const std::exception&)
+  {
+    // No band was started (thread synchronization or memory
+    // allocation failed), so all rows are composed here
+    applyLineBatchBand (region, geo, y_begin, y_end);
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::applyLineBatchBand ( FTermRegion* region
+                                       , const LayerGeometry& geo
+                                       , int band_begin
+                                       , int band_end ) const noexcept
+{
+  // Composes the batch lines from band_begin to band_end - 1
+
   for (const auto& line : line_changes_batch)
   {
+    if ( line.ypos >= band_end )
+      break;  // The batch is sorted by line position
+
+    const auto y_first = std::max(line.ypos, band_begin);
+    const auto y_last = std::min(line.ypos + line.count, band_end);
+
+    if ( y_first >= y_last )
+      continue;
+
     const auto line_xmin = line.xmin;
     const auto line_xmax = line.xmax;
-    const auto has_no_trans = line.has_no_transparency == NoTrans::Set;
     const auto tx = geo.region_x + line_xmin;  // Global terminal x-position
     const int length = line_xmax - line_xmin + 1;
+    int opaque_length{0};  // Leading characters without transparency
+
+    if ( line.has_no_transparency == NoTrans::Set )
+      opaque_length = length;
+    else if ( line.has_no_transparency == NoTrans::Shadow )
+      opaque_length = region->size.width - line_xmin;
 
     // Process all lines in batch with same operation
-    for (int i = 0; i < line.count; ++i)
+    for (auto y{y_first}; y < y_last; ++y)
     {
-      const auto y = line.ypos + i;
       auto line_changes = region->changes_in_line.begin() + y;
       const auto ty = geo.region_y + y;  // Global terminal y-position
-      const auto region_line_offset = y * geo.width + line_xmin;
-      const auto vterm_line_offset = ty * geo.vterm_width + tx;
-      auto ac = region->data.begin() + region_line_offset;    // Region character
-      auto tc = vterm->data.begin() + vterm_line_offset;  // Terminal character
+      auto ac = region->getFCharIterator(line_xmin, y);  // Region character
+      auto tc = vterm->getFCharIterator(tx, ty);  // Terminal character
 
-      if ( has_no_trans )
-      {
-        // Line has only covered characters
-        putRegionLine (*ac, *tc, length);
-      }
-      else
-      {
-        // Line with hidden and transparent characters
-        addRegionLineWithTransparency (ac, tc, length);
-      }
+      // Block copy of the covering characters
+      putRegionLine (*ac, *tc, opaque_length);
+
+      // Remaining characters with hidden and transparent characters
+      addRegionLineWithTransparency ( ac + opaque_length
+                                    , tc + opaque_length
+                                    , length - opaque_length );
 
       auto vterm_changes = vterm->changes_in_line.begin() + ty;
       const auto tx_start = uInt(tx);
       const auto tx_end   = uInt(std::min( geo.ax + line_xmax
                                          , geo.vterm_width - 1 ));
-      vterm_changes->xmin = std::min(vterm_changes->xmin, tx_start);
-      vterm_changes->xmax = std::max(vterm_changes->xmax, tx_end);
+      vterm_changes->addSpan (tx_start, tx_end);
 
-      line_changes->xmin = uInt(geo.width);
-      line_changes->xmax = 0;
+      line_changes->clear (uInt(geo.width));
       ++line_changes;
     }
   }
@@ -1612,6 +1796,33 @@ inline void FVTerm::updateVTermChangesFromBatch (const LayerGeometry& geo) const
   vterm->has_changes = true;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::insertScrolledLine ( FTermRegion* region, int y
+                                , const FChar& fillchar ) const noexcept
+{
+  // Fills the exposed line y of a scrolled region
+  // and marks all lines of the region as changed
+
+  const auto width = region->size.width;
+  const auto ac = region->getFCharIterator(0, y);
+  const auto shadow_begin = ac + width;
+  const auto shadow_end = shadow_begin + region->shadow.width;
+  const auto is_transparent = [] (const FChar& fchar)
+  {
+    return fchar.isBitSet(internal::var::print_transparent_mask);
+  };
+  std::fill (ac, shadow_begin, fillchar);
+  auto line_changes = region->changes_in_line.begin();
+  line_changes[y].trans_count = uInt(std::count_if(ac, shadow_end, is_transparent));
+
+  for (auto line{0}; line < region->size.height; line++)
+    line_changes[line].setSpan (0, uInt(width - 1));
+
+  region->changes_in_row = {0, uInt(region->size.height - 1)};
+  region->has_changes = true;
+  region->invalidateOpacity();
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::scrollTerminalForward() const
 {
@@ -1629,8 +1840,7 @@ inline void FVTerm::scrollTerminalForward() const
 
   while ( vdesktop_changes < vdesktop_changes_end )
   {
-    vdesktop_changes->xmin = uInt(vdesktop->size.width - 1);
-    vdesktop_changes->xmax = 0;
+    vdesktop_changes->clear (uInt(vdesktop->size.width - 1));
     ++vdesktop_changes;
   }
 
@@ -1657,8 +1867,7 @@ inline void FVTerm::scrollTerminalReverse() const
 
   while ( vdesktop_changes < vdesktop_changes_end )
   {
-    vdesktop_changes->xmin = uInt(vdesktop->size.width - 1);
-    vdesktop_changes->xmax = 0;
+    vdesktop_changes->clear (uInt(vdesktop->size.width - 1));
     ++vdesktop_changes;
   }
 
@@ -1745,9 +1954,7 @@ constexpr auto FVTerm::isFCharTransparent (const FChar& fchar) noexcept -> bool
 //----------------------------------------------------------------------
 inline auto FVTerm::isTransparentInvisible (const FChar& fchar) const noexcept -> bool
 {
-  static const auto& trans_inv_chars = getTransparentInvisibleLookupMap();
-  const auto& fist_char = fchar.ch.unicode_data[0];
-  return trans_inv_chars.find(fist_char) != trans_inv_chars.end();
+  return FCellBlender::isTransparentInvisible(fchar.ch.unicode_data[0]);
 }
 
 //----------------------------------------------------------------------
@@ -1790,13 +1997,6 @@ void FVTerm::finish() const
   setGlobalFVTermInstance(nullptr);
 }
 
-//----------------------------------------------------------------------
-inline void FVTerm::saveCurrentVTerm() const noexcept
-{
-  // Save the content of the virtual terminal
-  std::memcpy(vterm_old->data.data(), vterm->data.data(), vterm->data.size() * sizeof(FChar));
-}
-
 //----------------------------------------------------------------------
 inline void FVTerm::putRegionLine ( const FChar& src_char
                                   , FChar& dst_char
@@ -1862,8 +2062,6 @@ inline void FVTerm::putMultiLayerRegionLine ( FChar_iterator dst_char
     // Precalculate array indexing values for getFChar
     const auto x = term_x - x_min;
     const auto y = term_y - y_min;
-    const auto width = getFullRegionWidth(win);
-    const auto index = y * width + x;
 
     // Calculate the intersection of the line with the window
     const auto start_idx = std::max(0, x_min - term_x);
@@ -1872,7 +2070,7 @@ inline void FVTerm::putMultiLayerRegionLine ( FChar_iterator dst_char
     // Store pre-calculated region line data
     overlay_line_buffer.push_back
     (
-      { win->data.begin(), index, start_idx, end_idx }
+      { win->getFCharIterator(0, y), x, start_idx, end_idx }
     );
   }
 
@@ -2102,48 +2300,8 @@ inline void FVTerm::addTransparentRegionLine ( const FChar_const_iterator& src_c
                                              , const FChar_iterator& dst_char
                                              , const int length ) const
 {
-  auto src = src_char;
-  auto dst = dst_char;
-  auto end = src + length;
-
-  while ( src < end )  // column loop
-  {
-    addTransparentRegionChar (*src, *dst);
-    ++src;  // src character
-    ++dst;  // dst character
-  }
-}
-
-//----------------------------------------------------------------------
-inline void FVTerm::addTransparentRegionChar (const FChar& src_char, FChar& dst_char) const
-{
-  if ( src_char.isBitSet(FAttribute::set::transparent) )  // Transparent
-    return;  // Leave character on vterm untouched
-
-  if ( src_char.isBitSet(FAttribute::set::color_overlay) )  // Color overlay
-  {
-    // Get covered character + add the current color
-    dst_char.color.data = src_char.color.data;
-    dst_char.attr.data = src_char.attr.data & internal::var::color_overlay_reset_mask;
-
-    if ( isTransparentInvisible(dst_char) )
-      dst_char.ch[0] = L' ';
-
-    return;
-  }
-
-  if ( src_char.isBitSet(FAttribute::set::inherit_background) )
-  {
-    // Add the covered background to this character
-    auto bg_color = dst_char.color.getBgColor();
-    dst_char = src_char;
-    dst_char.color.setBgColor(bg_color);
-    dst_char.unsetBit(internal::var::print_reset_mask);
-    return;
-  }
-
-  // Default
-  dst_char = src_char;
+  // Blends the whole span in runs of cells with equal transparency
+  FCellBlender::blend (&*src_char, &*dst_char, std::size_t(length));
 }
 
 //----------------------------------------------------------------------
@@ -2170,8 +2328,7 @@ auto FVTerm::clearFullRegion (FTermRegion* region, FChar& fillchar) const -> boo
 
     while ( vdesktop_changes < vdesktop_changes_end )
     {
-      vdesktop_changes->xmin = 0;
-      vdesktop_changes->xmax = uInt(vdesktop->size.width) - 1;
+      vdesktop_changes->setSpan (0, uInt(vdesktop->size.width) - 1);
       vdesktop_changes->trans_count = 0;
       ++vdesktop_changes;
     }
@@ -2191,26 +2348,22 @@ void FVTerm::clearRegionWithShadow (FTermRegion* region, const FChar& fillchar)
   t_char.setBit(FAttribute::set::transparent);
   t_char.setCharWidth(0);
   const auto total_width = getFullRegionWidth(region);
-  auto region_pos = region->data.begin();
-  auto shadow_begin = region->data.begin() + region->size.width;
 
   for (auto y{0}; y < region->size.height; y++)
   {
     // Clear region
-    std::fill (region_pos, region_pos + region->size.width, fillchar);
+    const auto region_pos = region->getFCharIterator(0, y);
+    const auto shadow_begin = region_pos + region->size.width;
+    std::fill (region_pos, shadow_begin, fillchar);
     // Make right shadow transparent
     std::fill (shadow_begin, shadow_begin + region->shadow.width, t_char);
-    region_pos += total_width;
-    shadow_begin += total_width;
   }
 
   // Make bottom shadow transparent
-  region_pos = region->data.begin() + (total_width * region->size.height);
-
   for (auto y{0}; y < region->shadow.height; y++)
   {
+    const auto region_pos = region->getFCharIterator(0, region->size.height + y);
     std::fill (region_pos, region_pos + total_width, t_char);
-    region_pos += total_width;
   }
 }
 
@@ -2228,14 +2381,14 @@ inline auto FVTerm::printWrap (FTermRegion* region, FChar_iterator& ac) const ->
   {
     region->cursor.x = 1;
     region->cursor.y++;
-    ac = region->getFCharIterator(region->cursor.x - 1, region->cursor.y - 1);
+    ac = region->getCursorIterator();
   }
 
   // Prevent up scrolling
   if ( region->cursor.y > height + bsh )
   {
     region->cursor.y--;
-    ac = region->getFCharIterator(region->cursor.x - 1, region->cursor.y - 1);
+    ac = region->getCursorIterator();
     end_of_region = true;
   }
 
@@ -2272,7 +2425,7 @@ inline auto FVTerm::interpretControlCodes ( FTermRegion* region
       return false;
   }
 
-  ac = region->getFCharIterator(region->cursor.x - 1, region->cursor.y - 1);
+  ac = region->getCursorIterator();
   return true;
 }
 
@@ -2306,6 +2459,13 @@ inline auto FVTerm::printCharacter ( FTermRegion* region
   {
     region->cursor.x = 1;
     region->cursor.y++;
+
+    // Prevent up scrolling
+    if ( region->cursor.y > getFullRegionHeight(region) )
+      region->cursor.y--;
+
+    // The next line does not have to follow in memory
+    ac = region->getFCharIterator(0, region->cursor.y - 1);
   }
   else if ( char_width == 2 )
   {
@@ -2313,10 +2473,6 @@ inline auto FVTerm::printCharacter ( FTermRegion* region
     ++ac;
   }
 
-  // Prevent up scrolling
-  if ( region->cursor.y > getFullRegionHeight(region) )
-    region->cursor.y--;
-
   return 1;
 }
 
@@ -2336,7 +2492,10 @@ inline auto FVTerm::printCharacterOnCoordinate ( FTermRegion* region
   const auto trans_changed = int(trans_new) - int(trans_old);
 
   if ( trans_changed != 0 )
+  {
     region->changes_in_line[ay].trans_count += uInt(trans_changed);
+    region->invalidateOpacity();
+  }
 
   // copy character to region
   *ac = ch;
@@ -2433,29 +2592,22 @@ inline void FVTerm::determineCoveredRegions (FTermRegion* src) const
     return;
   }
 
-  const auto end = vterm_win_list->crend();
+  auto& window_index = getWindowIndex();
+  window_index.update(*vterm_win_list);
   const auto src_layer = src->layer;
 
   // Regions from top to bottom
-  for (auto iter = vterm_win_list->crbegin(); iter < end; ++iter)
+  for (const auto* entry : window_index.findOverlapping(src))
   {
-    const auto& vterm_obj = *iter;
-
-    if ( ! vterm_obj )
+    if ( entry->layer < 1 )
       continue;
 
-    const auto* win = vterm_obj->getVWin();
+    covered_regions_buffer.push_back(entry->win);
 
-    if ( ! win || ! win->visible || win->layer < 1
-      || ! win->isOverlapped(src) )
+    if ( entry->layer <= src_layer )
       continue;
 
-    covered_regions_buffer.push_back(win);
-
-    if ( win->layer <= src_layer )
-      continue;
-
-    determineLineCoveredState(win, src);
+    determineLineCoveredState(entry->y_min, entry->y_max, src);
   }
 
   addVDesktopToListIfExists(covered_regions_buffer);
@@ -2485,17 +2637,14 @@ inline void FVTerm::resetLineCoveredState (FTermRegion* src) const
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::determineLineCoveredState ( const FTermRegion* const win
+inline void FVTerm::determineLineCoveredState ( int win_y_min, int win_y_max
                                               , FTermRegion* src ) const noexcept
 {
-  // Requirements: The two regions have been checked for overlap
+  // Requirements: The window lines from win_y_min to win_y_max - 1
+  //               have been checked for overlap with src
 
-  const int win_height = win->minimized ? win->min_size.height
-                                        : getFullRegionHeight(win);
   const int src_height = src->minimized ? src->min_size.height
                                         : getFullRegionHeight(src);
-  const int win_y_min = win->position.y;
-  const int win_y_max = win_y_min + win_height;
   const int src_y_min = src->position.y;
   const int src_y_max = src_y_min + src_height;
   const int overlap_start = std::max(win_y_min, src_y_min);
@@ -2542,4 +2691,275 @@ auto FVTerm::hasPendingUpdates (const FTermRegion* region) noexcept -> bool
   return (region && region->has_changes);
 }
 
+
+//----------------------------------------------------------------------
+// struct FVTerm::FTermRegion
+//----------------------------------------------------------------------
+
+auto FVTerm::FTermRegion::getOpacity() const noexcept -> Opacity
+{
+  // Returns the cached opacity class of the region
+
+  if ( opacity_changed )
+  {
+    opacity = determineOpacity();
+    opacity_changed = false;
+  }
+
+  return opacity;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FTermRegion::invalidateOpacity() noexcept
+{
+  // The number or position of transparent characters has changed
+
+  opacity_changed = true;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::FTermRegion::determineOpacity() const noexcept -> Opacity
+{
+  // Classifies the region by the position of its transparent characters
+
+  auto region_opacity{Opacity::Opaque};
+  const auto full_height = std::min( std::size_t(size.height + shadow.height)
+                                   , changes_in_line.size() );
+
+  for (std::size_t y{0}; y < full_height; y++)
+  {
+    if ( changes_in_line[y].trans_count == 0 )
+      continue;
+
+    if ( y >= std::size_t(size.height) )  // Bottom shadow
+    {
+      region_opacity = Opacity::Shadow;
+      continue;
+    }
+
+    if ( getLineOpacity(int(y)) == Opacity::Mixed )
+      return Opacity::Mixed;
+
+    region_opacity = Opacity::Shadow;
+  }
+
+  return region_opacity;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::FTermRegion::getLineOpacity (int y) const noexcept -> Opacity
+{
+  // Opaque: the line contains no transparent characters
+  // Shadow: only the right shadow columns are transparent
+  // Mixed:  transparent characters within the region width
+
+  const auto& line_changes = changes_in_line[unsigned(y)];
+
+  if ( line_changes.trans_count == 0 )
+    return Opacity::Opaque;
+
+  if ( y >= size.height || shadow.width == 0 )
+    return Opacity::Mixed;
+
+  const auto shadow_begin = getFCharIterator(size.width, y);
+  const auto shadow_end = shadow_begin + shadow.width;
+  const auto is_transparent = [] (const FChar& fchar)
+  {
+    return fchar.isBitSet(internal::var::transparent_mask);
+  };
+  const auto shadow_trans = uInt(std::count_if(shadow_begin, shadow_end, is_transparent));
+
+  // All transparent characters must be in the shadow
+  return ( line_changes.trans_count == shadow_trans ) ? Opacity::Shadow
+                                                      : Opacity::Mixed;
+}
+
+
+//----------------------------------------------------------------------
+// struct FVTerm::FWindowIndex
+//----------------------------------------------------------------------
+
+void FVTerm::FWindowIndex::invalidate() noexcept
+{
+  dirty = true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FWindowIndex::update (const FVTermList& win_list)
+{
+  // Rebuilds the index if a window was moved, resized, raised,
+  // lowered, shown or hidden since the last call
+
+  if ( ! dirty && snapshot.size() == win_list.size() )
+    return;
+
+  snapshot.clear();
+  positions.clear();
+  int z{0};
+
+  for (const auto& vterm_obj : win_list)  // List from bottom to top
+  {
+    auto* win = vterm_obj ? vterm_obj->getVWin() : nullptr;
+    snapshot.push_back(makeEntry(win, z));
+
+    if ( win )
+      positions[win] = z;
+
+    z++;
+  }
+
+  build();
+  dirty = false;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FWindowIndex::build()
+{
+  // Builds an implicit interval tree over the vertical window ranges.
+  // The windows are sorted by y_min. The node at index i has the
+  // level k, where k is the number of trailing 1-bits of i. Each node
+  // stores the largest y_max of its subtree in max_end.
+
+  tree.clear();
+
+  for (const auto& entry : snapshot)
+    if ( entry.visible )
+      tree.push_back(entry);
+
+  std::sort ( tree.begin(), tree.end()
+            , [] (const Entry& a, const Entry& b)
+              {
+                return a.y_min < b.y_min
+                    || (a.y_min == b.y_min && a.z < b.z);
+              } );
+  max_level = -1;
+  const auto n = int(tree.size());
+
+  if ( n == 0 )
+    return;
+
+  int last_i{0};
+  int last{0};
+
+  for (int i{0}; i < n; i += 2)  // Leaves
+  {
+    last_i = i;
+    last = tree[i].max_end = tree[i].y_max;
+  }
+
+  int k{1};
+
+  for (; (1 << k) <= n; k++)  // Inner nodes from bottom to top
+  {
+    const int x = 1 << (k - 1);
+    const int step = x << 2;
+
+    for (int i{(x << 1) - 1}; i < n; i += step)
+    {
+      const int end_left = tree[i - x].max_end;
+      const int end_right = i + x < n ? tree[i + x].max_end : last;
+      tree[i].max_end = std::max({tree[i].y_max, end_left, end_right});
+    }
+
+    last_i = ((last_i >> k) & 1) ? last_i - x : last_i + x;
+
+    if ( last_i < n && tree[last_i].max_end > last )
+      last = tree[last_i].max_end;
+  }
+
+  max_level = k - 1;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::FWindowIndex::findOverlapping (const FTermRegion* region) -> const ResultList&
+{
+  // Returns all visible windows that overlap with the region,
+  // sorted from top to bottom
+
+  results.clear();
+
+  if ( ! region || max_level < 0 )
+    return results;
+
+  struct StackItem
+  {
+    int  level;
+    int  index;
+    bool left_done;
+  };
+
+  const auto area = makeEntry(const_cast<FTermRegion*>(region), 0);
+  const auto n = int(tree.size());
+  std::array<StackItem, 64> stack{};
+  std::size_t top{0};
+  stack[top++] = {max_level, (1 << max_level) - 1, false};
+
+  const auto add_if_overlapped = [this, &area] (const Entry& entry)
+  {
+    if ( area.y_min < entry.y_max
+      && entry.x_min < area.x_max && area.x_min < entry.x_max )
+      results.push_back(&entry);
+  };
+
+  while ( top > 0 )
+  {
+    const auto item = stack[--top];
+
+    if ( item.level <= 3 )  // Small subtree: linear search
+    {
+      const int i0 = item.index >> item.level << item.level;
+      const int i1 = std::min(i0 + (1 << (item.level + 1)) - 1, n);
+
+      for (int i{i0}; i < i1 && tree[i].y_min < area.y_max; i++)
+        add_if_overlapped (tree[i]);
+    }
+    else if ( ! item.left_done )
+    {
+      const int left = item.index - (1 << (item.level - 1));
+      stack[top++] = {item.level, item.index, true};
+
+      if ( left >= n || tree[left].max_end > area.y_min )
+        stack[top++] = {item.level - 1, left, false};
+    }
+    else if ( item.index < n && tree[item.index].y_min < area.y_max )
+    {
+      add_if_overlapped (tree[item.index]);
+      stack[top++] = {item.level - 1, item.index + (1 << (item.level - 1)), false};
+    }
+  }
+
+  std::sort ( results.begin(), results.end()
+            , [] (const Entry* a, const Entry* b)
+              {
+                return a->z > b->z;
+              } );
+  return results;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::FWindowIndex::findPosition (const FTermRegion* region) const noexcept -> int
+{
+  // Returns the window list position of the region or -1
+
+  const auto iter = positions.find(region);
+  return iter != positions.end() ? iter->second : -1;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::FWindowIndex::makeEntry (FTermRegion* win, int z) noexcept -> Entry
+{
+  if ( ! win )
+    return {nullptr, 0, 0, 0, 0, 0, z, 0, false};
+
+  const int width = win->size.width + win->shadow.width;
+  const int height = win->minimized ? win->min_size.height
+                                    : win->size.height + win->shadow.height;
+  const int x_min = win->position.x;
+  const int y_min = win->position.y;
+  return { win
+         , x_min, x_min + width
+         , y_min, y_min + height
+         , win->layer, z, 0, win->visible };
+}
+
 }  // namespace finalcut
@@ -50,9 +50,12 @@
 #include <sys/time.h>  // need for timeval (cygwin)
 
 #include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -63,6 +66,8 @@
 #include "final/util/frect.h"
 #include "final/util/fsize.h"
 #include "final/util/fstringstream.h"
+#include "final/vterm/fbandcompositor.h"
+#include "final/vterm/fscrolldetector.h"
 #include "final/vterm/fvtermattribute.h"
 #include "final/vterm/fvtermbuffer.h"
 
@@ -163,10 +168,12 @@ class FVTerm : public FVTermAttribute
     // Accessors
     auto  getClassName() const -> FString override;
     static auto  getFOutput() -> std::shared_ptr<FOutput>;
+    static auto  getBandCompositor() -> FBandCompositor&;
     auto  getVWin() noexcept -> FTermRegion*;
     auto  getVWin() const noexcept -> const FTermRegion*;
     auto  getPrintCursor() -> FPoint;
     static auto  getWindowList() noexcept -> FVTermList*;
+    static auto  getActiveRegion() noexcept -> const FTermRegion*;
 
     // Mutators
     void  setTerminalUpdates (TerminalUpdate) const;
@@ -257,16 +264,22 @@ class FVTerm : public FVTermAttribute
     void  copyRegion (FTermRegion*, const FPoint&, FTermRegion*)  const noexcept;
     static auto  getLayer (FVTerm&) noexcept -> int;
     static void  determineWindowLayers() noexcept;
+    static void  invalidateWindowIndex() noexcept;
     void  scrollRegionForward (FTermRegion*);
     void  scrollRegionReverse (FTermRegion*);
     void  clearRegion (FTermRegion*, wchar_t = L' ') noexcept;
     void  forceTerminalUpdate() const;
     auto  processTerminalUpdate() const -> bool;
+    void  scrollShiftedLines() const;
+    void  saveCurrentVTerm() const noexcept;
     static void  startDrawing() noexcept;
     static void  finishDrawing() noexcept;
     virtual void  initTerminal();
 
   private:
+    struct FCompactRegion;        // forward declaration
+    struct FWindowIndex;          // forward declaration
+
     struct LayerGeometry
     {
       int region_x;
@@ -294,7 +307,8 @@ class FVTerm : public FVTermAttribute
     {
       Undefined = -1,
       Set,
-      Unset
+      Unset,
+      Shadow  // Transparent characters only in the right shadow
     };
 
     struct LineChanges
@@ -335,6 +349,9 @@ class FVTerm : public FVTermAttribute
     static void setGlobalFVTermInstance (FVTerm*) noexcept;
     static auto getGlobalFVTermInstance() noexcept -> FVTerm*&;
     static auto isInitialized() noexcept -> bool;
+    static auto reduceTerminalSpan (uInt&, uInt&, uInt) -> bool;
+    static auto getWindowIndex() -> FWindowIndex&;
+    static auto getScrollDetector() -> FScrollDetector&;
     void  resetRegionEncoding() const;
     void  resetTextRegionToDefault (FTermRegion*, const FSize&) const noexcept;
     auto  resizeTextRegion (FTermRegion*, std::size_t, std::size_t ) const -> bool;
@@ -361,7 +378,9 @@ class FVTerm : public FVTermAttribute
     auto  isLayerOutsideVTerm (const LayerGeometry&) const noexcept -> bool;
     void  buildLineChangeBatch (const FTermRegion*, const LayerGeometry&) const noexcept;
     void  applyLineBatch (FTermRegion*, const LayerGeometry&) const noexcept;
+    void  applyLineBatchBand (FTermRegion*, const LayerGeometry&, int, int) const noexcept;
     void  updateVTermChangesFromBatch (const LayerGeometry&) const noexcept;
+    void  insertScrolledLine (FTermRegion*, int, const FChar&) const noexcept;
     void  scrollTerminalForward() const;
     void  scrollTerminalReverse() const;
     void  callPreprocessingHandler (const FTermRegion*) const;
@@ -376,7 +395,6 @@ class FVTerm : public FVTermAttribute
     void  initFromGlobalInstance();
     void  initSettings();
     void  finish() const;
-    void  saveCurrentVTerm() const noexcept;
     void  putRegionLine (const FChar&, FChar&, const int) const noexcept;
     void  applyColorOverlay (const FChar&, FChar&) const;
     void  inheritBackground (const FChar&, FChar&) const;
@@ -384,7 +402,6 @@ class FVTerm : public FVTermAttribute
     void  putRegionLineWithTransparency (FChar_const_iterator, FChar_iterator, const int, FPoint, bool) const;
     void  addRegionLineWithTransparency (FChar_const_iterator, FChar_iterator, const int) const;
     void  addTransparentRegionLine (const FChar_const_iterator&, const FChar_iterator&, const int) const;
-    void  addTransparentRegionChar (const FChar&, FChar&) const;
     auto  clearFullRegion (FTermRegion*, FChar&) const -> bool;
     void  clearRegionWithShadow (FTermRegion*, const FChar&) const noexcept;
     auto  printWrap (FTermRegion*, FChar_iterator&) const -> bool;
@@ -399,7 +416,7 @@ class FVTerm : public FVTermAttribute
     void  addVDesktopToListIfExists (FTermRegionList&) const;
     void  determineCoveredRegions (FTermRegion*) const;
     void  resetLineCoveredState (FTermRegion*) const;
-    void  determineLineCoveredState (const FTermRegion* const, FTermRegion*) const noexcept;
+    void  determineLineCoveredState (int, int, FTermRegion*) const noexcept;
     auto  canUpdateTerminalNow() const -> bool;
     static auto hasPendingUpdates (const FTermRegion*) noexcept -> bool;
 
@@ -416,7 +433,7 @@ class FVTerm : public FVTermAttribute
     std::shared_ptr<FOutput>      foutput{};                    // Terminal output class
     std::shared_ptr<FVTermList>   vterm_window_list{};          // List of all window owner in z-order
     std::shared_ptr<FTermRegion>  vterm{};                      // Virtual terminal
-    std::shared_ptr<FTermRegion>  vterm_old{};                  // Last virtual terminal
+    std::shared_ptr<FCompactRegion> vterm_old{};                // Last virtual terminal
     std::shared_ptr<FTermRegion>  vdesktop{};                   // Virtual desktop
     static FTermRegion*           active_region;                // Active region
     static int                    tabstop;
@@ -439,10 +456,40 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
 {
   struct FLineChanges
   {
-    uInt xmin;         // X-position with the first change
-    uInt xmax;         // X-position with the last change
-    uInt trans_count;  // Number of transparent characters
-    bool covered;      // Line cover state
+    // Constants
+    static constexpr std::size_t MAX_SPANS = 4;  // Damage spans per line
+    static constexpr uInt SPAN_MERGE_GAP = 8;    // Smaller gaps are merged
+
+    struct FSpan
+    {
+      uInt xmin;  // X-position with the first change of the span
+      uInt xmax;  // X-position with the last change of the span
+    };
+
+    // Using-declaration
+    using FSpanList = std::array<FSpan, MAX_SPANS>;
+
+    // Accessors
+    auto getSpanCount() const noexcept -> std::size_t;
+    auto getSpan (std::size_t) const noexcept -> FSpan;
+
+    // Inquiry
+    auto hasValidSpans() const noexcept -> bool;
+
+    // Methods
+    void addSpan (uInt, uInt) noexcept;
+    void setSpan (uInt, uInt) noexcept;
+    void setSpans (const FSpanList&, std::size_t, uInt) noexcept;
+    void clear (uInt) noexcept;
+    void setEmpty (uInt) noexcept;
+
+    // Data members
+    uInt      xmin;             // X-position with the first change
+    uInt      xmax;             // X-position with the last change
+    uInt      trans_count;      // Number of transparent characters
+    bool      covered;          // Line cover state
+    uInt8     span_count{0};    // Number of used damage spans
+    FSpanList spans{};          // Sorted, disjoint damage spans
   };
 
   struct FRowChanges
@@ -451,9 +498,18 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
     uInt ymax;         // Y-position with the last change
   };
 
+  // Enumeration
+  enum class Opacity : uInt8
+  {
+    Opaque,  // No transparent characters
+    Shadow,  // Transparent characters only in the shadow
+    Mixed    // Transparent characters inside the region
+  };
+
   // Using-declaration
   using FDataAccessPtr        = std::shared_ptr<FDataAccess>;
   using FLineChangesVec       = std::vector<FLineChanges>;
+  using FRowOffsets           = std::vector<std::size_t>;
   using FCharVec              = std::vector<FChar>;
   using FChar_reference       = FCharVec::reference;
   using FChar_const_reference = FCharVec::const_reference;
@@ -500,15 +556,18 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   constexpr auto isOverlapped (const FTermRegion*) const noexcept -> bool;
   constexpr auto isPrintPositionInsideRegion() const noexcept -> bool;
   auto reprint (const FRect&, const FSize&) noexcept -> bool;
+  auto getOpacity() const noexcept -> Opacity;
+  auto getLineOpacity (int) const noexcept -> Opacity;
+  void invalidateOpacity() noexcept;
 
   inline auto getFChar (int x, int y) const noexcept -> FChar_const_reference
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[row_offsets[unsigned(y)] + unsigned(x)];
   }
 
   inline auto getFChar (int x, int y) noexcept -> FChar_reference
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[row_offsets[unsigned(y)] + unsigned(x)];
   }
 
   inline auto getFChar (const FPoint& pos) const noexcept -> FChar_const_reference
@@ -523,12 +582,20 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
 
   inline auto getFCharIterator (int x, int y) const noexcept -> FChar_const_iterator
   {
-    return data.cbegin() + (unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x));
+    return data.cbegin() + std::ptrdiff_t(row_offsets[unsigned(y)] + unsigned(x));
   }
 
   inline auto getFCharIterator (int x, int y) noexcept -> FChar_iterator
   {
-    return data.begin() + (unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x));
+    return data.begin() + std::ptrdiff_t(row_offsets[unsigned(y)] + unsigned(x));
+  }
+
+  inline auto getCursorIterator() noexcept -> FChar_iterator
+  {
+    // Lines outside the region have no offset (not dereferenceable)
+    const auto y = unsigned(cursor.y - 1);
+    return ( y < row_offsets.size() ) ? getFCharIterator(cursor.x - 1, int(y))
+                                      : data.end();
   }
 
   constexpr void setCursorPos (int x, int y) noexcept
@@ -553,6 +620,9 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   }
 
   void updateRegionChanges (uInt, uInt, uInt8) noexcept;
+  void resetRowOffsets();
+  void rotateRows (int) noexcept;
+  auto determineOpacity() const noexcept -> Opacity;
 
   // Data members
   struct Coordinate
@@ -579,10 +649,13 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   bool            has_changes{false};
   bool            visible{false};
   bool            minimized{false};
+  mutable bool    opacity_changed{true};
+  mutable Opacity opacity{Opacity::Opaque};  // Cached getOpacity() result
   FDataAccessPtr  owner{nullptr};        // Object that owns this FTermRegion
   FPreprocVector  preproc_list{};
   FRowChanges     changes_in_row{};
   FLineChangesVec changes_in_line{};
+  FRowOffsets     row_offsets{};         // Data offset of each line
   FCharVec        data{};                // FChar data of the drawing region
 };
 
@@ -696,8 +769,7 @@ inline auto FVTerm::FTermRegion::reprint ( const FRect& box
 
   while  ( line_changes <= line_changes_end )  // Line loop
   {
-    line_changes->xmin = std::min(line_changes->xmin, uInt(x_start));
-    line_changes->xmax = std::max(line_changes->xmax, uInt(x_end));
+    line_changes->addSpan (uInt(x_start), uInt(x_end));
     ++line_changes;
   }
 
@@ -706,20 +778,538 @@ inline auto FVTerm::FTermRegion::reprint ( const FRect& box
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermRegion::FLineChanges::getSpanCount() const noexcept -> std::size_t
+{
+  if ( xmin > xmax )  // No changes
+    return 0;
+
+  return hasValidSpans() ? std::size_t(span_count) : 1;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermRegion::FLineChanges::getSpan (std::size_t index) const noexcept -> FSpan
+{
+  // Without a valid span list, the bounding range is the only span
+
+  return hasValidSpans() ? spans[index] : FSpan{xmin, xmax};
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermRegion::FLineChanges::hasValidSpans() const noexcept -> bool
+{
+  // The span list is only valid if it matches the bounding range.
+  // A direct xmin/xmax assignment thus falls back to one span.
+
+  return span_count > 0
+      && spans[0].xmin == xmin
+      && spans[span_count - 1].xmax == xmax;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::FLineChanges::addSpan (uInt x_start, uInt x_end) noexcept
+{
+  // Marks the x-positions from x_start to x_end as changed
+
+  if ( x_start > x_end )
+    return;
+
+  if ( xmin > xmax )  // Line without changes
+  {
+    setSpan (x_start, x_end);
+    return;
+  }
+
+  if ( ! hasValidSpans() )
+  {
+    spans[0] = {xmin, xmax};
+    span_count = 1;
+  }
+
+  auto& last = spans[span_count - 1];
+
+  if ( x_start >= last.xmin && x_start <= last.xmax + SPAN_MERGE_GAP + 1 )
+  {
+    // Fast path: Extend the last span (printing from left to right)
+    last.xmax = std::max(last.xmax, x_end);
+    xmax = last.xmax;
+    return;
+  }
+
+  // Copy all spans in ascending order and merge the close ones
+  std::array<FSpan, MAX_SPANS + 1> merged{};
+  FSpan new_span{x_start, x_end};
+  std::size_t count{0};
+  std::size_t index{0};
+
+  while ( index < span_count && spans[index].xmax + SPAN_MERGE_GAP + 1 < x_start )
+  {
+    merged[count] = spans[index];
+    count++;
+    index++;
+  }
+
+  while ( index < span_count && spans[index].xmin <= x_end + SPAN_MERGE_GAP + 1 )
+  {
+    new_span.xmin = std::min(new_span.xmin, spans[index].xmin);
+    new_span.xmax = std::max(new_span.xmax, spans[index].xmax);
+    index++;
+  }
+
+  merged[count] = new_span;
+  count++;
+
+  while ( index < span_count )
+  {
+    merged[count] = spans[index];
+    count++;
+    index++;
+  }
+
+  if ( count > MAX_SPANS )
+  {
+    // Join the two spans with the smallest gap
+    std::size_t join{0};
+
+    for (std::size_t i{1}; i + 1 < count; i++)
+    {
+      if ( merged[i + 1].xmin - merged[i].xmax
+         < merged[join + 1].xmin - merged[join].xmax )
+        join = i;
+    }
+
+    merged[join].xmax = merged[join + 1].xmax;
+    std::copy (&merged[join + 2], &merged[count], &merged[join + 1]);
+    count--;
+  }
+
+  std::copy (&merged[0], &merged[count], spans.begin());
+  span_count = uInt8(count);
+  xmin = spans[0].xmin;
+  xmax = spans[count - 1].xmax;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::FLineChanges::setSpan (uInt x_start, uInt x_end) noexcept
+{
+  // Replaces all changes with one span
+
+  spans[0] = {x_start, x_end};
+  span_count = 1;
+  xmin = x_start;
+  xmax = x_end;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::FLineChanges::setSpans ( const FSpanList& span_list
+                                                        , std::size_t count
+                                                        , uInt width ) noexcept
+{
+  // Replaces all changes with the given sorted spans
+
+  if ( count == 0 )
+  {
+    clear(width);
+    return;
+  }
+
+  spans = span_list;
+  span_count = uInt8(count);
+  xmin = spans[0].xmin;
+  xmax = spans[count - 1].xmax;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::FLineChanges::clear (uInt width) noexcept
+{
+  xmin = width;
+  xmax = 0;
+  span_count = 0;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::FLineChanges::setEmpty (uInt xpos) noexcept
+{
+  // Empty range (xmin = xmax + 1) at the x-position xpos > 0
+
+  xmin = xpos;
+  xmax = xpos - 1;
+  span_count = 0;
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::FTermRegion::updateRegionChanges ( uInt x, uInt y
                                                      , uInt8 char_width ) noexcept
 {
-  auto& line_changes = changes_in_line[y];
   const uInt x_end = x + uInt( char_width >> 1 );
-
-  line_changes.xmin = std::min(line_changes.xmin, x);
-  line_changes.xmax = std::max(line_changes.xmax, x_end);
+  changes_in_line[y].addSpan (x, x_end);
 
   changes_in_row.ymin = std::min(changes_in_row.ymin, y);
   changes_in_row.ymax = std::max(changes_in_row.ymax, y);
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::resetRowOffsets()
+{
+  // Stores the lines one after the other in the data vector
+
+  const auto full_width = std::size_t(size.width + shadow.width);
+  const auto full_height = std::size_t(size.height + shadow.height);
+  row_offsets.resize(full_height);
+  std::size_t offset{0};
+
+  for (auto& row_offset : row_offsets)
+  {
+    row_offset = offset;
+    offset += full_width;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::rotateRows (int distance) noexcept
+{
+  // Rotates the lines above the bottom shadow like a ring buffer
+  // (distance > 0: up, distance < 0: down). The line data and the
+  // line changes keep their positions relative to each other.
+
+  const auto height = std::ptrdiff_t(size.height);
+
+  if ( height < 2 || distance == 0 || std::abs(distance) >= height )
+    return;
+
+  const auto row_iter = row_offsets.begin();
+  const auto line_iter = changes_in_line.begin();
+  const auto middle = ( distance > 0 ) ? distance : height + distance;
+  std::rotate (row_iter, row_iter + middle, row_iter + height);
+  std::rotate (line_iter, line_iter + middle, line_iter + height);
+}
+
+
+//----------------------------------------------------------------------
+// struct FVTerm::FCompactRegion
+//----------------------------------------------------------------------
+
+struct FVTerm::FCompactRegion  // Compact copy of the last terminal frame
+{
+  // Using-declarations
+  using FCompactCharVec = std::vector<FCompactChar>;
+  using FGraphemePool   = std::vector<FUnicode>;
+
+  // Methods
+  auto resize (const FSize&) -> bool;
+  void save (const FTermRegion&);
+  void saveOutputLines (const FTermRegion&);
+  void saveLine (const FTermRegion&, int);
+  void keepLine (const FGraphemePool&, int);
+  auto isEqual (std::size_t, const FChar&) const noexcept -> bool;
+  auto countChanges (const FTermRegion&, int) const noexcept -> std::size_t;
+  auto getLineHash (int) const noexcept -> uInt64;
+  static auto getLineHash (const FTermRegion&, int) noexcept -> uInt64;
+  void scrollLines (int, int, int) noexcept;
+  static constexpr auto addToHash (uInt64, uInt64, uInt32) noexcept -> uInt64;
+  static auto getGraphemeCode (const FUnicode&) noexcept -> uInt32;
+
+  // Data members
+  FTermRegion::Dimension size{0, 0};   // Width and height
+  FCompactCharVec        data{};       // Compact character data
+  FGraphemePool          graphemes{};  // Characters with combining characters
+};
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::resize (const FSize& new_size) -> bool
+{
+  const auto width = int(new_size.getWidth());
+  const auto height = int(new_size.getHeight());
+
+  if ( size.width == width && size.height == height )
+    return false;
+
+  size = {width, height};
+  data.resize(new_size.getArea());
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCompactRegion::save (const FTermRegion& region)
+{
+  // Stores the region characters in the compact cell format
+
+  graphemes.clear();
+
+  if ( data.size() != region.data.size() )
+    data.resize(region.data.size());
+
+  const auto height = int(region.row_offsets.size());
+
+  for (int y{0}; y < height; y++)  // Lines in display order
+    saveLine (region, y);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCompactRegion::saveOutputLines (const FTermRegion& region)
+{
+  // Stores only the lines that have been output to the terminal.
+  // Lines with deferred changes keep their last output content.
+
+  const auto height = int(region.row_offsets.size());
+  const auto changes_begin = region.changes_in_line.cbegin();
+  const auto changes_end = changes_begin + height;
+  const auto is_deferred = [] (const auto& line_changes) noexcept
+                           {
+                             return line_changes.xmin <= line_changes.xmax;
+                           };
+
+  if ( data.size() != region.data.size()
+    || std::none_of(changes_begin, changes_end, is_deferred) )
+  {
+    save(region);
+    return;
+  }
+
+  FGraphemePool old_graphemes{};
+  old_graphemes.swap(graphemes);
+
+  for (int y{0}; y < height; y++)
+  {
+    const auto& line_changes = region.changes_in_line[unsigned(y)];
+
+    if ( is_deferred(line_changes) )
+      keepLine (old_graphemes, y);
+    else
+      saveLine (region, y);
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCompactRegion::saveLine (const FTermRegion& region, int y)
+{
+  const auto width = std::ptrdiff_t(region.size.width + region.shadow.width);
+  auto cell = data.begin() + std::ptrdiff_t(y) * width;
+  auto iter = region.data.cbegin() + std::ptrdiff_t(region.row_offsets[unsigned(y)]);
+  const auto end = iter + width;
+
+  for (; iter != end; ++iter)
+  {
+    const auto& fchar = *iter;
+    auto code = uInt32(fchar.ch.unicode_data[0]);
+
+    if ( fchar.ch.unicode_data[1] != L'\0' )  // Combining characters
+    {
+      code = FCompactChar::GRAPHEME_FLAG | uInt32(graphemes.size());
+      graphemes.push_back(fchar.ch);
+    }
+
+    cell->set (code, fchar.attr.data, fchar.color.data);
+    ++cell;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCompactRegion::keepLine ( const FGraphemePool& old_graphemes
+                                             , int y )
+{
+  // Keeps the content of line y and moves its graphemes
+  // from the old pool into the current pool
+
+  auto cell = data.begin() + std::ptrdiff_t(y) * size.width;
+  const auto end = cell + size.width;
+
+  for (; cell != end; ++cell)
+  {
+    if ( ! cell->isGrapheme() )
+      continue;
+
+    const auto code = FCompactChar::GRAPHEME_FLAG | uInt32(graphemes.size());
+    graphemes.push_back(old_graphemes[cell->getGraphemeIndex()]);
+    cell->glyph_attr = (cell->glyph_attr & ~uInt64(0xffffffffU)) | code;
+  }
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::isEqual ( std::size_t index
+                                            , const FChar& fchar ) const noexcept -> bool
+{
+  const auto& cell = data[index];
+
+  if ( cell.color != fchar.color.data )
+    return false;
+
+  constexpr auto mask = getCompareBitMask();
+  const auto style = uInt64(fchar.attr.data & mask) << 32;
+
+  if ( fchar.ch.unicode_data[1] == L'\0' )
+    return cell.glyph_attr == (style | uInt32(fchar.ch.unicode_data[0]));
+
+  return cell.isGrapheme()
+      && (cell.glyph_attr & ~uInt64(0xffffffffU)) == style
+      && graphemes[cell.getGraphemeIndex()] == fchar.ch;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::countChanges ( const FTermRegion& region
+                                                 , int y ) const noexcept -> std::size_t
+{
+  // Returns the number of characters in line y that differ from the region
+
+  const auto width = std::size_t(size.width);
+  auto index = std::size_t(y) * width;
+  const auto end = index + width;
+  auto iter = region.getFCharIterator(0, y);
+  std::size_t changes{0};
+
+  while ( index < end )
+  {
+    if ( ! isEqual(index, *iter) )
+      changes++;
+
+    ++index;
+    ++iter;
+  }
+
+  return changes;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::getLineHash (int y) const noexcept -> uInt64
+{
+  // Identical lines have the same hash value in the compact copy
+  // and in a region (see below)
+
+  uInt64 hash{0xcbf29ce484222325U};
+  auto cell = data.cbegin() + std::ptrdiff_t(y) * size.width;
+  const auto end = cell + size.width;
+
+  while ( cell < end )
+  {
+    auto glyph_attr = cell->glyph_attr;
+
+    if ( cell->isGrapheme() )  // Replace the pool index
+    {
+      const auto& ch = graphemes[cell->getGraphemeIndex()];
+      glyph_attr = (glyph_attr & ~uInt64(0xffffffffU)) | getGraphemeCode(ch);
+    }
+
+    hash = addToHash (hash, glyph_attr, cell->color);
+    ++cell;
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::getLineHash ( const FTermRegion& region
+                                                , int y ) noexcept -> uInt64
+{
+  constexpr auto mask = getCompareBitMask();
+  uInt64 hash{0xcbf29ce484222325U};
+  auto iter = region.getFCharIterator(0, y);
+  const auto end = iter + region.size.width;
+
+  while ( iter < end )
+  {
+    const auto code = ( iter->ch.unicode_data[1] == L'\0' )
+                    ? uInt32(iter->ch.unicode_data[0])
+                    : getGraphemeCode(iter->ch);
+    const auto glyph_attr = (uInt64(iter->attr.data & mask) << 32) | code;
+    hash = addToHash (hash, glyph_attr, iter->color.data);
+    ++iter;
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCompactRegion::scrollLines ( int top, int bottom
+                                                , int distance ) noexcept
+{
+  // Moves the lines from top to bottom in the same way as the terminal
+  // scrolls them (distance > 0: up, distance < 0: down). The content of
+  // the exposed lines is unknown afterwards.
+
+  const auto width = std::ptrdiff_t(size.width);
+  const auto first = data.begin() + top * width;
+  const auto last = data.begin() + (bottom + 1) * width;
+  const auto offset = std::ptrdiff_t(std::abs(distance)) * width;
+  FCompactChar unknown{};
+  unknown.glyph_attr = FCompactChar::UNKNOWN_CODE;
+
+  if ( distance > 0 )
+  {
+    std::copy (first + offset, last, first);
+    std::fill (last - offset, last, unknown);
+  }
+  else
+  {
+    std::copy_backward (first, last - offset, last);
+    std::fill (first, first + offset, unknown);
+  }
+}
+
+//----------------------------------------------------------------------
+constexpr auto FVTerm::FCompactRegion::addToHash ( uInt64 hash
+                                                 , uInt64 glyph_attr
+                                                 , uInt32 color ) noexcept -> uInt64
+{
+  // FNV-1a style mixing of the character and the color
+  constexpr uInt64 prime{0x100000001b3U};
+  return (((hash ^ glyph_attr) * prime) ^ color) * prime;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCompactRegion::getGraphemeCode (const FUnicode& ch) noexcept -> uInt32
+{
+  // Position-independent code for characters with combining characters
+
+  uInt32 code{2166136261U};
+
+  for (const auto& wc : ch.unicode_data)
+    code = (code ^ uInt32(wc)) * 16777619U;
+
+  return FCompactChar::GRAPHEME_FLAG | code;
+}
+
+
+//----------------------------------------------------------------------
+// struct FVTerm::FWindowIndex
+//----------------------------------------------------------------------
+
+struct FVTerm::FWindowIndex  // Geometry index of the visible windows
+{
+  struct Entry
+  {
+    FTermRegion* win;
+    int  x_min;    // Horizontal range [x_min, x_max)
+    int  x_max;
+    int  y_min;    // Vertical range [y_min, y_max)
+    int  y_max;
+    int  layer;
+    int  z;        // Position in the window list (bottom = 0)
+    int  max_end;  // Largest y_max in the interval tree subtree
+    bool visible;
+  };
+
+  // Using-declarations
+  using EntryList = std::vector<Entry>;
+  using ResultList = std::vector<const Entry*>;
+  using PositionMap = std::unordered_map<const FTermRegion*, int>;
+
+  // Methods
+  void invalidate() noexcept;
+  void update (const FVTermList&);
+  void build();
+  auto findOverlapping (const FTermRegion*) -> const ResultList&;
+  auto findPosition (const FTermRegion*) const noexcept -> int;
+  static auto makeEntry (FTermRegion*, int) noexcept -> Entry;
+
+  // Data members
+  EntryList   snapshot{};   // All windows in z-order
+  EntryList   tree{};       // Visible windows sorted by y_min
+  ResultList  results{};    // Overlapping windows from top to bottom
+  PositionMap positions{};  // Window list position of each region
+  int         max_level{-1};
+  bool        dirty{true};  // Geometry or z-order changed
+};
+
 
 //----------------------------------------------------------------------
 // struct FVTerm::FVTermPreprocessing
@@ -882,6 +1472,10 @@ inline auto FVTerm::getWindowList() noexcept -> FVTermList*
         : nullptr;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::getActiveRegion() noexcept -> const FTermRegion*
+{ return active_region; }
+
 //----------------------------------------------------------------------
 inline void FVTerm::setVWin (std::unique_ptr<FTermRegion>&& region) noexcept
 { vwin = std::move(region); }
@@ -1008,7 +1602,7 @@ inline void FVTerm::initFromGlobalInstance()
   foutput           = std::shared_ptr<FOutput>(init_object->foutput);
   vterm_window_list = std::shared_ptr<FVTermList>(init_object->vterm_window_list);
   vterm             = std::shared_ptr<FTermRegion>(init_object->vterm);
-  vterm_old         = std::shared_ptr<FTermRegion>(init_object->vterm_old);
+  vterm_old         = std::shared_ptr<FCompactRegion>(init_object->vterm_old);
   vdesktop          = std::shared_ptr<FTermRegion>(init_object->vdesktop);
 }
 
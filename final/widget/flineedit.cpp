@@ -20,6 +20,7 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <regex>
 
@@ -375,6 +376,48 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  if ( isReadOnly() )
+    return;
+
+  // Only the first line of the pasted text is inserted
+  auto input = pasteFilter(ev->getText());
+  ev->accept();
+
+  if ( input.isEmpty() )
+    return;
+
+  const auto len = text.getLength();
+  const auto max_input = ( insert_mode )
+                         ? max_length - std::min(len, max_length)
+                         : max_length - std::min(cursor_pos, max_length);
+
+  if ( input.getLength() > max_input )
+  {
+    FVTerm::getFOutput()->beep();
+    input = input.left(max_input);
+
+    if ( input.isEmpty() )
+      return;
+  }
+
+  if ( cursor_pos == len )
+    text += input;
+  else if ( insert_mode )
+    text.insert(input, cursor_pos);
+  else
+    text.overwrite(input, cursor_pos);
+
+  cursor_pos += input.getLength();
+  print_text = ( isPasswordField() ) ? getPasswordText() : text;
+  adjustTextOffset();
+  processChanged();
+  drawInputField();
+  forceTerminalUpdate();
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -1189,6 +1232,34 @@ inline auto FLineEdit::characterFilter (const wchar_t c) const -> wchar_t
   return L'\0';
 }
 
+//----------------------------------------------------------------------
+auto FLineEdit::pasteFilter (const FString& paste_text) const -> FString
+{
+  // Removes control characters and the characters rejected by the
+  // input filter. The regular expression is compiled only once.
+
+  const bool has_filter = ! input_filter.empty();
+  const auto regex = has_filter ? std::wregex(input_filter) : std::wregex();
+  std::wstring input{};
+  input.reserve(paste_text.getLength());
+
+  for (const auto& ch : paste_text)
+  {
+    if ( ch == L'\r' || ch == L'\n' )
+      break;  // End of the first line
+
+    if ( ch < L' ' || (ch >= 0x7f && ch < 0xa0) )
+      continue;  // Control character
+
+    if ( has_filter && ! std::regex_match(std::wstring(1, ch), regex) )
+      continue;
+
+    input.push_back(ch);
+  }
+
+  return FString{std::move(input)};
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::processActivate()
 {
@@ -167,6 +167,7 @@ class FLineEdit : public FWidget
 
     // Event handlers
     void onKeyPress (FKeyEvent*) override;
+    void onPaste (FPasteEvent*) override;
     void onMouseDown (FMouseEvent*) override;
     void onMouseUp (FMouseEvent*) override;
     void onMouseMove (FMouseEvent*) override;
@@ -229,6 +230,7 @@ class FLineEdit : public FWidget
     void switchInsertMode();
     void acceptInput();
     auto keyInput (FKey) -> bool;
+    auto pasteFilter (const FString&) const -> FString;
     auto characterFilter (const wchar_t) const -> wchar_t;
     void processActivate();
     void processChanged() const;
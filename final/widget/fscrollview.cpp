@@ -735,8 +735,8 @@ void FScrollView::copyToRegion()
 
     // Update line changes
     auto& line_changes = print_region->changes_in_line[unsigned(ay + y)];
-    line_changes.xmin = std::min({line_changes.xmin, line_start, max_limit});
-    line_changes.xmax = std::min(std::max(line_changes.xmax, line_end), max_limit);
+    line_changes.addSpan ( std::min(line_start, max_limit)
+                         , std::min(line_end, max_limit) );
   }
 
   print_region->changes_in_row = {0, uInt(y_end - 1)};
@@ -20,6 +20,8 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 
 #include "final/dialog/fdialog.h"
@@ -304,12 +306,22 @@ void FTextView::insert (const FString& str, int pos)
   if ( pos < 0 || pos >= int(getRows()) )
     pos = int(getRows());
 
-  for (auto&& line : splitTextLines(str))  // Line loop
+  // Insert all lines at once to move the following lines only once
+  auto text_lines = splitTextLines(str);
+  FTextViewList lines{};
+  lines.reserve(text_lines.size());
+  std::size_t max_width{0};
+
+  for (auto&& line : text_lines)  // Line loop
   {
-    processLine(std::move(line), pos);
-    pos++;
+    lines.emplace_back(processLine(std::move(line)));
+    max_width = std::max(max_width, getColumnWidth(lines.back().text));
   }
 
+  data.insert ( data.cbegin() + pos
+              , std::make_move_iterator(lines.begin())
+              , std::make_move_iterator(lines.end()) );
+  updateHorizontalScrollBar (max_width);
   updateVerticalScrollBar();
   processChanged();
 }
@@ -351,6 +363,29 @@ void FTextView::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FTextView::onPaste (FPasteEvent* ev)
+{
+  if ( ! isPasteable() )
+    return;
+
+  // The pasted text is appended in one piece with a single redraw
+  append (ev->getText().replace("\r\n", "\n").replace("\r", "\n"));
+  ev->accept();
+
+  if ( ! isShown() )
+    return;
+
+  const auto old_yoffset = yoffset;
+  scrollToEnd();
+
+  if ( yoffset == old_yoffset )
+    drawText();
+
+  drawScrollBars();
+  forceTerminalUpdate();
+}
+
 //----------------------------------------------------------------------
 void FTextView::onMouseDown (FMouseEvent* ev)
 {
@@ -865,14 +900,12 @@ inline auto FTextView::splitTextLines (const FString& str) const -> FStringList
 }
 
 //----------------------------------------------------------------------
-inline void FTextView::processLine (FString&& line, int pos)
+inline auto FTextView::processLine (FString&& line) -> FString
 {
-  line = line.removeBackspaces()
+  return line.removeBackspaces()
              .removeDel()
              .replaceControlCodes()
              .rtrim();
-  updateHorizontalScrollBar (getColumnWidth(line));
-  data.emplace (data.cbegin() + pos, std::move(line));
 }
 
 //----------------------------------------------------------------------
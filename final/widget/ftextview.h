@@ -201,6 +201,8 @@ class FTextView : public FWidget
     void setLines (T&&);
     void setSelectable (bool = true);
     void unsetSelectable();
+    void setPasteable (bool = true);
+    void unsetPasteable();
     void scrollToX (int);
     void scrollToY (int);
     void scrollTo (const FPoint&);
@@ -212,6 +214,7 @@ class FTextView : public FWidget
     // Predicate
     auto hasSelectedText() const -> bool;
     auto isSelectable() const -> bool;
+    auto isPasteable() const -> bool;
 
     // Methods
     void hide() override;
@@ -228,6 +231,7 @@ class FTextView : public FWidget
 
     // Event handlers
     void onKeyPress (FKeyEvent*) override;
+    void onPaste (FPasteEvent*) override;
     void onMouseDown (FMouseEvent*) override;
     void onMouseUp (FMouseEvent*) override;
     void onMouseMove (FMouseEvent*) override;
@@ -276,7 +280,7 @@ class FTextView : public FWidget
     auto useFDialogBorder() const -> bool;
     auto isPrintable (wchar_t) const -> bool;
     auto splitTextLines (const FString&) const -> FStringList;
-    void processLine (FString&&, int);
+    auto processLine (FString&&) -> FString;
     template<typename T1, typename T2>
     void setSelectionStartInt (T1&&, T2&&);
     template<typename T1, typename T2>
@@ -319,6 +323,7 @@ class FTextView : public FWidget
     bool            update_scroll_bar{true};
     bool            pass_to_dialog{false};
     bool            selectable{false};
+    bool            pasteable{false};
     int             scroll_repeat{100};
     int             xoffset{0};
     int             yoffset{0};
@@ -436,6 +441,14 @@ inline void FTextView::setSelectable (bool enable)
 inline void FTextView::unsetSelectable()
 { selectable = false; }
 
+//----------------------------------------------------------------------
+inline void FTextView::setPasteable (bool enable)
+{ pasteable = enable; }
+
+//----------------------------------------------------------------------
+inline void FTextView::unsetPasteable()
+{ pasteable = false; }
+
 //----------------------------------------------------------------------
 inline void FTextView::scrollTo (const FPoint& pos)
 { scrollTo(pos.getX(), pos.getY()); }
@@ -453,6 +466,10 @@ inline auto FTextView::hasSelectedText() const -> bool
 inline auto FTextView::isSelectable() const -> bool
 { return selectable; }
 
+//----------------------------------------------------------------------
+inline auto FTextView::isPasteable() const -> bool
+{ return pasteable; }
+
 //----------------------------------------------------------------------
 template <typename T>
 void FTextView::append (const std::initializer_list<T>& list)
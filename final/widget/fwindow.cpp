@@ -302,7 +302,10 @@ void FWindow::drawBorder()
 void FWindow::show()
 {
   if ( isVirtualWindow() )
+  {
     getVWin()->visible = true;
+    invalidateWindowIndex();
+  }
 
   FWidget::show();
 }
@@ -320,7 +323,10 @@ void FWindow::hide()
   }
 
   if ( isVirtualWindow() )
+  {
     virtual_win->visible = false;
+    invalidateWindowIndex();
+  }
 
   FWidget::hide();
   const auto& t_geometry = getTermGeometryWithShadow();
@@ -333,7 +339,10 @@ void FWindow::setX (int x, bool adjust)
   FWidget::setX (x, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->position.x = getTermX() - 1;
+    invalidateWindowIndex();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -343,7 +352,10 @@ void FWindow::setY (int y, bool adjust)
   FWidget::setY (y, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->position.y = getTermY() - 1;
+    invalidateWindowIndex();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -358,6 +370,7 @@ void FWindow::setPos (const FPoint& p, bool adjust)
     auto virtual_win = getVWin();
     virtual_win->position.x = getTermX() - 1;
     virtual_win->position.y = getTermY() - 1;
+    invalidateWindowIndex();
   }
 }
 
@@ -431,6 +444,8 @@ void FWindow::setGeometry ( const FPoint& p, const FSize& size, bool adjust)
 
     if ( getY() != old_y )
       getVWin()->position.y = getTermY() - 1;
+
+    invalidateWindowIndex();
   }
 }
 
@@ -444,6 +459,7 @@ void FWindow::move (const FPoint& pos)
     auto virtual_win = getVWin();
     virtual_win->position.x = getTermX() - 1;
     virtual_win->position.y = getTermY() - 1;
+    invalidateWindowIndex();
   }
 }
 
@@ -678,6 +694,7 @@ auto FWindow::minimizeWindow() -> bool
 
   const auto& virtual_win = getVWin();
   virtual_win->minimized = bool( ! isMinimized() );
+  invalidateWindowIndex();
   const auto& t_geometry = getTermGeometryWithShadow();
   restoreVTerm (t_geometry);
 
@@ -761,6 +778,8 @@ void FWindow::adjustSize()
 
     if ( getTermY() != old_y )
       getVWin()->position.y = getTermY() - 1;
+
+    invalidateWindowIndex();
   }
 }
 
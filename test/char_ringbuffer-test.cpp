@@ -47,6 +47,7 @@ class CharRingBufferTest : public CPPUNIT_NS::TestFixture
     void IteratorTest();
     void emplaceTest();
     void KeyStringTest();
+    void directWriteTest();
 
   private:
     // Adds code needed to register the test suite
@@ -60,6 +61,7 @@ class CharRingBufferTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (IteratorTest);
     CPPUNIT_TEST (emplaceTest);
     CPPUNIT_TEST (KeyStringTest);
+    CPPUNIT_TEST (directWriteTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -1067,6 +1069,46 @@ void CharRingBufferTest::KeyStringTest()
 }
 
 
+//----------------------------------------------------------------------
+void CharRingBufferTest::directWriteTest()
+{
+  finalcut::CharRingBuffer<8> char_rbuf{};
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 8 );
+
+  // Write three characters directly into the buffer memory
+  std::memcpy (char_rbuf.getWritePosition(), "abc", 3);
+  char_rbuf.commit(3);
+  CPPUNIT_ASSERT ( char_rbuf.getSize() == 3 );
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'c' );
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 5 );
+  CPPUNIT_ASSERT ( std::string(char_rbuf.begin(), char_rbuf.end()) == "abc" );
+
+  // The free space ends at the end of the memory
+  char_rbuf.pop(2);
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 5 );
+  std::memcpy (char_rbuf.getWritePosition(), "defgh", 5);
+  char_rbuf.commit(5);
+  CPPUNIT_ASSERT ( char_rbuf.getSize() == 6 );
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'h' );
+
+  // After the wrap-around, the free space ends at the first character
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 2 );
+  std::memcpy (char_rbuf.getWritePosition(), "ijk", 2);
+  char_rbuf.commit(3);  // Limited to the free space
+  CPPUNIT_ASSERT ( char_rbuf.isFull() );
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'j' );
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 0 );
+  CPPUNIT_ASSERT ( std::string(char_rbuf.begin(), char_rbuf.end()) == "cdefghij" );
+
+  // Nothing is appended to a full buffer
+  char_rbuf.commit(1);
+  CPPUNIT_ASSERT ( char_rbuf.getSize() == 8 );
+  CPPUNIT_ASSERT ( char_rbuf.front() == 'c' );
+
+  char_rbuf.clear();
+  CPPUNIT_ASSERT ( char_rbuf.getContiguousFreeSpace() == 8 );
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (CharRingBufferTest);
 
@@ -35,6 +35,7 @@
 #include <sys/mman.h>
 
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 #include <final/final.h>
@@ -172,6 +173,8 @@ class ConEmu
     auto  getDA (console) const noexcept -> const char*;
     auto  getDA1 (console) const noexcept -> const char*;
     auto  getSEC_DA (console) const noexcept -> const char*;
+    auto  getSyncOutputMode (console) const noexcept -> const char*;
+    auto  getKeyboardFlags (console) const noexcept -> const char*;
 
     // Methods
     auto  openMasterPTY() -> bool;
@@ -185,6 +188,7 @@ class ConEmu
     auto  isValidFileDescriptor (int) const noexcept -> bool;
     void  writeToMaster (const char*, std::size_t) noexcept;
     void  writeToStdout (const char*, std::size_t) noexcept;
+    void  writeColorName (const char*, std::size_t, int) noexcept;
     void  parseTerminalBuffer (std::size_t, console) noexcept;
 
     // Data members
@@ -841,6 +845,72 @@ inline auto ConEmu::getSEC_DA (console con) const noexcept -> const char*
   return sec_da[static_cast<std::size_t>(con)];
 }
 
+//----------------------------------------------------------------------
+inline auto ConEmu::getSyncOutputMode (console con) const noexcept -> const char*
+{
+  static ConsoleStringTableType sync_output_mode
+  {{
+    nullptr,                          // Ansi,
+    C_STR("\033[?2026;0$y"),          // XTerm
+    nullptr,                          // Rxvt
+    nullptr,                          // Urxvt
+    nullptr,                          // KDE Konsole
+    nullptr,                          // GNOME Terminal
+    C_STR("\033[?2026;0$y"),          // VTE Terminal >= 0.53.0
+    nullptr,                          // PuTTY
+    C_STR("\033[?2026;2$y"),          // Windows Terminal >= 1.2
+    nullptr,                          // Tera Term
+    nullptr,                          // Cygwin
+    C_STR("\033[?2026;2$y"),          // Mintty
+    nullptr,                          // st - simple terminal
+    nullptr,                          // Linux console
+    nullptr,                          // FreeBSD console
+    nullptr,                          // NetBSD console
+    nullptr,                          // OpenBSD console
+    nullptr,                          // Sun console
+    nullptr,                          // screen
+    nullptr,                          // tmux
+    nullptr,                          // kterm
+    nullptr,                          // mlterm - Multi Lingual TERMinal
+    C_STR("\033[?2026;2$y")           // kitty
+  }};
+
+  return sync_output_mode[static_cast<std::size_t>(con)];
+}
+
+//----------------------------------------------------------------------
+inline auto ConEmu::getKeyboardFlags (console con) const noexcept -> const char*
+{
+  static ConsoleStringTableType keyboard_flags
+  {{
+    nullptr,                          // Ansi,
+    nullptr,                          // XTerm
+    nullptr,                          // Rxvt
+    nullptr,                          // Urxvt
+    nullptr,                          // KDE Konsole
+    nullptr,                          // GNOME Terminal
+    nullptr,                          // VTE Terminal >= 0.53.0
+    nullptr,                          // PuTTY
+    nullptr,                          // Windows Terminal >= 1.2
+    nullptr,                          // Tera Term
+    nullptr,                          // Cygwin
+    nullptr,                          // Mintty
+    nullptr,                          // st - simple terminal
+    nullptr,                          // Linux console
+    nullptr,                          // FreeBSD console
+    nullptr,                          // NetBSD console
+    nullptr,                          // OpenBSD console
+    nullptr,                          // Sun console
+    nullptr,                          // screen
+    nullptr,                          // tmux
+    nullptr,                          // kterm
+    nullptr,                          // mlterm - Multi Lingual TERMinal
+    C_STR("\033[?0u")                 // kitty
+  }};
+
+  return keyboard_flags[static_cast<std::size_t>(con)];
+}
+
 //----------------------------------------------------------------------
 inline auto ConEmu::openMasterPTY() -> bool
 {
@@ -1050,6 +1120,29 @@ inline void ConEmu::writeToStdout (const char* data, std::size_t length) noexcep
   }
 }
 
+//----------------------------------------------------------------------
+inline void ConEmu::writeColorName ( const char* index, std::size_t index_length
+                                   , int color_index ) noexcept
+{
+  // Sends the color name answer with a single write,
+  // so that the reader never receives an incomplete answer
+
+  std::array<char, 32> answer{};
+  std::size_t pos{0};
+  auto append = [&answer, &pos] (const char* data, std::size_t length)
+  {
+    std::memcpy (&answer[pos], data, length);
+    pos += length;
+  };
+
+  append ("\033]4;", 4);
+  append (index, index_length);
+  append (";rgb:", 5);
+  append (colorname[std::size_t(color_index)], 14);
+  append ("\a", 1);
+  writeToMaster(answer.data(), pos);
+}
+
 //----------------------------------------------------------------------
 inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexcept
 {
@@ -1134,6 +1227,26 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
 
       i += 3;  // Skip the sequence
     }
+    else if ( i + 8 < length  // Request synchronized output mode - ESC [ ? 2 0 2 6 $ p
+           && std::memcmp(&buffer[i], "\033[?2026$p", 9) == 0 )
+    {
+      const char* sync_output_mode = getSyncOutputMode(con);
+
+      if ( sync_output_mode )
+        writeToMaster(sync_output_mode, std::strlen(sync_output_mode));
+
+      i += 8;  // Skip the sequence
+    }
+    else if ( i + 3 < length  // Query keyboard protocol flags - ESC [ ? u
+           && std::memcmp(&buffer[i], "\033[?u", 4) == 0 )
+    {
+      const char* keyboard_flags = getKeyboardFlags(con);
+
+      if ( keyboard_flags )
+        writeToMaster(keyboard_flags, std::strlen(keyboard_flags));
+
+      i += 3;  // Skip the sequence
+    }
     else if ( i + 4 < length  // Report xterm window's title - ESC [ 2 1 t
            && buffer[i] == '\033'
            && buffer[i + 1] == '['
@@ -1195,11 +1308,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
         && con != console::kterm )
       {
         const int color_index = buffer[i + 4] - '0';
-        writeToMaster("\033]4;", 4);
-        writeToMaster(&buffer[i + 4], 1);
-        writeToMaster(";rgb:", 5);
-        writeToMaster(colorname[color_index], 14);
-        writeToMaster("\a", 1);
+        writeColorName (&buffer[i + 4], 1, color_index);
       }
 
       i += 7;  // Skip the sequence
@@ -1234,12 +1343,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
       {
         const int color_index = (buffer[i + 4] - '0') * 10
                               + (buffer[i + 5] - '0');
-        writeToMaster("\033]4;", 4);
-        writeToMaster(&buffer[i + 4], 1);
-        writeToMaster(&buffer[i + 5], 1);
-        writeToMaster(";rgb:", 5);
-        writeToMaster(colorname[color_index], 14);
-        writeToMaster("\a", 1);
+        writeColorName (&buffer[i + 4], 2, color_index);
       }
 
       i += 8;  // Skip the sequence
@@ -1279,13 +1383,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
 
         if ( color_index < 256 )
         {
-          writeToMaster("\033]4;", 4);
-          writeToMaster(&buffer[i + 4], 1);
-          writeToMaster(&buffer[i + 5], 1);
-          writeToMaster(&buffer[i + 6], 1);
-          writeToMaster(";rgb:", 5);
-          writeToMaster(colorname[color_index], 14);
-          writeToMaster("\a", 1);
+          writeColorName (&buffer[i + 4], 3, color_index);
         }
       }
 
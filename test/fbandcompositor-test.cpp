@@ -0,0 +1,210 @@
+/***********************************************************************
+* fbandcompositor-test.cpp - FBandCompositor unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <atomic>
+#include <system_error>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FBandCompositorTest
+//----------------------------------------------------------------------
+
+class FBandCompositorTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FBandCompositorTest() = default;
+
+  protected:
+    void noArgumentTest();
+    void threadCountTest();
+    void bandCountTest();
+    void runTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FBandCompositorTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (threadCountTest);
+    CPPUNIT_TEST (bandCountTest);
+    CPPUNIT_TEST (runTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FBandCompositorTest::noArgumentTest()
+{
+  finalcut::FBandCompositor compositor{};
+  CPPUNIT_ASSERT ( compositor.getThreadCount() == 1 );
+  CPPUNIT_ASSERT ( ! compositor.isParallel() );
+  CPPUNIT_ASSERT ( compositor.getMinimumBandSize()
+                   == finalcut::FBandCompositor::DEFAULT_MIN_BAND_SIZE );
+  CPPUNIT_ASSERT ( compositor.getBandCount(1000, 1000) == 1 );
+
+  // Without workers the function is called once for all rows
+  std::vector<int> calls{};
+  compositor.run ( 3, 20, 80
+                 , [&calls] (int begin, int end)
+                   {
+                     calls.push_back(begin);
+                     calls.push_back(end);
+                   } );
+  CPPUNIT_ASSERT ( calls.size() == 2 );
+  CPPUNIT_ASSERT ( calls[0] == 3 );
+  CPPUNIT_ASSERT ( calls[1] == 20 );
+
+  // An empty row range does nothing
+  compositor.run (5, 5, 80, [&calls] (int, int) { calls.clear(); });
+  CPPUNIT_ASSERT ( calls.size() == 2 );
+}
+
+//----------------------------------------------------------------------
+void FBandCompositorTest::threadCountTest()
+{
+  finalcut::FBandCompositor compositor{};
+  compositor.setThreadCount (4);
+  CPPUNIT_ASSERT ( compositor.getThreadCount() == 4 );
+  CPPUNIT_ASSERT ( compositor.isParallel() );
+  compositor.setThreadCount (2);
+  CPPUNIT_ASSERT ( compositor.getThreadCount() == 2 );
+  compositor.setThreadCount (1000);
+  CPPUNIT_ASSERT ( compositor.getThreadCount()
+                   == finalcut::FBandCompositor::MAX_THREADS );
+  compositor.setThreadCount (1);
+  CPPUNIT_ASSERT ( compositor.getThreadCount() == 1 );
+  CPPUNIT_ASSERT ( ! compositor.isParallel() );
+
+  // 0 = number of hardware threads
+  compositor.setThreadCount (0);
+  CPPUNIT_ASSERT ( compositor.getThreadCount() >= 1 );
+  CPPUNIT_ASSERT ( compositor.getThreadCount()
+                   <= finalcut::FBandCompositor::MAX_THREADS );
+}
+
+//----------------------------------------------------------------------
+void FBandCompositorTest::bandCountTest()
+{
+  finalcut::FBandCompositor compositor{};
+  compositor.setThreadCount (4);
+  compositor.setMinimumBandSize (1000);
+  CPPUNIT_ASSERT ( compositor.getMinimumBandSize() == 1000 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(10, 80) == 1 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(25, 80) == 2 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(50, 80) == 4 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(500, 800) == 4 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(1, 100000) == 1 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(0, 80) == 1 );
+
+  // Not more bands than rows
+  compositor.setMinimumBandSize (0);
+  CPPUNIT_ASSERT ( compositor.getMinimumBandSize() == 1 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(3, 1) == 3 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(2, 1) == 2 );
+}
+
+//----------------------------------------------------------------------
+void FBandCompositorTest::runTest()
+{
+  finalcut::FBandCompositor compositor{};
+  compositor.setThreadCount (4);
+  compositor.setMinimumBandSize (1);
+
+  for (int rows{1}; rows < 40; rows++)
+  {
+    // Every row is visited exactly once
+    std::vector<std::atomic<int>> visits(std::size_t(rows + 10));
+    std::atomic<int> band_calls{0};
+    std::atomic<int> empty_bands{0};
+
+    compositor.run ( 10, 10 + rows, 1
+                   , [&visits, &band_calls, &empty_bands] (int begin, int end)
+                     {
+                       band_calls++;
+
+                       if ( begin >= end )
+                         empty_bands++;
+
+                       for (auto y{begin}; y < end; y++)
+                         visits[std::size_t(y)]++;
+                     } );
+
+    CPPUNIT_ASSERT ( band_calls == int(compositor.getBandCount(rows, 1)) );
+    CPPUNIT_ASSERT ( empty_bands == 0 );
+
+    for (std::size_t y{0}; y < visits.size(); y++)
+      CPPUNIT_ASSERT ( visits[y] == (y < 10 ? 0 : 1) );
+  }
+
+  // Repeated runs with changing thread count
+  std::vector<int> data(100, 0);
+
+  for (std::size_t threads{1}; threads <= 8; threads++)
+  {
+    compositor.setThreadCount (threads);
+
+    for (int n{0}; n < 50; n++)
+    {
+      compositor.run ( 0, 100, 1
+                     , [&data] (int begin, int end)
+                       {
+                         for (auto y{begin}; y < end; y++)
+                           data[std::size_t(y)]++;
+                       } );
+    }
+  }
+
+  for (const auto& value : data)
+    CPPUNIT_ASSERT ( value == 400 );
+
+  // A failed start throws before any band is composed
+  compositor.setThreadCount (4);
+  std::atomic<int> calls{0};
+  finalcut::FBandCompositor::simulateSystemError();
+  CPPUNIT_ASSERT_THROW ( compositor.run ( 0, 100, 1
+                                        , [&calls] (int, int) { calls++; } )
+                       , std::system_error );
+  finalcut::FBandCompositor::simulateSystemError (false);
+  CPPUNIT_ASSERT ( calls == 0 );
+
+  // The next run works again
+  compositor.run (0, 100, 1, [&calls] (int, int) { calls++; });
+  CPPUNIT_ASSERT ( calls == int(compositor.getBandCount(100, 1)) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FBandCompositorTest);
+
+// The general unit test main part
+#include <main-test.inc>
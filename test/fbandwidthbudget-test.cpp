@@ -0,0 +1,186 @@
+/***********************************************************************
+* fbandwidthbudget-test.cpp - FBandwidthBudget unit tests              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FBandwidthBudgetTest
+//----------------------------------------------------------------------
+
+class FBandwidthBudgetTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FBandwidthBudgetTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void baudRateTest();
+    void blockingWriteTest();
+    void fastWriteTest();
+    void frameBudgetTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FBandwidthBudgetTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (baudRateTest);
+    CPPUNIT_TEST (blockingWriteTest);
+    CPPUNIT_TEST (fastWriteTest);
+    CPPUNIT_TEST (frameBudgetTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::classNameTest()
+{
+  const finalcut::FBandwidthBudget budget{};
+  const finalcut::FString& classname = budget.getClassName();
+  CPPUNIT_ASSERT ( classname == "FBandwidthBudget" );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::noArgumentTest()
+{
+  finalcut::FBandwidthBudget budget{};
+  CPPUNIT_ASSERT ( budget.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+  CPPUNIT_ASSERT ( budget.getFrameBudget(16'667) == 0 );
+
+  // Empty writes are not measured
+  budget.addSample (0, 50'000);
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+
+  // Fast writes keep the output unlimited
+  budget.addSample (100'000, 10);
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::baudRateTest()
+{
+  finalcut::FBandwidthBudget budget{};
+
+  // Pseudo terminals report 38400 baud
+  budget.setBaudRate (38'400);
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+  budget.setBaudRate (0);
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+
+  // 10 bits per byte on a serial line
+  budget.setBaudRate (9'600);
+  CPPUNIT_ASSERT ( budget.isLimited() );
+  CPPUNIT_ASSERT ( budget.getThroughput() == 960 );
+
+  budget.reset();
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+  CPPUNIT_ASSERT ( budget.getThroughput() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::blockingWriteTest()
+{
+  finalcut::FBandwidthBudget budget{};
+
+  // 10'000 bytes in 100 ms => 100'000 bytes per second
+  budget.addSample (10'000, 100'000);
+  CPPUNIT_ASSERT ( budget.isLimited() );
+  CPPUNIT_ASSERT ( budget.getThroughput() == 100'000 );
+
+  // The estimate follows the link slowly
+  budget.addSample (10'000, 200'000);  // 50'000 bytes per second
+  CPPUNIT_ASSERT ( budget.getThroughput() == 87'500 );
+
+  for (int i{0}; i < 50; i++)
+    budget.addSample (10'000, 200'000);
+
+  CPPUNIT_ASSERT ( budget.getThroughput() >= 50'000 );
+  CPPUNIT_ASSERT ( budget.getThroughput() < 50'100 );
+
+  // A blocking write faster than the maximum is not a link limit
+  finalcut::FBandwidthBudget fast_budget{};
+  fast_budget.addSample (100'000'000, 2'000'000);
+  CPPUNIT_ASSERT ( ! fast_budget.isLimited() );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::fastWriteTest()
+{
+  finalcut::FBandwidthBudget budget{};
+  budget.addSample (1'000, 100'000);  // 10'000 bytes per second
+  CPPUNIT_ASSERT ( budget.getThroughput() == 10'000 );
+
+  // A write without blocking probes for a higher throughput
+  budget.addSample (1'000, 100);
+  CPPUNIT_ASSERT ( budget.getThroughput() == 11'251 );
+  CPPUNIT_ASSERT ( budget.isLimited() );
+
+  // Without further blocking, the limit is removed
+  int count{0};
+
+  while ( budget.isLimited() && count < 1000 )
+  {
+    budget.addSample (1'000, 100);
+    count++;
+  }
+
+  CPPUNIT_ASSERT ( ! budget.isLimited() );
+  CPPUNIT_ASSERT ( count < 100 );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthBudgetTest::frameBudgetTest()
+{
+  finalcut::FBandwidthBudget budget{};
+  budget.addSample (100'000, 1'000'000);  // 100'000 bytes per second
+
+  // 60 Hz
+  CPPUNIT_ASSERT ( budget.getFrameBudget(16'667) == 1'666 );
+
+  // 5 Hz
+  CPPUNIT_ASSERT ( budget.getFrameBudget(200'000) == 20'000 );
+
+  // Each frame can output at least one small line
+  CPPUNIT_ASSERT ( budget.getFrameBudget(0) == finalcut::FBandwidthBudget::MIN_FRAME_BUDGET );
+  budget.reset();
+  budget.setBaudRate (300);  // 30 bytes per second
+  CPPUNIT_ASSERT ( budget.getFrameBudget(16'667) == finalcut::FBandwidthBudget::MIN_FRAME_BUDGET );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FBandwidthBudgetTest);
+
+// The general unit test main part
+#include <main-test.inc>
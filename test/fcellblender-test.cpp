@@ -0,0 +1,304 @@
+/***********************************************************************
+* fcellblender-test.cpp - FCellBlender unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto isInvisible (wchar_t ch) -> bool
+{
+  return ch == wchar_t(finalcut::UniChar::LowerHalfBlock)
+      || ch == wchar_t(finalcut::UniChar::UpperHalfBlock)
+      || ch == wchar_t(finalcut::UniChar::LeftHalfBlock)
+      || ch == wchar_t(finalcut::UniChar::RightHalfBlock)
+      || ch == wchar_t(finalcut::UniChar::MediumShade)
+      || ch == wchar_t(finalcut::UniChar::FullBlock);
+}
+
+//----------------------------------------------------------------------
+void referenceBlend (const finalcut::FChar& src_char, finalcut::FChar& dst_char)
+{
+  // Per-character transparency rules of the virtual terminal
+
+  using finalcut::FAttribute;
+
+  if ( src_char.isBitSet(FAttribute::set::transparent) )
+    return;
+
+  if ( src_char.isBitSet(FAttribute::set::color_overlay) )
+  {
+    dst_char.color.data = src_char.color.data;
+    dst_char.attr.data = src_char.attr.data
+                       & FAttribute::unset::color_overlay
+                       & FAttribute::unset::reverse
+                       & FAttribute::unset::standout
+                       & FAttribute::unset::no_changes
+                       & FAttribute::unset::printed;
+
+    if ( isInvisible(dst_char.ch[0]) )
+      dst_char.ch[0] = L' ';
+
+    return;
+  }
+
+  if ( src_char.isBitSet(FAttribute::set::inherit_background) )
+  {
+    const auto bg_color = dst_char.color.getBgColor();
+    dst_char = src_char;
+    dst_char.color.setBgColor(bg_color);
+    dst_char.attr.data &= FAttribute::unset::no_changes
+                        & FAttribute::unset::printed;
+    return;
+  }
+
+  dst_char = src_char;
+}
+
+//----------------------------------------------------------------------
+auto isSameCell (const finalcut::FChar& lhs, const finalcut::FChar& rhs) -> bool
+{
+  return std::memcmp(&lhs, &rhs, sizeof(finalcut::FChar)) == 0;
+}
+
+//----------------------------------------------------------------------
+auto createCell (std::size_t n) -> finalcut::FChar
+{
+  // Creates a cell with varying content
+
+  static const std::array<wchar_t, 8> chars
+  {{
+    L'a', L'Z', L'#', L' ',
+    wchar_t(finalcut::UniChar::FullBlock),
+    wchar_t(finalcut::UniChar::LowerHalfBlock),
+    wchar_t(finalcut::UniChar::MediumShade),
+    wchar_t(finalcut::UniChar::BlackCircle)
+  }};
+
+  finalcut::FChar fchar{};
+  fchar.ch[0] = chars[n % chars.size()];
+  fchar.ch[1] = ( n % 11 == 0 ) ? L'\U00000301' : L'\0';
+  fchar.encoded_char[0] = wchar_t(L'A' + n % 26);
+  fchar.color = { finalcut::FColor(n % 16)
+                , finalcut::FColor((n * 7 + 3) % 256) };
+  fchar.attr.data = uInt32(n * 2654435761U) & ~finalcut::FAttribute::set::char_width;
+  fchar.setCharWidth (1);
+  return fchar;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FCellBlenderTest
+//----------------------------------------------------------------------
+
+class FCellBlenderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FCellBlenderTest() = default;
+
+  protected:
+    void kernelTest();
+    void transparentInvisibleTest();
+    void blendTest();
+    void kernelComparisonTest();
+
+  private:
+    using Kernel = finalcut::FCellBlender::Kernel;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FCellBlenderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelTest);
+    CPPUNIT_TEST (transparentInvisibleTest);
+    CPPUNIT_TEST (blendTest);
+    CPPUNIT_TEST (kernelComparisonTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    const std::array<Kernel, 2> kernels{{Kernel::Scalar, Kernel::SSE2}};
+};
+
+//----------------------------------------------------------------------
+void FCellBlenderTest::kernelTest()
+{
+  const auto default_kernel = finalcut::FCellBlender::getKernel();
+  finalcut::FCellBlender::setKernel (Kernel::Scalar);
+  CPPUNIT_ASSERT ( finalcut::FCellBlender::getKernel() == Kernel::Scalar );
+
+  // Unsupported kernels fall back to the next smaller one
+  finalcut::FCellBlender::setKernel (Kernel::SSE2);
+  CPPUNIT_ASSERT ( finalcut::FCellBlender::getKernel() == default_kernel );
+}
+
+//----------------------------------------------------------------------
+void FCellBlenderTest::transparentInvisibleTest()
+{
+  static_assert ( finalcut::FCellBlender::isTransparentInvisible
+                  (wchar_t(finalcut::UniChar::FullBlock))
+                , "A full block is transparent invisible" );
+
+  for (wchar_t ch{0}; ch < 0x3000; ch++)
+  {
+    CPPUNIT_ASSERT ( finalcut::FCellBlender::isTransparentInvisible(ch)
+                     == test::isInvisible(ch) );
+  }
+
+  CPPUNIT_ASSERT ( ! finalcut::FCellBlender::isTransparentInvisible(wchar_t(0x2580 + 32)) );
+  CPPUNIT_ASSERT ( ! finalcut::FCellBlender::isTransparentInvisible(wchar_t(0x2580 + 64)) );
+  CPPUNIT_ASSERT ( ! finalcut::FCellBlender::isTransparentInvisible(wchar_t(0x1f600)) );
+}
+
+//----------------------------------------------------------------------
+void FCellBlenderTest::blendTest()
+{
+  using finalcut::FAttribute;
+
+  for (const auto kernel : kernels)
+  {
+    finalcut::FCellBlender::setKernel (kernel);
+    std::array<finalcut::FChar, 4> src{};
+    std::array<finalcut::FChar, 4> dst{};
+
+    for (std::size_t i{0}; i < dst.size(); i++)
+    {
+      dst[i].ch[0] = wchar_t(finalcut::UniChar::FullBlock);
+      dst[i].encoded_char[0] = L'#';
+      dst[i].color = {finalcut::FColor::Red, finalcut::FColor::Green};
+      dst[i].attr.data = FAttribute::set::bold;
+      src[i].ch[0] = L'x';
+      src[i].encoded_char[0] = L'x';
+      src[i].color = {finalcut::FColor::Yellow, finalcut::FColor::Blue};
+      src[i].attr.data = FAttribute::set::underline | FAttribute::set::printed;
+    }
+
+    src[0].setBit (FAttribute::set::transparent);
+    src[1].setBit (FAttribute::set::color_overlay);
+    src[1].setBit (FAttribute::set::reverse);
+    src[2].setBit (FAttribute::set::inherit_background);
+    const auto dst_copy = dst;
+    finalcut::FCellBlender::blend (src.data(), dst.data(), 0);
+    CPPUNIT_ASSERT ( test::isSameCell(dst[0], dst_copy[0]) );
+    finalcut::FCellBlender::blend (src.data(), dst.data(), dst.size());
+
+    // Transparent: the covered cell stays unchanged
+    CPPUNIT_ASSERT ( test::isSameCell(dst[0], dst_copy[0]) );
+
+    // Color overlay: covered character with the source color
+    CPPUNIT_ASSERT ( dst[1].ch[0] == L' ' );
+    CPPUNIT_ASSERT ( dst[1].encoded_char[0] == L'#' );
+    CPPUNIT_ASSERT ( dst[1].color.getFgColor() == finalcut::FColor::Yellow );
+    CPPUNIT_ASSERT ( dst[1].color.getBgColor() == finalcut::FColor::Blue );
+    CPPUNIT_ASSERT ( dst[1].attr.data == FAttribute::set::underline );
+
+    // Inherit background: source cell with the covered background
+    CPPUNIT_ASSERT ( dst[2].ch[0] == L'x' );
+    CPPUNIT_ASSERT ( dst[2].color.getFgColor() == finalcut::FColor::Yellow );
+    CPPUNIT_ASSERT ( dst[2].color.getBgColor() == finalcut::FColor::Green );
+    CPPUNIT_ASSERT ( dst[2].attr.data == ( FAttribute::set::underline
+                                         | FAttribute::set::inherit_background ) );
+
+    // Opaque: the source cell
+    CPPUNIT_ASSERT ( test::isSameCell(dst[3], src[3]) );
+  }
+
+  finalcut::FCellBlender::setKernel (Kernel::SSE2);
+}
+
+//----------------------------------------------------------------------
+void FCellBlenderTest::kernelComparisonTest()
+{
+  // All kernels must give the same results as the per-character rules
+
+  using finalcut::FAttribute;
+  constexpr std::size_t length = 97;
+  std::vector<finalcut::FChar> src{};
+  std::vector<finalcut::FChar> dst{};
+  std::vector<finalcut::FChar> expected{};
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    src.push_back (test::createCell(i * 3 + 1));
+    dst.push_back (test::createCell(i * 5 + 2));
+    auto& attr = src.back().attr.data;
+    attr &= FAttribute::unset::transparent
+          & FAttribute::unset::color_overlay
+          & FAttribute::unset::inherit_background;
+
+    // All combinations of the three transparency bits
+    if ( i & 1 )
+      attr |= FAttribute::set::transparent;
+
+    if ( i & 2 )
+      attr |= FAttribute::set::color_overlay;
+
+    if ( i & 4 )
+      attr |= FAttribute::set::inherit_background;
+  }
+
+  expected = dst;
+
+  for (std::size_t i{0}; i < length; i++)
+    test::referenceBlend (src[i], expected[i]);
+
+  for (const auto kernel : kernels)
+  {
+    finalcut::FCellBlender::setKernel (kernel);
+
+    for (std::size_t start{0}; start < length; start += 13)
+    {
+      auto result = dst;
+      const auto count = length - start;
+      finalcut::FCellBlender::blend (&src[start], &result[start], count);
+
+      for (std::size_t i{0}; i < length; i++)
+      {
+        const auto& cell = ( i < start ) ? dst[i] : expected[i];
+        CPPUNIT_ASSERT ( test::isSameCell(result[i], cell) );
+      }
+    }
+  }
+
+  finalcut::FCellBlender::setKernel (Kernel::SSE2);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FCellBlenderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,174 @@
+/***********************************************************************
+* fflushtiming-test.cpp - FFlushTiming unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FFlushTimingTest
+//----------------------------------------------------------------------
+
+class FFlushTimingTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FFlushTimingTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void targetLatencyTest();
+    void blockingWriteTest();
+    void outputQueueTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FFlushTimingTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (targetLatencyTest);
+    CPPUNIT_TEST (blockingWriteTest);
+    CPPUNIT_TEST (outputQueueTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FFlushTimingTest::classNameTest()
+{
+  const finalcut::FFlushTiming timing{};
+  const finalcut::FString& classname = timing.getClassName();
+  CPPUNIT_ASSERT ( classname == "FFlushTiming" );
+}
+
+//----------------------------------------------------------------------
+void FFlushTimingTest::noArgumentTest()
+{
+  finalcut::FFlushTiming timing{};
+  constexpr auto latency = finalcut::FFlushTiming::DEFAULT_LATENCY;
+  CPPUNIT_ASSERT ( timing.getTargetLatency() == latency );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == latency );
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 0 );
+  CPPUNIT_ASSERT ( ! timing.isFlushTimeout(0) );
+  CPPUNIT_ASSERT ( ! timing.isFlushTimeout(latency - 1) );
+  CPPUNIT_ASSERT ( timing.isFlushTimeout(latency) );
+
+  // A terminal that reads without delay keeps the target latency
+  timing.addWrite (5'000, 50, 0, 1'000'000);
+  CPPUNIT_ASSERT ( timing.getFlushWait() == latency );
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FFlushTimingTest::targetLatencyTest()
+{
+  finalcut::FFlushTiming timing{};
+
+  // Interactive output is written immediately
+  timing.setTargetLatency (0);
+  CPPUNIT_ASSERT ( timing.getTargetLatency() == 0 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 0 );
+  CPPUNIT_ASSERT ( timing.isFlushTimeout(0) );
+  timing.addWrite (10, 20, 0, 1'000'000);
+  CPPUNIT_ASSERT ( timing.isFlushTimeout(0) );
+
+  // Bulk output is batched
+  timing.setTargetLatency (50'000);
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 50'000 );
+  CPPUNIT_ASSERT ( ! timing.isFlushTimeout(49'999) );
+  CPPUNIT_ASSERT ( timing.isFlushTimeout(50'000) );
+
+  // A slow terminal extends the wait time
+  timing.addWrite (10'000, 100'000, 0, 2'000'000);
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 100'000 );
+
+  timing.reset();
+  CPPUNIT_ASSERT ( timing.getTargetLatency() == 50'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 50'000 );
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FFlushTimingTest::blockingWriteTest()
+{
+  finalcut::FFlushTiming timing{};
+  constexpr auto latency = finalcut::FFlushTiming::DEFAULT_LATENCY;
+
+  // 20'000 bytes in 40 ms => 500'000 bytes per second
+  timing.addWrite (20'000, 40'000, 0, 1'000'000);
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 500'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 40'000 );
+
+  // The wait time is limited
+  timing.addWrite (100'000, 1'000'000, 0, 2'000'000);
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 400'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == finalcut::FFlushTiming::MAX_FLUSH_WAIT );
+
+  // A drained terminal returns to the target latency
+  timing.addWrite (1'000, 100, 0, 3'000'000);
+  CPPUNIT_ASSERT ( timing.getFlushWait() == latency );
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 400'000 );
+}
+
+//----------------------------------------------------------------------
+void FFlushTimingTest::outputQueueTest()
+{
+  finalcut::FFlushTiming timing{};
+  constexpr auto latency = finalcut::FFlushTiming::DEFAULT_LATENCY;
+
+  // The first queue size has no reference
+  timing.addWrite (4'000, 100, 4'000, 1'000'000);
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 0 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == latency );
+
+  // 3'000 bytes drained in 100 ms => 30'000 bytes per second
+  timing.addWrite (2'000, 100, 3'000, 1'100'000);
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 30'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == 100'000 );  // 3'000 bytes
+
+  // An emptied queue only raises the rate
+  timing.addWrite (100, 100, 0, 1'300'000);  // >= 15'500 bytes per second
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 30'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == latency );
+
+  // A large queue is limited to the maximum wait time
+  timing.addWrite (30'000, 100, 30'000, 1'400'000);
+  CPPUNIT_ASSERT ( timing.getFlushWait() == finalcut::FFlushTiming::MAX_FLUSH_WAIT );
+  timing.addWrite (0, 0, 20'000, 1'600'000);  // 50'000 bytes per second
+  CPPUNIT_ASSERT ( timing.getDrainRate() == 35'000 );
+  CPPUNIT_ASSERT ( timing.getFlushWait() == finalcut::FFlushTiming::MAX_FLUSH_WAIT );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FFlushTimingTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,443 @@
+/***********************************************************************
+* fkey_tokenizer-test.cpp - FKeyTokenizer unit tests                   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <string>
+
+#include <final/final.h>
+
+namespace test
+{
+
+using KeyCapMap = finalcut::FKeyMap::KeyCapMap;
+
+std::array<KeyCapMap, 7> fkey =
+{{
+  { finalcut::FKey::Backspace , "\177"      , 1, {"kb"} },  // backspace key
+  { finalcut::FKey::Clear_tab , CSI "3~"    , 4, {"kt"} },  // clear-tab key
+  { finalcut::FKey::Up        , CSI "A"     , 3, {"ku"} },  // up-arrow key
+  { finalcut::FKey::Down      , CSI "B"     , 3, {"kd"} },  // down-arrow key
+  { finalcut::FKey::Insert    , CSI "2~"    , 4, {"kI"} },  // insert-character key
+  { finalcut::FKey::F1        , ESC "OP"    , 3, {"k1"} },  // F1 function key
+  { finalcut::FKey::F5        , CSI "15~"   , 5, {"k5"} }   // F5 function key
+}};
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FKeyTokenizerTest
+//----------------------------------------------------------------------
+
+class FKeyTokenizerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FKeyTokenizerTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void characterTest();
+    void utf8Test();
+    void keyTest();
+    void deferredKeyTest();
+    void mouseTest();
+    void keyboardProtocolTest();
+    void invalidTest();
+
+  private:
+    using Status = finalcut::FKeyTokenizer::Status;
+
+    // Method
+    static auto tokenize (finalcut::FKeyTokenizer&, const std::string&) -> Status;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FKeyTokenizerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (characterTest);
+    CPPUNIT_TEST (utf8Test);
+    CPPUNIT_TEST (keyTest);
+    CPPUNIT_TEST (deferredKeyTest);
+    CPPUNIT_TEST (mouseTest);
+    CPPUNIT_TEST (keyboardProtocolTest);
+    CPPUNIT_TEST (invalidTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::classNameTest()
+{
+  const finalcut::FKeyTokenizer tokenizer{};
+  const finalcut::FString& classname = tokenizer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FKeyTokenizer" );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::noArgumentTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  CPPUNIT_ASSERT ( ! tokenizer.isCompiled() );
+  CPPUNIT_ASSERT ( tokenizer.getStateCount() == 0 );
+  CPPUNIT_ASSERT ( tokenizer.getStatus() == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 0 );
+
+  // Without compilation, no input sequence is known
+  CPPUNIT_ASSERT ( tokenizer.feed('a') == Status::Invalid );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+
+  tokenizer.compile();
+  CPPUNIT_ASSERT ( tokenizer.isCompiled() );
+  CPPUNIT_ASSERT ( tokenizer.getStateCount() > 0 );
+  CPPUNIT_ASSERT ( tokenizer.getStatus() == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 0 );
+
+  // Changes require a new compilation
+  tokenizer.setUTF8();
+  CPPUNIT_ASSERT ( ! tokenizer.isCompiled() );
+  tokenizer.compile();
+  tokenizer.setUTF8();
+  CPPUNIT_ASSERT ( tokenizer.isCompiled() );
+  tokenizer.setMouseSupport(false);
+  CPPUNIT_ASSERT ( ! tokenizer.isCompiled() );
+  tokenizer.compile();
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  CPPUNIT_ASSERT ( ! tokenizer.isCompiled() );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::characterTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.compile();
+
+  // Characters are returned without a key for the caller to decode
+  for (const auto& ch : std::string("a~ \t\r\177\303"))
+  {
+    CPPUNIT_ASSERT ( tokenizer.feed(ch) == Status::Complete );
+    CPPUNIT_ASSERT ( tokenizer.getStatus() == Status::Complete );
+    CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+    CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+    tokenizer.reset();
+  }
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\0') == Status::Complete );
+  tokenizer.reset();
+
+  // A complete token ignores further characters
+  CPPUNIT_ASSERT ( tokenizer.feed('x') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.feed('y') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+  tokenizer.reset();
+
+  // A single escape character waits for the next character
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::utf8Test()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setUTF8();
+  tokenizer.compile();
+
+  // u with two dots (2 bytes)
+  CPPUNIT_ASSERT ( tokenizer.feed('\303') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('\274') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 2 );
+  tokenizer.reset();
+
+  // Euro sign (3 bytes)
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\342\202") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('\254') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 3 );
+  tokenizer.reset();
+
+  // Linear B syllable (4 bytes)
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\360\220\200") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('\200') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 4 );
+  tokenizer.reset();
+
+  // Obsolete 6 byte sequence
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\374\200\200\200\200") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('\200') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 6 );
+  tokenizer.reset();
+
+  // Continuation bytes and invalid start bytes are single characters
+  CPPUNIT_ASSERT ( tokenizer.feed('\200') == Status::Complete );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenizer.feed('\377') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+  tokenizer.reset();
+
+  // Without UTF-8 support
+  tokenizer.setUTF8(false);
+  tokenizer.compile();
+  CPPUNIT_ASSERT ( tokenizer.feed('\360') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::keyTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.compile();
+
+  // Known keys
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033a") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Meta_a );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 2 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[1;5") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('B') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Ctrl_down );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 6 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033\033[2~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Meta_insert );
+  tokenizer.reset();
+
+  // Termcap keys
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[A") == Status::Invalid );
+  tokenizer.reset();
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  tokenizer.compile();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[A") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Up );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033OP") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::F1 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[15~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::F5 );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 5 );
+  tokenizer.reset();
+
+  // Termcap keys take precedence over known keys
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[3~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Clear_tab );
+  tokenizer.reset();
+
+  // Termcap keys without an escape character are single characters
+  CPPUNIT_ASSERT ( tokenizer.feed('\177') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  tokenizer.reset();
+
+  // The mouse support does not change the key recognition
+  tokenizer.setMouseSupport(false);
+  tokenizer.compile();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[2~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Insert );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::deferredKeyTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  tokenizer.compile();
+
+  // Meta-O, Meta-[ and Meta-] are prefixes of other keys
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033O") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::Meta_O );
+  CPPUNIT_ASSERT ( tokenizer.feed('P') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::F1 );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( tokenizer.feed('1') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033]") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::Meta_right_square_bracket );
+  tokenizer.reset();
+
+  // Other meta keys are complete immediately
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033o") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Meta_o );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::mouseTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  tokenizer.compile();
+
+  // X11 mouse
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[M Z") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('2') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::X11mouse );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 6 );
+  tokenizer.reset();
+
+  // Any byte is a valid X11 mouse coordinate
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[M\033\377~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::X11mouse );
+  tokenizer.reset();
+
+  // SGR mouse
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[<0;11;7") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('M') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Extended_mouse );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 10 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[<64;123;45m") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Extended_mouse );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[<0;11M") == Status::Invalid );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[<0;x") == Status::Invalid );
+  tokenizer.reset();
+
+  // Urxvt mouse
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[32;11;7") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('M') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Urxvt_mouse );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 10 );
+  tokenizer.reset();
+
+  // Keys with the same prefix are still recognized
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[15~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::F5 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[1;5B") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Ctrl_down );
+  tokenizer.reset();
+
+  // Without mouse support
+  tokenizer.setMouseSupport(false);
+  tokenizer.compile();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[M Z2") != Status::Complete
+                || tokenizer.getKey() != finalcut::FKey::X11mouse );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[<0;11;7M") == Status::Invalid );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[32;11;7M") == Status::Invalid );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::keyboardProtocolTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  tokenizer.compile();
+
+  // Escape key without timeout
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[27") == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.feed('u') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Kitty_keyboard );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 5 );
+  tokenizer.reset();
+
+  // Key with modifiers (Ctrl-a)
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[97;5u") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Kitty_keyboard );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 7 );
+  tokenizer.reset();
+
+  // Key with several modifiers (Ctrl-Meta-a)
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[97;7u") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Kitty_keyboard );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 7 );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[97;u") == Status::Invalid );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[u") == Status::Invalid );
+  tokenizer.reset();
+
+  // Keys and mouse reports with the same prefix are still recognized
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[2~") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Insert );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[1;5B") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Ctrl_down );
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[32;11;7M") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Urxvt_mouse );
+}
+
+//----------------------------------------------------------------------
+void FKeyTokenizerTest::invalidTest()
+{
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setTermcapMap (test::fkey.cbegin(), test::fkey.cend());
+  tokenizer.compile();
+
+  // No input sequence starts with these characters
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[_") == Status::Invalid );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 3 );
+
+  // Further characters are ignored
+  CPPUNIT_ASSERT ( tokenizer.feed('.') == Status::Invalid );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 3 );
+
+  // The tokenizer is ready for the next sequence after a reset
+  tokenizer.reset();
+  CPPUNIT_ASSERT ( tokenizer.getStatus() == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getLength() == 0 );
+  CPPUNIT_ASSERT ( tokenize(tokenizer, "\033[B") == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Down );
+}
+
+//----------------------------------------------------------------------
+auto FKeyTokenizerTest::tokenize ( finalcut::FKeyTokenizer& tokenizer
+                                 , const std::string& string ) -> Status
+{
+  for (const auto& ch : string)
+    tokenizer.feed(ch);
+
+  return tokenizer.getStatus();
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FKeyTokenizerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -20,9 +20,16 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -280,6 +287,202 @@ test_type fkey =
   { finalcut::FKey::Lower_right     , nullptr    , 0, {"K5x"}}   // keypad lower right
 }};
 
+//----------------------------------------------------------------------
+// class FSystemTest
+//----------------------------------------------------------------------
+
+class FSystemTest : public finalcut::FSystem
+{
+  public:
+    // Constructor
+    FSystemTest() = default;
+
+    // Methods
+    auto inPortByte (uShort) noexcept -> uChar override
+    {
+      return 0;
+    }
+
+    void outPortByte (uChar, uShort) noexcept override
+    { }
+
+    auto isTTY (int) const noexcept -> int override
+    {
+      return 1;
+    }
+
+    auto ioctl (int, uLong, ...) noexcept -> int override
+    {
+      return -1;
+    }
+
+    auto fcntl (int, int cmd, ...) noexcept -> int override
+    {
+      // Records the file status flags of stdin
+
+      fcntl_calls++;
+
+      if ( cmd == F_GETFL )
+        return stdin_flags;
+
+      if ( cmd == F_SETFL )
+      {
+        va_list args{};
+        va_start (args, cmd);
+        stdin_flags = va_arg (args, int);
+        va_end (args);
+        return 0;
+      }
+
+      return -1;
+    }
+
+    auto pipe (finalcut::PipeData&) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto open (const char*, int, ...) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto close (int) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto fopen (const char*, const char*) noexcept -> FILE* override
+    {
+      return nullptr;
+    }
+
+    auto fclose (FILE*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto fputs (const char* str, FILE* stream) noexcept -> int override
+    {
+      return std::fputs(str, stream);
+    }
+
+    auto putchar (int c) noexcept -> int override
+    {
+#if defined(__sun) && defined(__SVR4)
+      return std::putchar(char(c));
+#else
+      return std::putchar(c);
+#endif
+    }
+
+    auto putstring (const char* str, std::size_t len) noexcept -> int override
+    {
+      return int(std::fwrite(str, 1, len, stdout));
+    }
+
+    auto read (int, void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      // Delivers the simulated terminal input in chunks
+
+      read_calls++;
+      max_read_count = std::max(max_read_count, count);
+
+      if ( (stdin_flags & O_NONBLOCK) == 0 )
+        blocking_read = true;
+
+      count = std::min({count, chunk_size, input.size() - input_pos});
+
+      if ( count == 0 )
+      {
+        errno = EAGAIN;
+        return -1;
+      }
+
+      std::memcpy (buf, input.data() + input_pos, count);
+      input_pos += count;
+      return ssize_t(count);
+    }
+
+    auto write (int fd, const void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      return ::write(fd, buf, count);
+    }
+
+    auto sigaction (int, const struct sigaction*, struct sigaction*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_create (clockid_t, struct sigevent*, timer_t*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_settime ( timer_t, int
+                       , const struct itimerspec*
+                       , struct itimerspec* ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_delete (timer_t) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto kqueue() noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto kevent ( int, const struct kevent*
+                , int, struct kevent*
+                , int, const struct timespec* ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto getuid() noexcept -> uid_t override
+    {
+      return 0;
+    }
+
+    auto geteuid() noexcept -> uid_t override
+    {
+      return 0;
+    }
+
+    auto getpwuid_r ( uid_t, struct passwd*, char*
+                    , size_t, struct passwd** ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto realpath (const char*, char*) noexcept -> char* override
+    {
+      return nullptr;
+    }
+
+    void setInput (const std::string& str, std::size_t chunk = SIZE_MAX)
+    {
+      input = str;
+      input_pos = 0;
+      chunk_size = chunk;
+    }
+
+    // Data members
+    std::string  input{};
+    std::size_t  input_pos{0};
+    std::size_t  chunk_size{SIZE_MAX};
+    std::size_t  max_read_count{0};
+    std::size_t  read_calls{0};
+    std::size_t  fcntl_calls{0};
+    int          stdin_flags{O_RDWR};
+    bool         blocking_read{false};
+};
+
+
 }  // namespace test
 
 
@@ -303,10 +506,15 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void functionKeyTest();
     void metaKeyTest();
     void sequencesTest();
-    void hashmapTest();
+    void keyLookupTest();
     void mouseTest();
     void utf8Test();
     void unknownKeyTest();
+    void systemCallTest();
+    void chunkedInputTest();
+    void keyboardProtocolTest();
+    void bracketedPasteTest();
+    void pasteThroughputTest();
 
   private:
     // Adds code needed to register the test suite
@@ -322,10 +530,15 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (functionKeyTest);
     CPPUNIT_TEST (metaKeyTest);
     CPPUNIT_TEST (sequencesTest);
-    CPPUNIT_TEST (hashmapTest);
+    CPPUNIT_TEST (keyLookupTest);
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (unknownKeyTest);
+    CPPUNIT_TEST (systemCallTest);
+    CPPUNIT_TEST (chunkedInputTest);
+    CPPUNIT_TEST (keyboardProtocolTest);
+    CPPUNIT_TEST (bracketedPasteTest);
+    CPPUNIT_TEST (pasteThroughputTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -339,6 +552,7 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void keyReleased();
     void escapeKeyPressed();
     void mouseTracking();
+    auto pasteInput (const std::size_t) -> std::string;
 
     // Data members
     finalcut::FKey key_pressed{finalcut::FKey::None};
@@ -2953,88 +3167,63 @@ void FKeyboardTest::sequencesTest()
 }
 
 //----------------------------------------------------------------------
-void FKeyboardTest::hashmapTest()
+void FKeyboardTest::keyLookupTest()
 {
-  using keybuffer = finalcut::CharRingBuffer<12>;
-  finalcut::fkeyhashmap::setKeyCapMap<keybuffer>(std::begin(test::fkey), std::end(test::fkey));
-  keybuffer char_rbuf;
-  char* physical_buffer = &char_rbuf[0];
-  std::memcpy (physical_buffer, "\0\0\0\0\0\0\0\0\0\0\0\0", 12);
-
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('\033');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('[');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Meta_left_square_bracket );
-  char_rbuf.push('2');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push(';');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('3');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('~');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Meta_insert );
-  char_rbuf.pop(char_rbuf.getSize());
-
-  char_rbuf.push('\177');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::Backspace );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.pop();
-
-  char_rbuf.push('\033');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('O');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Meta_O );
-  char_rbuf.push('P');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::F1 );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.pop(char_rbuf.getSize());
-
-  char_rbuf.push('\033');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('[');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Meta_left_square_bracket );
-  char_rbuf.push('1');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push(';');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('2');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('B');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::Scroll_forward );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf[4] = '6';
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Shift_Ctrl_down );
-  char_rbuf.pop(char_rbuf.getSize());
-
-  char_rbuf.push('\033');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::None );
-  char_rbuf.push('[');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Meta_left_square_bracket );
-  char_rbuf.push('I');
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Term_Focus_In );
-  char_rbuf.back() = 'O';
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getTermcapKey(char_rbuf) == finalcut::FKey::None );
-  CPPUNIT_ASSERT ( finalcut::fkeyhashmap::getKnownKey(char_rbuf) == finalcut::FKey::Term_Focus_Out );
-  char_rbuf.pop(char_rbuf.getSize());
+  using Status = finalcut::FKeyTokenizer::Status;
+  finalcut::FKeyTokenizer tokenizer{};
+  tokenizer.setTermcapMap (std::begin(test::fkey), std::end(test::fkey));
+  tokenizer.compile();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.feed('[') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( tokenizer.feed('2') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( tokenizer.feed(';') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('3') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('~') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Meta_insert );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\177') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::None );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('O') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.getDeferredKey() == finalcut::FKey::Meta_O );
+  CPPUNIT_ASSERT ( tokenizer.feed('P') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::F1 );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('[') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('1') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed(';') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('2') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('B') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Scroll_forward );
+  tokenizer.reset();
+
+  for (const auto& ch : std::string("\033[1;6B"))
+    tokenizer.feed(ch);
+
+  CPPUNIT_ASSERT ( tokenizer.getStatus() == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Shift_Ctrl_down );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('[') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('I') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Term_Focus_In );
+  tokenizer.reset();
+
+  CPPUNIT_ASSERT ( tokenizer.feed('\033') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('[') == Status::Incomplete );
+  CPPUNIT_ASSERT ( tokenizer.feed('O') == Status::Complete );
+  CPPUNIT_ASSERT ( tokenizer.getKey() == finalcut::FKey::Term_Focus_Out );
+  tokenizer.reset();
 }
 
 //----------------------------------------------------------------------
@@ -3146,6 +3335,231 @@ void FKeyboardTest::unknownKeyTest()
   CPPUNIT_ASSERT ( keyboard->getKeyName(key_pressed) == "" );
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::systemCallTest()
+{
+  // A pasted text is read in large chunks instead of byte by byte
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+  std::string text{};
+
+  for (std::size_t i{0}; i < 1024; i++)
+    text.push_back(char('a' + i % 26));
+
+  fsys_ptr->setInput (text);
+  CPPUNIT_ASSERT ( pasteInput(text.size()) == text );
+  CPPUNIT_ASSERT ( fsys_ptr->input_pos == text.size() );
+
+  // The text is read at once
+  CPPUNIT_ASSERT ( fsys_ptr->max_read_count == finalcut::FKeyboard::FIFO_BUF_SIZE );
+  CPPUNIT_ASSERT ( fsys_ptr->read_calls == 1 );
+
+  // Before, each byte needed three system calls (fcntl, read, fcntl)
+  CPPUNIT_ASSERT ( fsys_ptr->fcntl_calls == 2 );
+
+  // stdin is only non-blocking while reading
+  CPPUNIT_ASSERT ( ! fsys_ptr->blocking_read );
+  CPPUNIT_ASSERT ( (fsys_ptr->stdin_flags & O_NONBLOCK) == 0 );
+
+  // No input available
+  keyboard->fetchKeyCode();
+  CPPUNIT_ASSERT ( fsys_ptr->read_calls == 2 );
+  CPPUNIT_ASSERT ( fsys_ptr->fcntl_calls == 4 );
+  CPPUNIT_ASSERT ( ! keyboard->hasPendingInput() );
+  CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+  CPPUNIT_ASSERT ( ! keyboard->hasDataInQueue() );
+
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::chunkedInputTest()
+{
+  // Escape sequences and UTF-8 characters that are split
+  // between two reads
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+  std::vector<finalcut::FKey> keys{};
+  auto cmd = [this, &keys] () { keys.push_back(keyboard->getKey()); };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd));
+
+  for (std::size_t chunk{1}; chunk < 8; chunk++)
+  {
+    keys.clear();
+    fsys_ptr->setInput ("\033[Ax\033[B\303\244\033OP\033[15~", chunk);
+
+    while ( fsys_ptr->input_pos < fsys_ptr->input.size() )
+    {
+      keyboard->fetchKeyCode();
+      keyboard->processQueuedInput();
+    }
+
+    CPPUNIT_ASSERT ( keys.size() == 6 );
+    CPPUNIT_ASSERT ( keys[0] == finalcut::FKey::Up );
+    CPPUNIT_ASSERT ( keys[1] == finalcut::FKey('x') );
+    CPPUNIT_ASSERT ( keys[2] == finalcut::FKey::Down );
+    CPPUNIT_ASSERT ( keys[3] == finalcut::FKey(0xe4) );  // ä
+    CPPUNIT_ASSERT ( keys[4] == finalcut::FKey::F1 );
+    CPPUNIT_ASSERT ( keys[5] == finalcut::FKey::F5 );
+    CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+  }
+
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::keyboardProtocolTest()
+{
+  // Kitty keyboard protocol keys are recognized without a timeout
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+  std::vector<finalcut::FKey> keys{};
+  auto cmd = [this, &keys] () { keys.push_back(keyboard->getKey()); };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd));
+  fsys_ptr->setInput ( "\033[27u"       // Esc
+                       "\033[97;5u"     // Ctrl-a
+                       "\033[97;3u"     // Meta-a
+                       "\033[97;4u"     // Shift-Meta-a
+                       "\033[97;7u"     // Ctrl-Meta-a
+                       "\033[13;3u"     // Meta-Enter
+                       "\033[9;2u"      // Shift-Tab
+                       "\033[32;5u"     // Ctrl-Space
+                       "\033[57441;2u"  // Left shift (no legacy key)
+                       "\033[228u"      // ä
+                       "\033[27u" );    // Esc
+  keyboard->fetchKeyCode();
+  keyboard->processQueuedInput();
+
+  CPPUNIT_ASSERT ( keys.size() == 10 );
+  CPPUNIT_ASSERT ( keys[0] == finalcut::FKey::Escape );
+  CPPUNIT_ASSERT ( keys[1] == finalcut::FKey::Ctrl_a );
+  CPPUNIT_ASSERT ( keys[2] == finalcut::FKey::Meta_a );
+  CPPUNIT_ASSERT ( keys[3] == finalcut::FKey::Meta_A );
+  CPPUNIT_ASSERT ( keys[4] == finalcut::FKey::Meta_offset + finalcut::FKey::Ctrl_a );
+  CPPUNIT_ASSERT ( keys[5] == finalcut::FKey::Meta_enter );
+  CPPUNIT_ASSERT ( keys[6] == finalcut::FKey::Back_tab );
+  CPPUNIT_ASSERT ( keys[7] == finalcut::FKey::Ctrl_space );
+  CPPUNIT_ASSERT ( keys[8] == finalcut::FKey(0xe4) );  // ä
+  CPPUNIT_ASSERT ( keys[9] == finalcut::FKey::Escape );
+  CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+  CPPUNIT_ASSERT ( keyboard->getKeyName(finalcut::FKey::Kitty_keyboard) == "kitty keyboard protocol" );
+
+  auto cmd1 = [this] () { this->keyPressed(); };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd1));
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::bracketedPasteTest()
+{
+  // The text between ESC[200~ and ESC[201~ is delivered as one key
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+  std::vector<finalcut::FKey> keys{};
+  std::vector<std::string> texts{};
+  auto cmd = [this, &keys, &texts] ()
+  {
+    keys.push_back(keyboard->getKey());
+    texts.push_back(keyboard->getPasteText());
+  };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd));
+  const std::string paste_text{"ls -l\r\033[A\033OP\303\244\033[20~\033"};
+
+  for (std::size_t chunk{1}; chunk < 8; chunk++)
+  {
+    keys.clear();
+    texts.clear();
+    fsys_ptr->setInput ("x\033[200~" + paste_text + "\033[201~\033[B", chunk);
+
+    while ( fsys_ptr->input_pos < fsys_ptr->input.size() )
+    {
+      keyboard->fetchKeyCode();
+      keyboard->processQueuedInput();
+    }
+
+    CPPUNIT_ASSERT ( keys.size() == 3 );
+    CPPUNIT_ASSERT ( keys[0] == finalcut::FKey('x') );
+    CPPUNIT_ASSERT ( keys[1] == finalcut::FKey::Bracketed_paste );
+    CPPUNIT_ASSERT ( keys[2] == finalcut::FKey::Down );
+    CPPUNIT_ASSERT ( texts[0].empty() );
+    CPPUNIT_ASSERT ( texts[1] == paste_text );
+    CPPUNIT_ASSERT ( texts[2].empty() );
+    CPPUNIT_ASSERT ( keyboard->getPasteText().empty() );
+    CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+  }
+
+  // Empty paste
+  keys.clear();
+  texts.clear();
+  fsys_ptr->setInput ("\033[200~\033[201~");
+  keyboard->fetchKeyCode();
+  keyboard->processQueuedInput();
+  CPPUNIT_ASSERT ( keys.size() == 1 );
+  CPPUNIT_ASSERT ( keys[0] == finalcut::FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( texts[0].empty() );
+
+  // Missing end sequence
+  keys.clear();
+  texts.clear();
+  fsys_ptr->setInput ("\033[200~abc\033[20");
+  keyboard->fetchKeyCode();
+  keyboard->processQueuedInput();
+  keyboard->escapeKeyHandling();
+  CPPUNIT_ASSERT ( keys.empty() );
+  CPPUNIT_ASSERT ( keyboard->hasUnprocessedInput() );
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  keyboard->clearKeyBufferOnTimeout();
+  keyboard->processQueuedInput();
+  CPPUNIT_ASSERT ( keys.size() == 1 );
+  CPPUNIT_ASSERT ( keys[0] == finalcut::FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( texts[0] == "abc\033[20" );
+  CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+
+  CPPUNIT_ASSERT ( keyboard->getKeyName(finalcut::FKey::Bracketed_paste) == "bracketed paste" );
+
+  auto cmd1 = [this] () { this->keyPressed(); };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd1));
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::pasteThroughputTest()
+{
+  // Benchmark for pasted input
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+  std::string text{};
+
+  for (std::size_t i{0}; i < 1024 * 1024; i++)
+    text.push_back(char(' ' + i % 95));
+
+  fsys_ptr->setInput (text);
+  const auto start = std::chrono::high_resolution_clock::now();
+  const auto received = pasteInput(text.size());
+  const auto end = std::chrono::high_resolution_clock::now();
+  CPPUNIT_ASSERT ( received == text );
+  const auto syscalls = fsys_ptr->read_calls + fsys_ptr->fcntl_calls;
+  CPPUNIT_ASSERT ( syscalls == 3 * text.size() / finalcut::FKeyboard::FIFO_BUF_SIZE );
+  using std::chrono::microseconds;
+  const auto duration_us = std::max ( std::chrono::duration_cast<microseconds>(end - start).count()
+                                    , microseconds::rep(1) );
+  std::cout << "\n1 MiB paste: " << duration_us << " µs ("
+            << (text.size() / std::size_t(duration_us)) << " MB/s), "
+            << syscalls << " system calls\n";
+
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::init()
 {
@@ -3258,6 +3672,29 @@ void FKeyboardTest::processInput()
   std::this_thread::sleep_for(std::chrono::milliseconds(75));
 }
 
+//----------------------------------------------------------------------
+auto FKeyboardTest::pasteInput (const std::size_t length) -> std::string
+{
+  // Processes the simulated input like the application event loop
+
+  std::string received{};
+  auto cmd = [this, &received] ()
+  {
+    received.push_back(char(keyboard->getKey()));
+  };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(cmd));
+  std::size_t rounds{0};
+
+  while ( received.size() < length && rounds < length )
+  {
+    keyboard->fetchKeyCode();
+    keyboard->processQueuedInput();
+    rounds++;
+  }
+
+  return received;
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::clear()
 {
@@ -0,0 +1,413 @@
+/***********************************************************************
+* flineencoder-test.cpp - FLineEncoder unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+using Operation = finalcut::FLineEncoder::Operation;
+
+//----------------------------------------------------------------------
+auto createCell ( wchar_t ch
+                , finalcut::FColor fg = finalcut::FColor::Default
+                , bool unchanged = false ) -> finalcut::FChar
+{
+  finalcut::FChar fchar{};
+  fchar.ch[0] = ch;
+  fchar.color = {fg, finalcut::FColor::Default};
+  fchar.setCharWidth (1);
+  fchar.setBit (finalcut::FAttribute::set::no_changes, unchanged);
+  return fchar;
+}
+
+//----------------------------------------------------------------------
+void appendCells ( std::vector<finalcut::FChar>& row, std::size_t count
+                 , const finalcut::FChar& fchar )
+{
+  row.insert (row.end(), count, fchar);
+}
+
+//----------------------------------------------------------------------
+auto createCostModel() -> finalcut::FLineEncoder::CostModel
+{
+  // Byte counts of a typical xterm-compatible terminal
+
+  finalcut::FLineEncoder::CostModel model{};
+  model.attribute_change = [] (const finalcut::FChar&, const finalcut::FChar&)
+  {
+    return 5U;  // CSI 3x m
+  };
+  model.character = [] (const finalcut::FChar&) { return 1U; };
+  model.cursor_move = [] (uInt, uInt) { return 6U; };  // CSI nn G
+  model.repeat_character = [] (const finalcut::FChar&, uInt)
+  {
+    return 6U;  // x CSI nn b
+  };
+  model.erase_characters = [] (uInt) { return 5U; };  // CSI nn X
+  model.clear_to_eol = 3;  // CSI K
+  model.cursor_address_length = 6;
+  model.erase_char_length = 5;
+  model.repeat_char_length = 6;
+  return model;
+}
+
+//----------------------------------------------------------------------
+auto isCompletePlan ( const finalcut::FLineEncoder::Plan& plan
+                    , const std::vector<finalcut::FChar>& row ) -> bool
+{
+  // Every changed cell must be written by exactly one step
+
+  std::vector<int> written(row.size(), 0);
+
+  for (const auto& step : plan)
+  {
+    uInt count{0};
+
+    if ( step.op == Operation::Print )
+      count = 1;
+    else if ( step.op != Operation::Move )
+      count = step.count;
+
+    for (uInt i{0}; i < count; i++)
+      written[step.x + i]++;
+  }
+
+  for (std::size_t x{0}; x < row.size(); x++)
+  {
+    const bool unchanged = row[x].isBitSet(finalcut::FAttribute::set::no_changes);
+
+    if ( written[x] > 1 || (! unchanged && written[x] != 1) )
+      return false;
+  }
+
+  return true;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FLineEncoderTest
+//----------------------------------------------------------------------
+
+class FLineEncoderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FLineEncoderTest() = default;
+
+  protected:
+    void classNameTest();
+    void emptySpanTest();
+    void printTest();
+    void repeatTest();
+    void eraseTest();
+    void skipTest();
+    void greedyComparisonTest();
+    void attributeClassLimitTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FLineEncoderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (emptySpanTest);
+    CPPUNIT_TEST (printTest);
+    CPPUNIT_TEST (repeatTest);
+    CPPUNIT_TEST (eraseTest);
+    CPPUNIT_TEST (skipTest);
+    CPPUNIT_TEST (greedyComparisonTest);
+    CPPUNIT_TEST (attributeClassLimitTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    finalcut::FChar term_attribute{test::createCell(L' ')};
+};
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::classNameTest()
+{
+  const finalcut::FLineEncoder encoder{};
+  const finalcut::FString& classname = encoder.getClassName();
+  CPPUNIT_ASSERT ( classname == "FLineEncoder" );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::emptySpanTest()
+{
+  finalcut::FLineEncoder encoder{};
+  const auto model = test::createCostModel();
+  const auto cell = test::createCell(L'x');
+  CPPUNIT_ASSERT ( encoder.encode(&cell, &cell, term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().empty() );
+  CPPUNIT_ASSERT ( encoder.getCost() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::printTest()
+{
+  finalcut::FLineEncoder encoder{};
+  const auto model = test::createCostModel();
+  std::vector<finalcut::FChar> row{};
+  row.push_back (test::createCell(L'a'));
+  row.push_back (test::createCell(L'b'));
+  row.push_back (test::createCell(L'c'));
+
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  const auto& plan = encoder.getPlan();
+  CPPUNIT_ASSERT ( plan.size() == 3 );
+  CPPUNIT_ASSERT ( plan[0].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( plan[0].x == 0 );
+  CPPUNIT_ASSERT ( plan[2].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( plan[2].x == 2 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 3 );
+  // Two red characters with an attribute change before and after
+  row[0] = test::createCell(L'a', finalcut::FColor::Red);
+  row[1] = test::createCell(L'b', finalcut::FColor::Red);
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == 3 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 5 + 1 + 1 + 5 + 1 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::repeatTest()
+{
+  finalcut::FLineEncoder encoder{};
+  auto model = test::createCostModel();
+  std::vector<finalcut::FChar> row{};
+  test::appendCells (row, 20, test::createCell(L'x'));
+
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  const auto& plan = encoder.getPlan();
+  CPPUNIT_ASSERT ( plan.size() == 1 );
+  CPPUNIT_ASSERT ( plan[0].op == test::Operation::Repeat );
+  CPPUNIT_ASSERT ( plan[0].x == 0 );
+  CPPUNIT_ASSERT ( plan[0].count == 20 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 6 );
+
+  // Short runs are cheaper to print
+  row.resize(4);
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == 4 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 4 );
+
+  // Without the capability
+  row.resize(20, row[0]);
+  model.repeat_character = nullptr;
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == 20 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 20 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::eraseTest()
+{
+  finalcut::FLineEncoder encoder{};
+  auto model = test::createCostModel();
+  model.repeat_character = nullptr;
+  std::vector<finalcut::FChar> row{};
+  test::appendCells (row, 20, test::createCell(L' '));
+  row.push_back (test::createCell(L'a'));
+  row.push_back (test::createCell(L'b'));
+
+  // Erase, then move the cursor behind the erased cells
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  const auto& plan = encoder.getPlan();
+  CPPUNIT_ASSERT ( plan.size() == 4 );
+  CPPUNIT_ASSERT ( plan[0].op == test::Operation::Erase );
+  CPPUNIT_ASSERT ( plan[0].count == 20 );
+  CPPUNIT_ASSERT ( plan[1].op == test::Operation::Move );
+  CPPUNIT_ASSERT ( plan[1].x == 20 );
+  CPPUNIT_ASSERT ( plan[2].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( plan[3].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( encoder.getCost() == 5 + 6 + 1 + 1 );
+
+  // Colored blanks require background color erase
+  std::vector<finalcut::FChar> colored{};
+  test::appendCells (colored, 20, test::createCell(L' ', finalcut::FColor::Red));
+  CPPUNIT_ASSERT ( encoder.encode(colored.data(), colored.data() + colored.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == 20 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 5 + 20 );
+
+  model.background_color_erase = true;
+  CPPUNIT_ASSERT ( encoder.encode(colored.data(), colored.data() + colored.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == 1 );
+  CPPUNIT_ASSERT ( encoder.getPlan()[0].op == test::Operation::Erase );
+  CPPUNIT_ASSERT ( encoder.getCost() == 5 + 5 );
+
+  // Blanks up to the right margin
+  std::reverse (row.begin(), row.end());
+  model.reaches_eol = true;
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( plan.size() == 3 );
+  CPPUNIT_ASSERT ( plan[2].op == test::Operation::ClearToEOL );
+  CPPUNIT_ASSERT ( plan[2].x == 2 );
+  CPPUNIT_ASSERT ( plan[2].count == 20 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 1 + 1 + 3 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::skipTest()
+{
+  finalcut::FLineEncoder encoder{};
+  const auto model = test::createCostModel();
+  std::vector<finalcut::FChar> row{};
+  row.push_back (test::createCell(L'a'));
+  test::appendCells (row, 10, test::createCell(L'-', finalcut::FColor::Default, true));
+  row.push_back (test::createCell(L'b'));
+
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  const auto& plan = encoder.getPlan();
+  CPPUNIT_ASSERT ( plan.size() == 3 );
+  CPPUNIT_ASSERT ( plan[0].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( plan[1].op == test::Operation::Move );
+  CPPUNIT_ASSERT ( plan[1].x == 11 );
+  CPPUNIT_ASSERT ( plan[2].op == test::Operation::Print );
+  CPPUNIT_ASSERT ( plan[2].x == 11 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 1 + 6 + 1 );
+
+  // Reprinting a short unchanged run is cheaper than a cursor move
+  row.erase (row.begin() + 3, row.begin() + 11);
+  CPPUNIT_ASSERT ( row.size() == 4 );
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( plan.size() == 4 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 4 );
+
+  // Unchanged cells at the end are not written
+  row.pop_back();
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( plan.size() == 1 );
+  CPPUNIT_ASSERT ( encoder.getCost() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::greedyComparisonTest()
+{
+  finalcut::FLineEncoder optimal{};
+  finalcut::FLineEncoder greedy{};
+  const auto model = test::createCostModel();
+  const auto unchanged_red = test::createCell(L'b', finalcut::FColor::Red, true);
+
+  // An unchanged run in another color between two changed cells.
+  // The greedy encoder reprints it with two attribute changes.
+  std::vector<finalcut::FChar> row{};
+  row.push_back (test::createCell(L'a'));
+  test::appendCells (row, 5, unchanged_red);
+  row.push_back (test::createCell(L'c'));
+  const auto* first = row.data();
+  const auto* last = first + row.size();
+
+  CPPUNIT_ASSERT ( optimal.encode(first, last, term_attribute, model) );
+  greedy.encodeGreedy (first, last, term_attribute, model);
+  CPPUNIT_ASSERT ( optimal.getCost() == 1 + 6 + 1 );
+  CPPUNIT_ASSERT ( greedy.getCost() == 1 + 5 + 5 + 5 + 1 );
+  CPPUNIT_ASSERT ( test::isCompletePlan(optimal.getPlan(), row) );
+  CPPUNIT_ASSERT ( test::isCompletePlan(greedy.getPlan(), row) );
+
+  // Pseudo-random rows from a small alphabet of characters and colors
+  const std::array<wchar_t, 3> chars{{L' ', L'x', L'y'}};
+  const std::array<finalcut::FColor, 3> colors
+  {{
+    finalcut::FColor::Default,
+    finalcut::FColor::Red,
+    finalcut::FColor::Blue
+  }};
+  uInt32 seed{12345};
+  auto next = [&seed] (uInt32 range)
+  {
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 16) % range;
+  };
+  std::size_t strictly_better{0};
+
+  for (int round{0}; round < 500; round++)
+  {
+    row.clear();
+
+    while ( row.size() < 60 )
+    {
+      const auto cell = test::createCell ( chars[next(3)]
+                                         , colors[next(3)]
+                                         , next(4) == 0 );
+      test::appendCells (row, 1 + next(12), cell);
+    }
+
+    auto cost_model = model;
+    cost_model.background_color_erase = round % 2 == 0;
+    cost_model.reaches_eol = round % 3 == 0;
+    first = row.data();
+    last = first + row.size();
+
+    CPPUNIT_ASSERT ( optimal.encode(first, last, term_attribute, cost_model) );
+    greedy.encodeGreedy (first, last, term_attribute, cost_model);
+    CPPUNIT_ASSERT ( optimal.getCost() <= greedy.getCost() );
+    CPPUNIT_ASSERT ( optimal.getCost()
+                     == finalcut::FLineEncoder::getPlanCost ( optimal.getPlan(), first
+                                                            , term_attribute, cost_model ) );
+    CPPUNIT_ASSERT ( test::isCompletePlan(optimal.getPlan(), row) );
+    CPPUNIT_ASSERT ( test::isCompletePlan(greedy.getPlan(), row) );
+
+    if ( optimal.getCost() < greedy.getCost() )
+      strictly_better++;
+  }
+
+  CPPUNIT_ASSERT ( strictly_better > 0 );
+}
+
+//----------------------------------------------------------------------
+void FLineEncoderTest::attributeClassLimitTest()
+{
+  finalcut::FLineEncoder encoder{};
+  const auto model = test::createCostModel();
+  std::vector<finalcut::FChar> row{};
+
+  // The terminal attribute occupies the first class
+  for (auto i{1}; i < int(finalcut::FLineEncoder::MAX_ATTRIBUTE_CLASSES); i++)
+    row.push_back (test::createCell(L'x', finalcut::FColor(i)));
+
+  CPPUNIT_ASSERT ( encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().size() == row.size() );
+
+  row.push_back (test::createCell(L'x', finalcut::FColor(100)));
+  CPPUNIT_ASSERT ( ! encoder.encode(row.data(), row.data() + row.size(), term_attribute, model) );
+  CPPUNIT_ASSERT ( encoder.getPlan().empty() );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FLineEncoderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -1657,6 +1657,49 @@ void FMouseTest::mouseControlTest()
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(3, 4) );
   CPPUNIT_ASSERT ( ! mouse_control.getCurrentMouseEvent() );
   CPPUNIT_ASSERT ( ! mouse_control.isMoved() );
+  mouse_control.processQueuedInput();
+
+  // Consecutive mouse movements with the same button state
+  // are combined into one event
+  std::vector<finalcut::FMouseData> events{};
+  auto cmd4 = [&events] (const finalcut::FMouseData& md)
+              {
+                events.push_back(md);
+              };
+  mouse_control.setEventCommand (finalcut::FMouseCommand(cmd4));
+  auto rawdata6 = insertData ({ 0x1b, '[', '<', '0', ';', '5', ';', '5', 'M'
+                              , 0x1b, '[', '<', '3', '2', ';', '6', ';', '5', 'M'
+                              , 0x1b, '[', '<', '3', '2', ';', '7', ';', '5', 'M'
+                              , 0x1b, '[', '<', '3', '2', ';', '8', ';', '6', 'M'
+                              , 0x1b, '[', '<', '3', '6', ';', '9', ';', '6', 'M'
+                              , 0x1b, '[', '<', '3', '6', ';', '9', ';', '7', 'M'
+                              , 0x1b, '[', '<', '0', ';', '9', ';', '7', 'm' });
+  tv = finalcut::FObjectTimer::getCurrentTime();
+
+  for (int i{0}; i < 7; i++)
+  {
+    mouse_control.setRawData (finalcut::FMouse::MouseType::Sgr, rawdata6);
+    mouse_control.processEvent (tv);
+  }
+
+  CPPUNIT_ASSERT ( ! mouse_control.hasUnprocessedInput() );
+  mouse_control.processQueuedInput();
+  CPPUNIT_ASSERT ( ! mouse_control.hasDataInQueue() );
+  CPPUNIT_ASSERT ( events.size() == 4 );
+  CPPUNIT_ASSERT ( events[0].isLeftButtonPressed() );
+  CPPUNIT_ASSERT ( ! events[0].isMoved() );
+  CPPUNIT_ASSERT ( events[0].getPos() == finalcut::FPoint(5, 5) );
+  CPPUNIT_ASSERT ( events[1].isLeftButtonPressed() );
+  CPPUNIT_ASSERT ( events[1].isMoved() );
+  CPPUNIT_ASSERT ( ! events[1].isShiftKeyPressed() );
+  CPPUNIT_ASSERT ( events[1].getPos() == finalcut::FPoint(8, 6) );
+  CPPUNIT_ASSERT ( events[2].isLeftButtonPressed() );
+  CPPUNIT_ASSERT ( events[2].isMoved() );
+  CPPUNIT_ASSERT ( events[2].isShiftKeyPressed() );
+  CPPUNIT_ASSERT ( events[2].getPos() == finalcut::FPoint(9, 7) );
+  CPPUNIT_ASSERT ( events[3].isLeftButtonReleased() );
+  CPPUNIT_ASSERT ( ! events[3].isMoved() );
+  CPPUNIT_ASSERT ( events[3].getPos() == finalcut::FPoint(9, 7) );
 
   mouse_control.disable();
 }
@@ -67,6 +67,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void vga2ansiTest();
     void sgrOptimizerTest();
     void fakeReverseTest();
+    void transitionCacheTest();
     void ansiTest();
     void vt100Test();
     void xtermTest();
@@ -91,6 +92,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (vga2ansiTest);
     CPPUNIT_TEST (sgrOptimizerTest);
     CPPUNIT_TEST (fakeReverseTest);
+    CPPUNIT_TEST (transitionCacheTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
     CPPUNIT_TEST (xtermTest);
@@ -461,6 +463,147 @@ void FOptiAttrTest::fakeReverseTest()
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::transitionCacheTest()
+{
+  finalcut::FStartOptions::getInstance().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (8);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode ({CSI "1m", 4});
+  oa.set_exit_bold_mode ({CSI "0m", 4});
+  oa.set_exit_attribute_mode ({CSI "0m", 4});
+  oa.set_a_foreground_color ({CSI "3%p1%dm", 9});
+  oa.set_a_background_color ({CSI "4%p1%dm", 9});
+  oa.set_orig_pair ({CSI "39;49m", 8});
+  oa.initialize();
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 0 );
+
+  finalcut::FChar term{};
+  term.color = {finalcut::FColor::Default, finalcut::FColor::Default};
+  finalcut::FChar next{};
+  next.attr.bit()->bold = true;
+  next.attr.bit()->printed = true;
+  next.color = {finalcut::FColor::Red, finalcut::FColor::Default};
+  const finalcut::FChar start_term{term};
+  const finalcut::FChar start_next{next};
+
+  // First transition is calculated
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "31m" CSI "1m" );
+  CPPUNIT_ASSERT ( term == next );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+  const finalcut::FChar result_term{term};
+
+  // The same transition comes from the cache
+  term = start_term;
+  next = start_next;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "31m" CSI "1m" );
+  CPPUNIT_ASSERT ( term == result_term );
+  CPPUNIT_ASSERT ( term.attr.data == result_term.attr.data );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 1 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // Bits outside the attribute mask are not part of the key
+  term = start_term;
+  next = start_next;
+  next.attr.bit()->printed = false;
+  next.attr.bit()->char_width = 2;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "31m" CSI "1m" );
+  CPPUNIT_ASSERT ( next.attr.bit()->char_width == 2 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 2 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // A reset keeps only the protected bits of the terminal cell
+  finalcut::FChar bold_term{result_term};
+  bold_term.attr.bit()->printed = true;
+  bold_term.attr.bit()->char_width = 1;
+  next = {};
+  next.color = {finalcut::FColor::Default, finalcut::FColor::Default};
+
+  for (auto i{0}; i < 2; i++)
+  {
+    term = bold_term;
+    finalcut::FChar to{next};
+    CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, to).data
+                          , CSI "0m" );
+    CPPUNIT_ASSERT ( ! term.attr.bit()->bold );
+    CPPUNIT_ASSERT ( term.attr.bit()->printed );
+    CPPUNIT_ASSERT ( term.attr.bit()->char_width == 0 );
+  }
+
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 3 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 2 );
+
+  // Transitions without changes are cached as well
+  term = result_term;
+  next = result_term;
+  CPPUNIT_ASSERT ( ! oa.changeAttribute(term, next).data );
+  CPPUNIT_ASSERT ( ! oa.changeAttribute(term, next).data );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 4 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 3 );
+
+  // Simulated invisible characters
+  for (auto i{0}; i < 2; i++)
+  {
+    term = start_term;
+    next = start_next;
+    next.encoded_char.unicode_data[0] = L'A';
+    next.attr.bit()->invisible = true;
+    oa.changeAttribute(term, next);
+    CPPUNIT_ASSERT ( next.encoded_char.unicode_data[0] == L' ' );
+  }
+
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 5 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 4 );
+
+  // A changed capability invalidates the cache
+  oa.set_enter_bold_mode ({CSI "22;1m", 7});
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 0 );
+  term = start_term;
+  next = start_next;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "31m" CSI "22;1m" );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // A changed number of colors invalidates the cache
+  oa.setMaxColor (1);
+  oa.initialize();
+  term = start_term;
+  next = start_next;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "22;1m" );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // The cache can also be cleared explicitly
+  oa.clearTransitionCache();
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 0 );
+  term = start_term;
+  next = start_next;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next).data
+                        , CSI "22;1m" );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // Length queries neither change the cells nor the statistics
+  CPPUNIT_ASSERT ( oa.getAttributeChangeLength(start_term, start_next) == 7 );
+  CPPUNIT_ASSERT ( oa.getAttributeChangeLength(start_term, start_term) == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+  term = start_term;
+  next = start_term;
+  CPPUNIT_ASSERT ( ! oa.changeAttribute(term, next).data );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 1 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+}
+
 //----------------------------------------------------------------------
 void FOptiAttrTest::ansiTest()
 {
@@ -139,6 +139,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     void puttyTest();
     void teratermTest();
     void wyse50Test();
+    void scrollRegionTest();
 
   private:
     auto printSequence (const std::string&) -> std::string;
@@ -160,6 +161,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (puttyTest);
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (scrollRegionTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -871,6 +873,67 @@ void FOptiMoveTest::wyse50Test()
   finalcut::printDurations(om);
 }
 
+//----------------------------------------------------------------------
+void FOptiMoveTest::scrollRegionTest()
+{
+  finalcut::FTermcap::clearMotionCache();
+  finalcut::FOptiMove om;
+  om.setTermSize (80, 25);
+  om.setBaudRate (38400);
+  om.set_cursor_address ({CSI "%i%p1%d;%p2%dH", 16});
+
+  // Without scrolling capabilities
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 1).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 1).length == 0 );
+
+  om.set_scroll_forward ({"\n", 1});
+  om.set_scroll_reverse ({ESC "M", 2});
+  CPPUNIT_ASSERT ( om.getScrollForwardLength() == 1 );
+  CPPUNIT_ASSERT ( om.getScrollReverseLength() == 2 );
+
+  // Without a scrolling region
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 1).data == nullptr );
+
+  om.set_change_scroll_region ({CSI "%i%p1%d;%p2%dr", 15});
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(2, 20, 1).data
+                        , CSI "3;21r" CSI "21;1H" "\n" CSI "1;25r" );
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 1).length == 22 );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(0, 24, 5).data
+                        , CSI "1;25r" CSI "25;1H" "\n\n\n\n\n" CSI "1;25r" );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(5, 10, -2).data
+                        , CSI "6;11r" CSI "6;1H" ESC "M" ESC "M" CSI "1;25r" );
+
+  // Parameterized scrolling for many lines
+  om.set_parm_index ({CSI "%p1%dS", 7});
+  om.set_parm_rindex ({CSI "%p1%dT", 7});
+  CPPUNIT_ASSERT ( om.getParmIndexLength() == 5 );
+  CPPUNIT_ASSERT ( om.getParmRindexLength() == 5 );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(2, 20, 3).data
+                        , CSI "3;21r" CSI "21;1H" "\n\n\n" CSI "1;25r" );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(0, 24, 5).data
+                        , CSI "1;25r" CSI "25;1H" CSI "5S" CSI "1;25r" );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(5, 10, -2).data
+                        , CSI "6;11r" CSI "6;1H" ESC "M" ESC "M" CSI "1;25r" );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(5, 10, -3).data
+                        , CSI "6;11r" CSI "6;1H" CSI "3T" CSI "1;25r" );
+
+  // Invalid regions
+  CPPUNIT_ASSERT ( om.scrollRegion(10, 5, 1).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(5, 5, 1).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(-1, 5, 1).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(0, 25, 1).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 4, 3).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 4, -3).data == nullptr );
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 0).data == nullptr );
+
+  // Only reverse scrolling
+  om.set_scroll_forward ({nullptr, 0});
+  om.set_parm_index ({nullptr, 0});
+  CPPUNIT_ASSERT ( om.scrollRegion(2, 20, 1).data == nullptr );
+  CPPUNIT_ASSERT_STRING ( om.scrollRegion(2, 20, -1).data
+                        , CSI "3;21r" CSI "3;1H" ESC "M" CSI "1;25r" );
+}
+
 //----------------------------------------------------------------------
 auto FOptiMoveTest::printSequence (const std::string& s) -> std::string
 {
@@ -0,0 +1,295 @@
+/***********************************************************************
+* frowscanner-test.cpp - FRowScanner unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto createRow (std::size_t length) -> std::vector<finalcut::FChar>
+{
+  finalcut::FChar blank{};
+  blank.ch[0] = L' ';
+  blank.color = {finalcut::FColor::Black, finalcut::FColor::White};
+  blank.setCharWidth (1);
+  blank.setBit (finalcut::FAttribute::set::no_changes, true);
+  return std::vector<finalcut::FChar>(length, blank);
+}
+
+//----------------------------------------------------------------------
+auto referenceCountEqual ( const finalcut::FChar* first
+                         , const finalcut::FChar* last
+                         , const finalcut::FChar& ref ) -> std::size_t
+{
+  std::size_t count{0};
+
+  while ( first + count < last && first[count] == ref )
+    count++;
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+auto referenceCountEqualReverse ( const finalcut::FChar* first
+                                , const finalcut::FChar* last
+                                , const finalcut::FChar& ref ) -> std::size_t
+{
+  std::size_t count{0};
+
+  while ( last - count > first && *(last - count - 1) == ref )
+    count++;
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+auto referenceCountUnchanged ( const finalcut::FChar* first
+                             , const finalcut::FChar* last ) -> std::size_t
+{
+  std::size_t count{0};
+
+  while ( first + count < last
+       && first[count].isBitSet(finalcut::FAttribute::set::no_changes) )
+    count++;
+
+  return count;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FRowScannerTest
+//----------------------------------------------------------------------
+
+class FRowScannerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FRowScannerTest() = default;
+
+  protected:
+    void kernelTest();
+    void countEqualTest();
+    void countEqualReverseTest();
+    void countUnchangedTest();
+    void kernelComparisonTest();
+
+  private:
+    using Kernel = finalcut::FRowScanner::Kernel;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FRowScannerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelTest);
+    CPPUNIT_TEST (countEqualTest);
+    CPPUNIT_TEST (countEqualReverseTest);
+    CPPUNIT_TEST (countUnchangedTest);
+    CPPUNIT_TEST (kernelComparisonTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    const std::array<Kernel, 3> kernels{{Kernel::Scalar, Kernel::SSE2, Kernel::AVX2}};
+};
+
+//----------------------------------------------------------------------
+void FRowScannerTest::kernelTest()
+{
+  const auto default_kernel = finalcut::FRowScanner::getKernel();
+  finalcut::FRowScanner::setKernel (Kernel::Scalar);
+  CPPUNIT_ASSERT ( finalcut::FRowScanner::getKernel() == Kernel::Scalar );
+
+  // Unsupported kernels fall back to the next smaller one
+  finalcut::FRowScanner::setKernel (Kernel::AVX2);
+  CPPUNIT_ASSERT ( finalcut::FRowScanner::getKernel() == default_kernel );
+}
+
+//----------------------------------------------------------------------
+void FRowScannerTest::countEqualTest()
+{
+  for (const auto kernel : kernels)
+  {
+    finalcut::FRowScanner::setKernel (kernel);
+    auto row = test::createRow(80);
+    const auto* first = row.data();
+    const auto* last = first + row.size();
+    const auto blank = row[0];
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 80 );
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, first, blank) == 0 );
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, first + 1, blank) == 1 );
+
+    // Non-compared bits do not interrupt the run
+    row[10].setBit (finalcut::FAttribute::set::printed, true);
+    row[11].encoded_char[0] = L'x';
+    row[12].setBit (finalcut::FAttribute::set::no_changes, false);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 80 );
+
+    // Different characters, colors or attributes end the run
+    row[41].ch[0] = L'x';
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 41 );
+    row[30].ch[4] = L'\U00000301';
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 30 );
+    row[17].color.setFgColor (finalcut::FColor::Red);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 17 );
+    row[2].setBit (finalcut::FAttribute::set::bold, true);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 2 );
+    row[0].setBit (finalcut::FAttribute::set::reverse, true);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(first, last, blank) == 0 );
+  }
+
+  finalcut::FRowScanner::setKernel (Kernel::AVX2);
+}
+
+//----------------------------------------------------------------------
+void FRowScannerTest::countEqualReverseTest()
+{
+  for (const auto kernel : kernels)
+  {
+    finalcut::FRowScanner::setKernel (kernel);
+    auto row = test::createRow(81);
+    const auto* first = row.data();
+    const auto* last = first + row.size();
+    const auto blank = row[0];
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 81 );
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(last, last, blank) == 0 );
+
+    row[79].setBit (finalcut::FAttribute::set::printed, true);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 81 );
+    row[20].ch[0] = L'x';
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 60 );
+    row[77].setBit (finalcut::FAttribute::set::underline, true);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 3 );
+    row[78].color.setBgColor (finalcut::FColor::Blue);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 2 );
+    row[80].ch[0] = L'y';
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, last, blank) == 0 );
+  }
+
+  finalcut::FRowScanner::setKernel (Kernel::AVX2);
+}
+
+//----------------------------------------------------------------------
+void FRowScannerTest::countUnchangedTest()
+{
+  for (const auto kernel : kernels)
+  {
+    finalcut::FRowScanner::setKernel (kernel);
+    auto row = test::createRow(33);
+    const auto* first = row.data();
+    const auto* last = first + row.size();
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(first, last) == 33 );
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(last, last) == 0 );
+
+    // Only the no_changes bit is relevant
+    row[5].ch[0] = L'x';
+    row[6].color.setFgColor (finalcut::FColor::Green);
+    row[7].setBit (finalcut::FAttribute::set::bold, true);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(first, last) == 33 );
+
+    row[32].setBit (finalcut::FAttribute::set::no_changes, false);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(first, last) == 32 );
+    row[9].setBit (finalcut::FAttribute::set::no_changes, false);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(first, last) == 9 );
+    row[0].setBit (finalcut::FAttribute::set::no_changes, false);
+    CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(first, last) == 0 );
+  }
+
+  finalcut::FRowScanner::setKernel (Kernel::AVX2);
+}
+
+//----------------------------------------------------------------------
+void FRowScannerTest::kernelComparisonTest()
+{
+  // All kernels must give the same results as FChar::operator==
+
+  auto row = test::createRow(64);
+  const auto* first = row.data();
+  const auto* last = first + row.size();
+  const auto blank = row[0];
+
+  for (std::size_t pos{0}; pos < row.size(); pos++)
+  {
+    auto& fchar = row[pos];
+
+    switch ( pos % 5 )
+    {
+      case 0:
+        fchar.ch[0] = L'0' + wchar_t(pos % 10);
+        break;
+
+      case 1:
+        fchar.setBit (finalcut::FAttribute::set::no_changes, false);
+        break;
+
+      case 2:
+        fchar.setBit (finalcut::FAttribute::set::dim, true);
+        break;
+
+      case 3:
+        fchar.color.setBgColor (finalcut::FColor::Cyan);
+        break;
+
+      default:
+        break;
+    }
+
+    for (const auto kernel : kernels)
+    {
+      finalcut::FRowScanner::setKernel (kernel);
+
+      for (std::size_t start{0}; start < row.size(); start += 7)
+      {
+        const auto* begin = first + start;
+        CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqual(begin, last, blank)
+                         == test::referenceCountEqual(begin, last, blank) );
+        CPPUNIT_ASSERT ( finalcut::FRowScanner::countEqualReverse(first, begin, blank)
+                         == test::referenceCountEqualReverse(first, begin, blank) );
+        CPPUNIT_ASSERT ( finalcut::FRowScanner::countUnchanged(begin, last)
+                         == test::referenceCountUnchanged(begin, last) );
+      }
+    }
+
+    // Restore the blank character for the next round
+    fchar = blank;
+  }
+
+  finalcut::FRowScanner::setKernel (Kernel::AVX2);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FRowScannerTest);
+
+// The general unit test main part
+#include <main-test.inc>
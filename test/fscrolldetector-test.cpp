@@ -0,0 +1,209 @@
+/***********************************************************************
+* fscrolldetector-test.cpp - FScrollDetector unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FScrollDetectorTest
+//----------------------------------------------------------------------
+
+class FScrollDetectorTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FScrollDetectorTest() = default;
+
+  protected:
+    void noArgumentTest();
+    void unchangedTest();
+    void scrollUpTest();
+    void scrollDownTest();
+    void repeatedLinesTest();
+    void largestBlockTest();
+
+  private:
+    using FHashList = finalcut::FScrollDetector::FHashList;
+    using FScrollBlock = finalcut::FScrollDetector::FScrollBlock;
+
+    static auto find ( finalcut::FScrollDetector&
+                     , const FHashList&, const FHashList& ) -> FScrollBlock;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FScrollDetectorTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (unchangedTest);
+    CPPUNIT_TEST (scrollUpTest);
+    CPPUNIT_TEST (scrollDownTest);
+    CPPUNIT_TEST (repeatedLinesTest);
+    CPPUNIT_TEST (largestBlockTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+auto FScrollDetectorTest::find ( finalcut::FScrollDetector& detector
+                               , const FHashList& old_lines
+                               , const FHashList& new_lines ) -> FScrollBlock
+{
+  detector.getOldLines() = old_lines;
+  detector.getNewLines() = new_lines;
+  return detector.findScrollBlock();
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::noArgumentTest()
+{
+  finalcut::FScrollDetector detector{};
+  CPPUNIT_ASSERT ( detector.getOldLines().empty() );
+  CPPUNIT_ASSERT ( detector.getNewLines().empty() );
+  auto block = detector.findScrollBlock();
+  CPPUNIT_ASSERT ( block.distance == 0 );
+
+  // A single line cannot scroll
+  block = find (detector, {1}, {2});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+
+  // Different number of lines
+  block = find (detector, {1, 2, 3}, {2, 3});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::unchangedTest()
+{
+  finalcut::FScrollDetector detector{};
+  auto block = find (detector, {1, 2, 3, 4}, {1, 2, 3, 4});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+
+  // Changed content without moved lines
+  block = find (detector, {1, 2, 3, 4}, {5, 6, 7, 8});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+
+  block = find (detector, {1, 2, 3, 4}, {1, 9, 3, 4});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::scrollUpTest()
+{
+  finalcut::FScrollDetector detector{};
+
+  // One line up, a new line at the bottom
+  auto block = find (detector, {1, 2, 3, 4, 5}, {2, 3, 4, 5, 6});
+  CPPUNIT_ASSERT ( block.top == 0 );
+  CPPUNIT_ASSERT ( block.bottom == 4 );
+  CPPUNIT_ASSERT ( block.distance == 1 );
+
+  // Three lines up inside a fixed header and footer
+  block = find ( detector
+               , {10, 1, 2, 3, 4, 5, 6, 7, 20}
+               , {10, 4, 5, 6, 7, 8, 9, 0, 20} );
+  CPPUNIT_ASSERT ( block.top == 1 );
+  CPPUNIT_ASSERT ( block.bottom == 7 );
+  CPPUNIT_ASSERT ( block.distance == 3 );
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::scrollDownTest()
+{
+  finalcut::FScrollDetector detector{};
+
+  // One line down, a new line at the top
+  auto block = find (detector, {1, 2, 3, 4, 5}, {0, 1, 2, 3, 4});
+  CPPUNIT_ASSERT ( block.top == 0 );
+  CPPUNIT_ASSERT ( block.bottom == 4 );
+  CPPUNIT_ASSERT ( block.distance == -1 );
+
+  // Two lines down inside a fixed header and footer
+  block = find ( detector
+               , {10, 1, 2, 3, 4, 5, 20}
+               , {10, 8, 9, 1, 2, 3, 20} );
+  CPPUNIT_ASSERT ( block.top == 1 );
+  CPPUNIT_ASSERT ( block.bottom == 5 );
+  CPPUNIT_ASSERT ( block.distance == -2 );
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::repeatedLinesTest()
+{
+  finalcut::FScrollDetector detector{};
+
+  // Empty lines (0) are not unique, but belong to the moved block
+  auto block = find ( detector
+                    , {1, 0, 0, 2, 3, 0, 4, 5}
+                    , {0, 0, 2, 3, 0, 4, 5, 6} );
+  CPPUNIT_ASSERT ( block.top == 0 );
+  CPPUNIT_ASSERT ( block.bottom == 7 );
+  CPPUNIT_ASSERT ( block.distance == 1 );
+
+  // Only repeated lines cannot be assigned
+  block = find (detector, {0, 0, 0, 0}, {0, 0, 0, 7});
+  CPPUNIT_ASSERT ( block.distance == 0 );
+}
+
+//----------------------------------------------------------------------
+void FScrollDetectorTest::largestBlockTest()
+{
+  finalcut::FScrollDetector detector{};
+
+  // The lines 0-1 move down and the lines 4-8 move up
+  // => the larger block wins
+  auto block = find ( detector
+                    , {1, 2, 30, 31, 40, 41, 42, 43, 44, 45}
+                    , {9, 1, 2, 40, 41, 42, 43, 44, 45, 50} );
+  CPPUNIT_ASSERT ( block.top == 3 );
+  CPPUNIT_ASSERT ( block.bottom == 9 );
+  CPPUNIT_ASSERT ( block.distance == 1 );
+
+  // Large number of lines
+  FHashList old_lines{};
+  FHashList new_lines{};
+
+  for (uInt64 i{0}; i < 200; i++)
+  {
+    old_lines.push_back(i + 1000);
+    new_lines.push_back(i + 1000 + 7);
+  }
+
+  block = find (detector, old_lines, new_lines);
+  CPPUNIT_ASSERT ( block.top == 0 );
+  CPPUNIT_ASSERT ( block.bottom == 199 );
+  CPPUNIT_ASSERT ( block.distance == 7 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FScrollDetectorTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -61,6 +61,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     void rgb2ColorIndexTest();
     void isReverseNewFontcharTest();
     void cp437Test();
+    void charEncodeTest();
     void utf8Test();
     void FullWidthHalfWidthTest();
     void combiningCharacterTest();
@@ -123,6 +124,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (rgb2ColorIndexTest);
     CPPUNIT_TEST (isReverseNewFontcharTest);
     CPPUNIT_TEST (cp437Test);
+    CPPUNIT_TEST (charEncodeTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (FullWidthHalfWidthTest);
     CPPUNIT_TEST (combiningCharacterTest);
@@ -392,6 +394,46 @@ void FTermFunctionsTest::cp437Test()
   CPPUNIT_ASSERT ( finalcut::unicode_to_cp437(L'⌡') == 0xf5 );
 }
 
+//----------------------------------------------------------------------
+void FTermFunctionsTest::charEncodeTest()
+{
+  const auto& char_map = finalcut::FCharMap::getCharEncodeMap();
+
+  // Every map entry is found at its own position
+  for (const auto& entry : char_map)
+  {
+    const auto* found = finalcut::FCharMap::findCharEncode(entry.encoding.unicode);
+    CPPUNIT_ASSERT ( found != nullptr );
+    CPPUNIT_ASSERT ( found->encoding.unicode == entry.encoding.unicode );
+  }
+
+  // Characters without an entry
+  CPPUNIT_ASSERT ( finalcut::FCharMap::findCharEncode(L'A') == nullptr );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::findCharEncode(L'\0') == nullptr );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::findCharEncode(L'Ж') == nullptr );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::findCharEncode(wchar_t(0x1f600)) == nullptr );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::findCharEncode(wchar_t(-1)) == nullptr );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'A', finalcut::Encoding::VT100) == L'A' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'Ж', finalcut::Encoding::PC) == L'Ж' );
+
+  // Encoded characters
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', finalcut::Encoding::VT100) == L'q' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', finalcut::Encoding::PC) == 0xc4 );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', finalcut::Encoding::ASCII) == L'-' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', finalcut::Encoding::UTF8) == L'─' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'█', finalcut::Encoding::PC) == 0xdb );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'█', finalcut::Encoding::ASCII) == L'#' );
+
+  // Changes to the map are visible immediately
+  auto& entry = const_cast<finalcut::FCharMap::CharEncodeMap&>
+                (*finalcut::FCharMap::findCharEncode(L'█'));
+  const auto pc = entry.encoding.pc;
+  entry.encoding.pc = L'#';
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'█', finalcut::Encoding::PC) == L'#' );
+  entry.encoding.pc = pc;
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'█', finalcut::Encoding::PC) == 0xdb );
+}
+
 //----------------------------------------------------------------------
 void FTermFunctionsTest::utf8Test()
 {
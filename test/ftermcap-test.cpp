@@ -97,6 +97,7 @@ class FTermcapTest : public CPPUNIT_NS::TestFixture
     void encodeMotionParameterTest();
     void encodeParameterTest();
     void paddingPrintTest();
+    void paddingEncodeTest();
     void stringPrintTest();
 
   private:
@@ -116,6 +117,7 @@ class FTermcapTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (encodeMotionParameterTest);
     CPPUNIT_TEST (encodeParameterTest);
     CPPUNIT_TEST (paddingPrintTest);
+    CPPUNIT_TEST (paddingEncodeTest);
     CPPUNIT_TEST (stringPrintTest);
 
     // End of test suite definition
@@ -561,6 +563,70 @@ void FTermcapTest::paddingPrintTest()
   output.clear();
 }
 
+//----------------------------------------------------------------------
+void FTermcapTest::paddingEncodeTest()
+{
+  finalcut::FTermcap tcap;
+  setenv ("TERM", "xterm", 1);  // xterm has no padding character
+  unsetenv("TERMCAP");
+  auto& fterm_data = finalcut::FTermData::getInstance();
+  fterm_data.setTermType("xterm");
+  tcap.init();
+  CPPUNIT_ASSERT ( tcap.no_padding_char );
+  std::string encoded{};
+
+  // With an empty string
+  auto status = tcap.paddingEncode ({}, 0, 1, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::Error );
+  CPPUNIT_ASSERT ( encoded.empty() );
+
+  // '$' without '<' and a defective padding specification
+  status = tcap.paddingEncode ("12$3$<x>4567", 12, 1, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::OK );
+  CPPUNIT_ASSERT ( encoded == "12$3$<x>4567" );
+
+  // A non-mandatory delay is removed
+  tcap.padding_baudrate = 0;  // no padding baudrate
+  encoded.clear();
+  status = tcap.paddingEncode ("1234$<5>567", 11, 1, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::OK );
+  CPPUNIT_ASSERT ( encoded == "1234567" );
+
+  // A mandatory delay cannot be encoded without a padding character
+  encoded.clear();
+  status = tcap.paddingEncode ("\033[?5h$<100/>\033[?5l", 17, 1, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::Error );
+
+  // The output is appended to the existing string
+  setenv ("TERM", "ansi", 1);  // ansi terminals used for delay padding character
+  fterm_data.setTermType("ansi");
+  tcap.init();
+  CPPUNIT_ASSERT ( ! tcap.no_padding_char );
+  tcap.setBaudrate (9600);
+  tcap.padding_baudrate = 0;  // no padding baudrate
+  encoded = "xyz";
+  status = tcap.paddingEncode ("abc$<2*/>def", 12, 2, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::OK );
+  const auto& str_with_0 = "xyzabc" "\0\0\0\0" "def";
+  const std::string target_output(std::begin(str_with_0), std::end(str_with_0) - 1);
+  CPPUNIT_ASSERT ( encoded.length() == 13 );
+  CPPUNIT_ASSERT ( encoded == target_output );
+
+  // The same result as with paddingPrint()
+  tcap.setPutCharFunction (FTermcapTest::putchar_test);
+  tcap.setPutStringFunction (FTermcapTest::putstring_test);
+  tcap.setBaudrate (38400);
+  output.clear();
+  encoded.clear();
+  status = tcap.paddingPrint ("1234$<5*/>567", 13, 1);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::OK );
+  status = tcap.paddingEncode ("1234$<5*/>567", 13, 1, encoded);
+  CPPUNIT_ASSERT ( status == finalcut::FTermcap::Status::OK );
+  CPPUNIT_ASSERT ( encoded.length() == 28 );
+  CPPUNIT_ASSERT ( encoded == output );
+  output.clear();
+}
+
 //----------------------------------------------------------------------
 void FTermcapTest::stringPrintTest()
 {
@@ -0,0 +1,282 @@
+/***********************************************************************
+* ftermcapprogram-test.cpp - FTermcapProgram unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstring>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto compile (finalcut::FTermcapProgram& program, const char* string) -> bool
+{
+  return program.compile(string, std::strlen(string));
+}
+
+//----------------------------------------------------------------------
+template <typename... Args>
+auto format (const finalcut::FTermcapProgram& program, Args&&... args) -> std::string
+{
+  std::string output{};
+  program.format({{static_cast<int>(args)...}}, output);
+  return output;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FTermcapProgramTest
+//----------------------------------------------------------------------
+
+class FTermcapProgramTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermcapProgramTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void literalTest();
+    void parameterTest();
+    void arithmeticTest();
+    void formatTest();
+    void conditionalTest();
+    void variableTest();
+    void unsupportedTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermcapProgramTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (literalTest);
+    CPPUNIT_TEST (parameterTest);
+    CPPUNIT_TEST (arithmeticTest);
+    CPPUNIT_TEST (formatTest);
+    CPPUNIT_TEST (conditionalTest);
+    CPPUNIT_TEST (variableTest);
+    CPPUNIT_TEST (unsupportedTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::classNameTest()
+{
+  const finalcut::FTermcapProgram program{};
+  const finalcut::FString& classname = program.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermcapProgram" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::noArgumentTest()
+{
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( ! program.isCompiled() );
+  CPPUNIT_ASSERT ( program.getSource().empty() );
+  CPPUNIT_ASSERT ( test::format(program, 1, 2) == "" );
+  CPPUNIT_ASSERT ( ! program.compile(nullptr, 0) );
+  CPPUNIT_ASSERT ( ! program.isSource(nullptr, 0) );
+
+  // An empty string
+  CPPUNIT_ASSERT ( program.compile("", 0) );
+  CPPUNIT_ASSERT ( program.isCompiled() );
+  CPPUNIT_ASSERT ( test::format(program) == "" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::literalTest()
+{
+  const finalcut::FTermcapProgram program{CSI "?25h", 6};
+  CPPUNIT_ASSERT ( program.isCompiled() );
+  CPPUNIT_ASSERT ( program.getSource() == CSI "?25h" );
+  CPPUNIT_ASSERT ( program.isSource(CSI "?25h", 6) );
+  CPPUNIT_ASSERT ( ! program.isSource(CSI "?25l", 6) );
+  CPPUNIT_ASSERT ( ! program.isSource(CSI "?25", 5) );
+  CPPUNIT_ASSERT ( test::format(program) == CSI "?25h" );
+
+  // Padding specifications remain for the output
+  finalcut::FTermcapProgram padding{};
+  CPPUNIT_ASSERT ( test::compile(padding, "%%$<100/>%%") );
+  CPPUNIT_ASSERT ( test::format(padding) == "%$<100/>%" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::parameterTest()
+{
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( test::compile(program, CSI "%i%p1%d;%p2%dH") );
+  CPPUNIT_ASSERT ( test::format(program, 0, 0) == CSI "1;1H" );
+  CPPUNIT_ASSERT ( test::format(program, 23, 79) == CSI "24;80H" );
+  CPPUNIT_ASSERT ( test::format(program, -5, 1234567) == CSI "-4;1234568H" );
+  CPPUNIT_ASSERT ( test::format(program, -2147483647 - 1, 2147483646)
+                   == CSI "-2147483647;2147483647H" );
+
+  // %i increments the first two parameters only once
+  CPPUNIT_ASSERT ( test::compile(program, "%i%i%p1%d,%p2%d,%p3%d") );
+  CPPUNIT_ASSERT ( test::format(program, 1, 2, 3) == "2,3,3" );
+
+  // All nine parameters
+  CPPUNIT_ASSERT ( test::compile(program, "%p9%d%p8%d%p7%d%p6%d%p5%d%p4%d%p3%d%p2%d%p1%d") );
+  CPPUNIT_ASSERT ( test::format(program, 1, 2, 3, 4, 5, 6, 7, 8, 9) == "987654321" );
+
+  // Character output and character constants
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%c%'A'%c%{66}%c%p2%c") );
+  CPPUNIT_ASSERT ( test::format(program, 'x', 0) == "xAB\200" );
+
+  // Popping an empty stack results in 0
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%d%d") );
+  CPPUNIT_ASSERT ( test::format(program, 7) == "70" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::arithmeticTest()
+{
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%p2%+%d %p1%p2%-%d %p1%p2%*%d "
+                                          "%p1%p2%/%d %p1%p2%m%d") );
+  CPPUNIT_ASSERT ( test::format(program, 17, 5) == "22 12 85 3 2" );
+
+  // Division by zero
+  CPPUNIT_ASSERT ( test::format(program, 17, 0) == "17 17 0 0 0" );
+
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%p2%&%d %p1%p2%|%d %p1%p2%^%d "
+                                          "%p1%~%d %p1%!%d %p2%!%d") );
+  CPPUNIT_ASSERT ( test::format(program, 12, 10) == "8 14 6 -13 0 0" );
+  CPPUNIT_ASSERT ( test::format(program, 0, 3) == "0 3 3 -1 1 0" );
+
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%p2%=%d%p1%p2%>%d%p1%p2%<%d"
+                                          "%p1%p2%A%d%p1%p2%O%d") );
+  CPPUNIT_ASSERT ( test::format(program, 3, 3) == "10011" );
+  CPPUNIT_ASSERT ( test::format(program, 4, 0) == "01001" );
+  CPPUNIT_ASSERT ( test::format(program, 0, 0) == "10000" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::formatTest()
+{
+  // Initialize color (xterm)
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( test::compile(program, OSC "4;%p1%d;rgb:"
+                                          "%p2%{255}%*%{1000}%/%2.2X/"
+                                          "%p3%{255}%*%{1000}%/%2.2X/"
+                                          "%p4%{255}%*%{1000}%/%2.2X" ESC "\\") );
+  CPPUNIT_ASSERT ( test::format(program, 9, 1000, 0, 502) == OSC "4;9;rgb:FF/00/80" ESC "\\" );
+
+  CPPUNIT_ASSERT ( test::compile(program, "%p1%x|%p1%X|%p1%o|%p1%#x|%p1%03d|%p1%:-4d|%p1%:+d") );
+  CPPUNIT_ASSERT ( test::format(program, 42) == "2a|2A|52|0x2a|042|42  |+42" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::conditionalTest()
+{
+  // Set foreground color (xterm-256color)
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( test::compile(program, CSI "%?%p1%{8}%<%t3%p1%d"
+                                          "%e%p1%{16}%<%t9%p1%{8}%-%d"
+                                          "%e38;5;%p1%d%;m") );
+  CPPUNIT_ASSERT ( test::format(program, 1) == CSI "31m" );
+  CPPUNIT_ASSERT ( test::format(program, 12) == CSI "94m" );
+  CPPUNIT_ASSERT ( test::format(program, 200) == CSI "38;5;200m" );
+
+  // Nested conditions
+  CPPUNIT_ASSERT ( test::compile(program, "<%?%p1%t%?%p2%tA%eB%;%eC%;>") );
+  CPPUNIT_ASSERT ( test::format(program, 1, 1) == "<A>" );
+  CPPUNIT_ASSERT ( test::format(program, 1, 0) == "<B>" );
+  CPPUNIT_ASSERT ( test::format(program, 0, 1) == "<C>" );
+
+  // Text after a condition
+  CPPUNIT_ASSERT ( test::compile(program, "%?%p1%tA%;B") );
+  CPPUNIT_ASSERT ( test::format(program, 1) == "AB" );
+  CPPUNIT_ASSERT ( test::format(program, 0) == "B" );
+
+  // Set attributes (xterm)
+  CPPUNIT_ASSERT ( test::compile(program, "%?%p9%t" ESC "(0%e" ESC "(B%;"
+                                          CSI "0%?%p6%t;1%;%?%p5%t;2%;%?%p2%t;4%;"
+                                          "%?%p1%p3%|%t;7%;%?%p4%t;5%;%?%p7%t;8%;m") );
+  CPPUNIT_ASSERT ( test::format(program, 0, 0, 0, 0, 0, 0, 0, 0, 0) == ESC "(B" CSI "0m" );
+  CPPUNIT_ASSERT ( test::format(program, 0, 1, 1, 0, 0, 1, 0, 0, 1) == ESC "(0" CSI "0;1;4;7m" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::variableTest()
+{
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( test::compile(program, "%ga%d%p1%Pa%ga%ga%+%d") );
+  CPPUNIT_ASSERT ( test::format(program, 21) == "042" );
+
+  // Dynamic variables start with 0 on every call
+  CPPUNIT_ASSERT ( test::format(program, 4) == "08" );
+
+  // Static variables keep their value
+  CPPUNIT_ASSERT ( test::compile(program, "%gZ%d%p1%PZ") );
+  CPPUNIT_ASSERT ( test::format(program, 5) == "0" );
+  CPPUNIT_ASSERT ( test::format(program, 6) == "5" );
+  CPPUNIT_ASSERT ( test::format(program, 0) == "6" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapProgramTest::unsupportedTest()
+{
+  // These strings are left to tparm()
+
+  finalcut::FTermcapProgram program{};
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%s") );
+  CPPUNIT_ASSERT ( ! program.isCompiled() );
+  CPPUNIT_ASSERT ( program.isSource("%p1%s", 5) );  // Remembered
+  CPPUNIT_ASSERT ( test::format(program, 1) == "" );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%l%d") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p0%d") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%d%") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%P1") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%'A%c") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%{12%d") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%5.2.1d") );
+
+  // Unbalanced conditions
+  CPPUNIT_ASSERT ( ! test::compile(program, "%?%p1%tA") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%p1%tA%;") );
+  CPPUNIT_ASSERT ( ! test::compile(program, "%?%p1%tA%p2%tB%;") );
+
+  // Termcap-style strings without %p
+  CPPUNIT_ASSERT ( ! test::compile(program, CSI "%i%d;%dH") );
+  CPPUNIT_ASSERT ( test::compile(program, CSI "%p1%dH") );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermcapProgramTest);
+
+// The general unit test main part
+#include <main-test.inc>
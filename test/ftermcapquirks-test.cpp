@@ -150,6 +150,9 @@ static tcap_map tcap[] =
   { {nullptr, 0}, {"ac"} },  // acs_chars
   { {nullptr, 0}, {"ks"} },  // keypad_xmit
   { {nullptr, 0}, {"ke"} },  // keypad_local
+  { {nullptr, 0}, {"SF"} },  // parm_index
+  { {nullptr, 0}, {"SR"} },  // parm_rindex
+  { {nullptr, 0}, {"cs"} },  // change_scroll_region
   { {nullptr, 0}, {"Km"} },  // key_mouse
   { {nullptr, 0}, {"\0"} }
 };
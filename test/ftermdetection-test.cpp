@@ -166,6 +166,8 @@ void FTermDetectionTest::ansiTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "ansi" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -250,6 +252,8 @@ void FTermDetectionTest::xtermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -331,6 +335,8 @@ void FTermDetectionTest::rxvtTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "rxvt-16color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "rxvt-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "rxvt-256color" );
@@ -410,6 +416,8 @@ void FTermDetectionTest::urxvtTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "rxvt-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "rxvt-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "rxvt-256color" );
@@ -489,6 +497,8 @@ void FTermDetectionTest::kdeKonsoleTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "konsole-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "konsole-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "konsole-256color" );
@@ -569,6 +579,8 @@ void FTermDetectionTest::gnomeTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "gnome-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "gnome-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "gnome-256color" );
@@ -648,6 +660,8 @@ void FTermDetectionTest::newerVteTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "gnome-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "gnome-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "gnome-256color" );
@@ -727,6 +741,8 @@ void FTermDetectionTest::puttyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "putty-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "putty" );
@@ -807,6 +823,8 @@ void FTermDetectionTest::windowsTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -886,6 +904,8 @@ void FTermDetectionTest::teraTermTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "teraterm" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -963,6 +983,8 @@ void FTermDetectionTest::cygwinTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "cygwin" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1047,6 +1069,8 @@ void FTermDetectionTest::minttyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -1124,6 +1148,8 @@ void FTermDetectionTest::sttermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "st-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1201,6 +1227,8 @@ void FTermDetectionTest::linuxTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "linux" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1285,6 +1313,8 @@ void FTermDetectionTest::freebsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-16color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1371,6 +1401,8 @@ void FTermDetectionTest::netbsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "wsvt25" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1455,6 +1487,8 @@ void FTermDetectionTest::openbsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "vt220" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1537,6 +1571,8 @@ void FTermDetectionTest::sunTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "sun-color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1620,6 +1656,8 @@ void FTermDetectionTest::screenTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "screen" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1705,6 +1743,8 @@ void FTermDetectionTest::tmuxTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "screen" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1790,6 +1830,8 @@ void FTermDetectionTest::ktermTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "kterm" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "" );
@@ -1877,6 +1919,8 @@ void FTermDetectionTest::mltermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "mlterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "mlterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "mlterm-256color" );
@@ -1961,6 +2005,8 @@ void FTermDetectionTest::kittyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasSynchronizedOutputSupport() );
+    CPPUNIT_ASSERT ( detect.hasKeyboardProtocolSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-kitty" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
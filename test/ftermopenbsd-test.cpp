@@ -68,6 +68,7 @@ class FSystemTest : public finalcut::FSystem
     void outPortByte (uChar, uShort) noexcept override;
     auto isTTY (int) const noexcept -> int override;
     auto ioctl (int, uLong, ...) noexcept -> int override;
+    auto fcntl (int, int, ...) noexcept -> int override;
     auto pipe (finalcut::PipeData&) noexcept -> int override;
     auto open (const char*, int, ...) noexcept -> int override;
     auto close (int) noexcept -> int override;
@@ -76,6 +77,8 @@ class FSystemTest : public finalcut::FSystem
     auto fclose (FILE*) noexcept -> int override;
     auto putchar (int) noexcept -> int override;
     auto putstring (const char*, std::size_t) noexcept -> int override;
+    auto read (int, void*, std::size_t) noexcept -> ssize_t override;
+    auto write (int, const void*, std::size_t) noexcept -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) noexcept -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -218,6 +221,16 @@ auto FSystemTest::ioctl (int file_descriptor, uLong request, ...) noexcept -> in
   return ret_val;
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::fcntl (int fd, int cmd, ...) noexcept -> int
+{
+  va_list args{};
+  va_start (args, cmd);
+  auto arg = va_arg (args, int);
+  va_end (args);
+  return ::fcntl(fd, cmd, arg);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::pipe (finalcut::PipeData& pipe) noexcept -> int
 {
@@ -286,6 +299,18 @@ auto FSystemTest::putstring (const char* str, std::size_t len) noexcept -> int
   return std::fwrite(str, 1, len, stdout);
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::read (int fd, void* buf, std::size_t count) noexcept -> ssize_t
+{
+  return ::read(fd, buf, count);
+}
+
+//----------------------------------------------------------------------
+auto FSystemTest::write (int fd, const void* buf, std::size_t count) noexcept -> ssize_t
+{
+  return ::write(fd, buf, count);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::sigaction ( int, const struct sigaction*
                             , struct sigaction* ) noexcept -> int
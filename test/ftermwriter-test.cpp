@@ -0,0 +1,645 @@
+/***********************************************************************
+* ftermwriter-test.cpp - FTermWriter unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+// class SlowTerminal
+//----------------------------------------------------------------------
+
+class SlowTerminal
+{
+  public:
+    // Simulates a terminal that accepts data only after open()
+
+    void write (const char* data, std::size_t length)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      entered = true;
+      condition.notify_all();
+      condition.wait (lock, [this] () { return is_open; });
+      output.append(data, length);
+    }
+
+    void waitForWrite()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait (lock, [this] () { return entered; });
+    }
+
+    void open()
+    {
+      std::lock_guard<std::mutex> lock_guard(mutex);
+      is_open = true;
+      condition.notify_all();
+    }
+
+    auto getOutput() -> std::string
+    {
+      std::lock_guard<std::mutex> lock_guard(mutex);
+      return output;
+    }
+
+  private:
+    std::mutex              mutex{};
+    std::condition_variable condition{};
+    std::string             output{};
+    bool                    entered{false};
+    bool                    is_open{false};
+};
+
+//----------------------------------------------------------------------
+// class FSystemTest
+//----------------------------------------------------------------------
+
+class FSystemTest : public finalcut::FSystem
+{
+  public:
+    // Constructor
+    FSystemTest() = default;
+
+    // Methods
+    auto inPortByte (uShort) noexcept -> uChar override
+    {
+      return 0;
+    }
+
+    void outPortByte (uChar, uShort) noexcept override
+    { }
+
+    auto isTTY (int) const noexcept -> int override
+    {
+      return 1;
+    }
+
+    auto ioctl (int, uLong, ...) noexcept -> int override
+    {
+      return -1;
+    }
+
+    auto fcntl (int, int, ...) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto pipe (finalcut::PipeData&) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto open (const char*, int, ...) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto close (int) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto fopen (const char*, const char*) noexcept -> FILE* override
+    {
+      return nullptr;
+    }
+
+    auto fputs (const char* str, FILE* stream) noexcept -> int override
+    {
+      return std::fputs(str, stream);
+    }
+
+    auto fclose (FILE*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto putchar (int c) noexcept -> int override
+    {
+#if defined(__sun) && defined(__SVR4)
+      return std::putchar(char(c));
+#else
+      return std::putchar(c);
+#endif
+    }
+
+    auto putstring (const char* str, std::size_t len) noexcept -> int override
+    {
+      return int(std::fwrite(str, 1, len, stdout));
+    }
+
+    auto read (int, void*, std::size_t) noexcept -> ssize_t override
+    {
+      return 0;
+    }
+
+    auto write (int fd, const void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      // Records the system call instead of executing it
+
+      if ( count > max_write_size )
+        count = max_write_size;
+
+      if ( count > accept_size )
+        count = accept_size;
+
+      if ( count == 0 )  // The terminal buffer is full
+      {
+        errno = EAGAIN;
+        return -1;
+      }
+
+      accept_size -= count;
+      write_calls.emplace_back(fd, count);
+      output.append(static_cast<const char*>(buf), count);
+      return ssize_t(count);
+    }
+
+    auto sigaction (int, const struct sigaction*, struct sigaction*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_create (clockid_t, struct sigevent*, timer_t*) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_settime ( timer_t, int
+                       , const struct itimerspec*
+                       , struct itimerspec* ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto timer_delete (timer_t) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto kqueue() noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto kevent ( int, const struct kevent*
+                , int, struct kevent*
+                , int, const struct timespec* ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto getuid() noexcept -> uid_t override
+    {
+      return 0;
+    }
+
+    auto geteuid() noexcept -> uid_t override
+    {
+      return 0;
+    }
+
+    auto getpwuid_r ( uid_t, struct passwd*, char*
+                   , size_t, struct passwd** ) noexcept -> int override
+    {
+      return 0;
+    }
+
+    auto realpath (const char*, char*) noexcept -> char* override
+    {
+      return const_cast<char*>("");
+    }
+
+    // Data members
+    std::vector<std::pair<int, std::size_t>> write_calls{};
+    std::string output{};
+    std::size_t max_write_size{SIZE_MAX};
+    std::size_t accept_size{SIZE_MAX};  // Free space in the terminal
+};
+
+//----------------------------------------------------------------------
+void writeFrame (finalcut::FTermWriter& writer, const std::string& str)
+{
+  writer.beginFrame();
+  writer.write (str.data(), str.size());
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FTermWriterTest
+//----------------------------------------------------------------------
+
+class FTermWriterTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermWriterTest() = default;
+
+  protected:
+    void noArgumentTest();
+    void synchronousTest();
+    void threadTest();
+    void supersedeTest();
+    void stopTest();
+    void systemCallTest();
+    void nonBlockingTest();
+    void nonBlockingSystemCallTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermWriterTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (synchronousTest);
+    CPPUNIT_TEST (threadTest);
+    CPPUNIT_TEST (supersedeTest);
+    CPPUNIT_TEST (stopTest);
+    CPPUNIT_TEST (systemCallTest);
+    CPPUNIT_TEST (nonBlockingTest);
+    CPPUNIT_TEST (nonBlockingSystemCallTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FTermWriterTest::noArgumentTest()
+{
+  const finalcut::FTermWriter writer{};
+  CPPUNIT_ASSERT ( ! writer.isRunning() );
+  CPPUNIT_ASSERT ( writer.getSupersedeSize()
+                   == finalcut::FTermWriter::DEFAULT_SUPERSEDE_SIZE );
+  CPPUNIT_ASSERT ( writer.getSupersededCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::synchronousTest()
+{
+  // Without a thread, the data is written immediately
+
+  std::string output{};
+  finalcut::FTermWriter writer { [&output] (const char* data, std::size_t length)
+                                 {
+                                   output.append(data, length);
+                                 } };
+  writer.write ("abc", 3);
+  CPPUNIT_ASSERT ( output == "abc" );
+
+  // Frame data is written when the frame is committed
+  test::writeFrame (writer, "def");
+  writer.write ("gh", 2);
+  CPPUNIT_ASSERT ( output == "abc" );
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  CPPUNIT_ASSERT ( output == "abcdefgh" );
+
+  // An empty frame writes nothing
+  writer.beginFrame();
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  CPPUNIT_ASSERT ( output == "abcdefgh" );
+  writer.waitUntilWritten();
+  writer.stop();
+  CPPUNIT_ASSERT ( ! writer.isRunning() );
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::threadTest()
+{
+  std::mutex mutex{};
+  std::string output{};
+  finalcut::FTermWriter writer { [&mutex, &output] ( const char* data
+                                                   , std::size_t length )
+                                 {
+                                   std::lock_guard<std::mutex> lock_guard(mutex);
+                                   output.append(data, length);
+                                 } };
+  CPPUNIT_ASSERT ( writer.start() );
+  CPPUNIT_ASSERT ( writer.isRunning() );
+  CPPUNIT_ASSERT ( writer.start() );  // Already running
+  std::string expected{};
+
+  for (int i{0}; i < 200; i++)
+  {
+    const auto frame = "<frame " + std::to_string(i) + ">";
+    test::writeFrame (writer, frame);
+    CPPUNIT_ASSERT ( writer.commitFrame() );
+    expected += frame;
+
+    if ( i % 7 == 0 )
+    {
+      writer.write ("*", 1);
+      expected += '*';
+    }
+  }
+
+  writer.waitUntilWritten();
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    CPPUNIT_ASSERT ( output == expected );
+  }
+
+  writer.stop();
+  CPPUNIT_ASSERT ( ! writer.isRunning() );
+  CPPUNIT_ASSERT ( writer.getSupersededCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::supersedeTest()
+{
+  test::SlowTerminal terminal{};
+  finalcut::FTermWriter writer { [&terminal] (const char* data, std::size_t length)
+                                 {
+                                   terminal.write(data, length);
+                                 } };
+  writer.setSupersedeSize (16);
+  CPPUNIT_ASSERT ( writer.getSupersedeSize() == 16 );
+  CPPUNIT_ASSERT ( writer.start() );
+
+  // The writer thread blocks on the first frame
+  test::writeFrame (writer, "A");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  terminal.waitForWrite();
+
+  // A frame is always accepted if no other frame is waiting
+  test::writeFrame (writer, "BBBBBBBBBBBB");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+
+  // Data outside a frame is never discarded
+  writer.write ("x", 1);
+
+  // Waiting frames are merged up to the supersede size
+  test::writeFrame (writer, "CC");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+
+  // Beyond that, the stale frames are discarded
+  test::writeFrame (writer, "DDDD");
+  CPPUNIT_ASSERT ( ! writer.commitFrame() );
+  CPPUNIT_ASSERT ( writer.getSupersededCount() == 1 );
+
+  // The caller now sends a repaint
+  test::writeFrame (writer, "EEEEEEEEEEEEEEEEEEEE");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+
+  terminal.open();
+  writer.waitUntilWritten();
+  CPPUNIT_ASSERT ( terminal.getOutput() == "AxEEEEEEEEEEEEEEEEEEEE" );
+  writer.stop();
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::stopTest()
+{
+  // Stopping writes all remaining data, including an open frame
+
+  test::SlowTerminal terminal{};
+
+  {
+    finalcut::FTermWriter writer { [&terminal] ( const char* data
+                                               , std::size_t length )
+                                   {
+                                     terminal.write(data, length);
+                                   } };
+    CPPUNIT_ASSERT ( writer.start() );
+    test::writeFrame (writer, "first");
+    CPPUNIT_ASSERT ( writer.commitFrame() );
+    terminal.waitForWrite();
+    writer.write (" second", 7);
+    test::writeFrame (writer, " third");
+    terminal.open();
+    writer.stop();
+    CPPUNIT_ASSERT ( ! writer.isRunning() );
+    CPPUNIT_ASSERT ( terminal.getOutput() == "first second third" );
+
+    // After the stop, the output is synchronous again
+    writer.write (" fourth", 7);
+    CPPUNIT_ASSERT ( terminal.getOutput() == "first second third fourth" );
+
+    // The destructor terminates a running thread
+    CPPUNIT_ASSERT ( writer.start() );
+    test::writeFrame (writer, " fifth");
+    CPPUNIT_ASSERT ( writer.commitFrame() );
+  }
+
+  CPPUNIT_ASSERT ( terminal.getOutput() == "first second third fourth fifth" );
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::systemCallTest()
+{
+  // A frame is written to the terminal with a single system call
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+
+  {
+    finalcut::FTermWriter writer{};
+    std::string expected{};
+
+    for (int i{0}; i < 50; i++)
+    {
+      // Each frame consists of many small pieces
+      writer.beginFrame();
+
+      for (int n{0}; n <= i * 10; n++)
+      {
+        const auto piece = "\033[" + std::to_string(n) + ";1H#";
+        writer.write (piece.data(), piece.size());
+        expected += piece;
+      }
+
+      const auto bytes = fsys_ptr->output.size();
+      CPPUNIT_ASSERT ( writer.commitFrame() );
+      CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == std::size_t(i + 1) );
+      CPPUNIT_ASSERT ( fsys_ptr->write_calls.back().first == STDOUT_FILENO );
+      CPPUNIT_ASSERT ( fsys_ptr->write_calls.back().second
+                       == expected.size() - bytes );
+    }
+
+    CPPUNIT_ASSERT ( fsys_ptr->output == expected );
+
+    // An empty frame needs no system call
+    writer.beginFrame();
+    CPPUNIT_ASSERT ( writer.commitFrame() );
+    CPPUNIT_ASSERT ( writer.writeFrame(nullptr, 0) );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 50 );
+
+    // A contiguous buffer is written directly
+    const std::string frame(10'000, 'x');
+    CPPUNIT_ASSERT ( writer.writeFrame(frame.data(), frame.size()) );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 51 );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.back().second == 10'000 );
+
+    // Partial writes are continued with the rest of the data
+    fsys_ptr->max_write_size = 4096;
+    fsys_ptr->output.clear();
+    CPPUNIT_ASSERT ( writer.writeFrame(frame.data(), frame.size()) );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 54 );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls[51].second == 4096 );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls[52].second == 4096 );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls[53].second == 1808 );
+    CPPUNIT_ASSERT ( fsys_ptr->output == frame );
+  }
+
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::nonBlockingTest()
+{
+  std::string output{};
+  std::size_t capacity{0};  // Bytes that the terminal accepts
+  finalcut::FTermWriter writer { [&output] (const char* data, std::size_t length)
+                                 {
+                                   output.append(data, length);
+                                 }
+                               , [&output, &capacity] ( const char* data
+                                                      , std::size_t length )
+                                 {
+                                   const auto bytes = std::min(length, capacity);
+                                   output.append(data, bytes);
+                                   capacity -= bytes;
+                                   return bytes;
+                                 } };
+  CPPUNIT_ASSERT ( ! writer.isNonBlocking() );
+  writer.setNonBlocking();
+  CPPUNIT_ASSERT ( writer.isNonBlocking() );
+  CPPUNIT_ASSERT ( ! writer.isRunning() );
+  writer.setSupersedeSize (16);
+
+  // The terminal accepts only a part of the frame
+  capacity = 2;
+  test::writeFrame (writer, "AAAA");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  CPPUNIT_ASSERT ( output == "AA" );
+  CPPUNIT_ASSERT ( writer.hasPendingOutput() );
+  CPPUNIT_ASSERT ( writer.getPendingSize() == 2 );
+
+  // A frame is always accepted if no other frame is waiting
+  test::writeFrame (writer, "BBBBBBBBBBBB");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+
+  // Data outside a frame is never discarded
+  writer.write ("x", 1);
+
+  // Waiting frames are merged up to the supersede size
+  test::writeFrame (writer, "C");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  CPPUNIT_ASSERT ( writer.getPendingSize() == 16 );
+
+  // Beyond that, the stale frames are discarded, but the
+  // started frame is completed
+  test::writeFrame (writer, "DD");
+  CPPUNIT_ASSERT ( ! writer.commitFrame() );
+  CPPUNIT_ASSERT ( writer.getSupersededCount() == 1 );
+  CPPUNIT_ASSERT ( writer.getPendingSize() == 3 );
+
+  // The caller now sends a repaint
+  test::writeFrame (writer, "EEEEEEEEEEEEEEEEEEEE");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  CPPUNIT_ASSERT ( output == "AA" );
+
+  // The output continues when the terminal accepts data again
+  capacity = 3;
+  CPPUNIT_ASSERT ( ! writer.resume() );
+  CPPUNIT_ASSERT ( output == "AAAAx" );
+  capacity = 100;
+  CPPUNIT_ASSERT ( writer.resume() );
+  CPPUNIT_ASSERT ( ! writer.hasPendingOutput() );
+  CPPUNIT_ASSERT ( output == "AAAAxEEEEEEEEEEEEEEEEEEEE" );
+  CPPUNIT_ASSERT ( writer.resume() );
+
+  // Leaving the non-blocking mode writes the remaining data
+  capacity = 0;
+  test::writeFrame (writer, "FF");
+  CPPUNIT_ASSERT ( writer.commitFrame() );
+  writer.write ("yz", 2);
+  test::writeFrame (writer, "G");
+  CPPUNIT_ASSERT ( writer.getPendingSize() == 4 );
+  writer.unsetNonBlocking();
+  CPPUNIT_ASSERT ( ! writer.isNonBlocking() );
+  CPPUNIT_ASSERT ( ! writer.hasPendingOutput() );
+  CPPUNIT_ASSERT ( output == "AAAAxEEEEEEEEEEEEEEEEEEEEFFyzG" );
+}
+
+//----------------------------------------------------------------------
+void FTermWriterTest::nonBlockingSystemCallTest()
+{
+  // A full terminal buffer does not block the writer
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<test::FSystemTest>();
+  finalcut::FSystem::getInstance().swap(fsys);
+  auto fsys_ptr = static_cast<test::FSystemTest*>(finalcut::FSystem::getInstance().get());
+
+  {
+    finalcut::FTermWriter writer{};
+    writer.setNonBlocking();
+    const std::string frame(10'000, 'x');
+    fsys_ptr->accept_size = 4096;
+    CPPUNIT_ASSERT ( writer.writeFrame(frame.data(), frame.size()) );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 1 );
+    CPPUNIT_ASSERT ( fsys_ptr->output.size() == 4096 );
+    CPPUNIT_ASSERT ( writer.getPendingSize() == 5904 );
+
+    // Partial writes are resumed with the rest of the data
+    CPPUNIT_ASSERT ( ! writer.resume() );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 1 );
+    fsys_ptr->accept_size = 5000;
+    CPPUNIT_ASSERT ( ! writer.resume() );
+    fsys_ptr->accept_size = 1000;
+    CPPUNIT_ASSERT ( writer.resume() );
+    CPPUNIT_ASSERT ( fsys_ptr->write_calls.size() == 3 );
+    CPPUNIT_ASSERT ( fsys_ptr->output == frame );
+    CPPUNIT_ASSERT ( ! writer.hasPendingOutput() );
+  }
+
+  finalcut::FSystem::getInstance().swap(fsys);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermWriterTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,204 @@
+/***********************************************************************
+* futf8encoder-test.cpp - FUTF8Encoder unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2025 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto encode (const std::wstring& str) -> std::string
+{
+  std::vector<char> buffer(finalcut::FUTF8Encoder::MAX_CHAR_LENGTH * str.length());
+  const auto* first = str.data();
+  const auto* last = first + str.length();
+  const auto length = finalcut::FUTF8Encoder::encode(first, last, buffer.data());
+  return {buffer.data(), length};
+}
+
+//----------------------------------------------------------------------
+auto referenceEncode (const std::wstring& str) -> std::string
+{
+  std::vector<char> buffer{};
+
+  for (const auto& ch : str)
+    finalcut::UTF8::encode(ch, buffer);
+
+  return {buffer.data(), buffer.size()};
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FUTF8EncoderTest
+//----------------------------------------------------------------------
+
+class FUTF8EncoderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FUTF8EncoderTest() = default;
+
+  protected:
+    void kernelTest();
+    void asciiTest();
+    void multiByteTest();
+    void kernelComparisonTest();
+
+  private:
+    using Kernel = finalcut::FUTF8Encoder::Kernel;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FUTF8EncoderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelTest);
+    CPPUNIT_TEST (asciiTest);
+    CPPUNIT_TEST (multiByteTest);
+    CPPUNIT_TEST (kernelComparisonTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    const std::array<Kernel, 2> kernels{{Kernel::Scalar, Kernel::SSE2}};
+};
+
+//----------------------------------------------------------------------
+void FUTF8EncoderTest::kernelTest()
+{
+  const auto default_kernel = finalcut::FUTF8Encoder::getKernel();
+  finalcut::FUTF8Encoder::setKernel (Kernel::Scalar);
+  CPPUNIT_ASSERT ( finalcut::FUTF8Encoder::getKernel() == Kernel::Scalar );
+
+  // Unsupported kernels fall back to the next smaller one
+  finalcut::FUTF8Encoder::setKernel (Kernel::SSE2);
+  CPPUNIT_ASSERT ( finalcut::FUTF8Encoder::getKernel() == default_kernel );
+}
+
+//----------------------------------------------------------------------
+void FUTF8EncoderTest::asciiTest()
+{
+  for (const auto kernel : kernels)
+  {
+    finalcut::FUTF8Encoder::setKernel (kernel);
+    CPPUNIT_ASSERT ( test::encode(L"") == "" );
+    CPPUNIT_ASSERT ( test::encode(L"A") == "A" );
+    CPPUNIT_ASSERT ( test::encode(L"1234567") == "1234567" );
+    CPPUNIT_ASSERT ( test::encode(L"12345678") == "12345678" );
+    CPPUNIT_ASSERT ( test::encode(L"The quick brown fox jumps over the lazy dog")
+                     == "The quick brown fox jumps over the lazy dog" );
+    CPPUNIT_ASSERT ( test::encode(std::wstring(L"\0\x7f", 2)) == std::string("\0\x7f", 2) );
+  }
+
+  finalcut::FUTF8Encoder::setKernel (Kernel::SSE2);
+}
+
+//----------------------------------------------------------------------
+void FUTF8EncoderTest::multiByteTest()
+{
+  for (const auto kernel : kernels)
+  {
+    finalcut::FUTF8Encoder::setKernel (kernel);
+    CPPUNIT_ASSERT ( test::encode(L"\x80") == "\xc2\x80" );
+    CPPUNIT_ASSERT ( test::encode(L"ä") == "\xc3\xa4" );
+    CPPUNIT_ASSERT ( test::encode(L"\x7ff") == "\xdf\xbf" );
+    CPPUNIT_ASSERT ( test::encode(L"\x800") == "\xe0\xa0\x80" );
+    CPPUNIT_ASSERT ( test::encode(L"─") == "\xe2\x94\x80" );
+    CPPUNIT_ASSERT ( test::encode(L"\xffff") == "\xef\xbf\xbf" );
+    CPPUNIT_ASSERT ( test::encode(L"\U00010000") == "\xf0\x90\x80\x80" );
+    CPPUNIT_ASSERT ( test::encode(L"\U0001f600") == "\xf0\x9f\x98\x80" );
+
+    // A non-ASCII character within eight ASCII characters
+    CPPUNIT_ASSERT ( test::encode(L"abcdefgä") == "abcdefg\xc3\xa4" );
+    CPPUNIT_ASSERT ( test::encode(L"äbcdefgh") == "\xc3\xa4" "bcdefgh" );
+    CPPUNIT_ASSERT ( test::encode(L"abcdefghijklmnop─qrstuvwxyz")
+                     == "abcdefghijklmnop\xe2\x94\x80qrstuvwxyz" );
+
+    // Invalid characters
+    CPPUNIT_ASSERT ( test::encode(std::wstring(1, wchar_t(0x200000))) == "\xef\xbf\xbd" );
+    CPPUNIT_ASSERT ( test::encode(std::wstring(1, wchar_t(-1))) == "\xef\xbf\xbd" );
+  }
+
+  finalcut::FUTF8Encoder::setKernel (Kernel::SSE2);
+}
+
+//----------------------------------------------------------------------
+void FUTF8EncoderTest::kernelComparisonTest()
+{
+  // All kernels must give the same results as UTF8::encode()
+
+  std::wstring text{};
+
+  for (std::size_t pos{0}; pos < 1000; pos++)
+  {
+    switch ( pos % 23 )
+    {
+      case 5:
+        text.push_back(L'é');
+        break;
+
+      case 11:
+        text.push_back(L'█');
+        break;
+
+      case 17:
+        text.push_back(L'\U0001f642');
+        break;
+
+      default:
+        text.push_back(L' ' + wchar_t(pos % 95));
+    }
+  }
+
+  const auto reference = test::referenceEncode(text);
+
+  for (const auto kernel : kernels)
+  {
+    finalcut::FUTF8Encoder::setKernel (kernel);
+
+    for (std::size_t length{0}; length <= 40; length++)
+      CPPUNIT_ASSERT ( test::encode(text.substr(0, length))
+                       == test::referenceEncode(text.substr(0, length)) );
+
+    CPPUNIT_ASSERT ( test::encode(text) == reference );
+  }
+
+  finalcut::FUTF8Encoder::setKernel (Kernel::SSE2);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FUTF8EncoderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -20,7 +20,10 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <array>
+#include <memory>
 #include <queue>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -60,6 +63,13 @@ void setBellState (bool state = true)
 class FTermOutputTest : public finalcut::FOutput
 {
   public:
+    struct ScrollRegion
+    {
+      int top{0};
+      int bottom{0};
+      int distance{0};
+    };
+
     // Constructor
     FTermOutputTest() = default;
     explicit FTermOutputTest (const finalcut::FVTerm&);
@@ -88,6 +98,9 @@ class FTermOutputTest : public finalcut::FOutput
     void setNonBlockingRead (bool = true) override;
     static void setNoForce (bool = true);
 
+    // Data member
+    static ScrollRegion scroll_region;
+
     // Predicates
     auto isCursorHideable() const -> bool override;
     auto isMonochron() const -> bool override;
@@ -104,12 +117,15 @@ class FTermOutputTest : public finalcut::FOutput
     // Methods
     void initTerminal (finalcut::FVTerm::FTermRegion*) override;
     void finishTerminal() override;
+    void beginSynchronizedUpdate() override;
     auto updateTerminal() -> bool override;
+    void endSynchronizedUpdate() override;
     void detectTerminalSize() override;
     void commitTerminalResize() override;
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalRegion (int, int, int, std::size_t) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
@@ -143,6 +159,7 @@ class FTermOutputTest : public finalcut::FOutput
 
 // static class attributes
 bool                           FTermOutputTest::no_force{false};
+FTermOutputTest::ScrollRegion  FTermOutputTest::scroll_region{};
 finalcut::FVTerm::FTermRegion* FTermOutputTest::vterm{nullptr};
 finalcut::FTermData*           FTermOutputTest::fterm_data{nullptr};
 
@@ -335,12 +352,20 @@ inline void FTermOutputTest::initTerminal (finalcut::FVTerm::FTermRegion* virtua
 inline void FTermOutputTest::finishTerminal()
 { }
 
+//----------------------------------------------------------------------
+inline void FTermOutputTest::beginSynchronizedUpdate()
+{ }
+
 //----------------------------------------------------------------------
 inline auto FTermOutputTest::updateTerminal() -> bool
 {
   return true;
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutputTest::endSynchronizedUpdate()
+{ }
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::detectTerminalSize()
 { }
@@ -365,6 +390,14 @@ inline auto FTermOutputTest::scrollTerminalReverse() -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::scrollTerminalRegion ( int top, int bottom
+                                                  , int distance, std::size_t ) -> bool
+{
+  scroll_region = {top, bottom, distance};
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::clearTerminalAttributes()
 {
@@ -486,10 +519,13 @@ class FVTerm_protected : public finalcut::FVTerm
     void p_putRegion (const finalcut::FPoint&, FTermRegion*) const;
     static auto p_getLayer (FVTerm&) -> int;
     static void p_determineWindowLayers();
+    static void p_invalidateWindowIndex();
     void p_scrollRegionForward (FTermRegion*);
     void p_scrollRegionReverse (FTermRegion*);
     void p_clearRegion (FTermRegion*, wchar_t = L' ');
     void p_forceTerminalUpdate() const;
+    void p_saveCurrentVTerm() const;
+    void p_scrollShiftedLines() const;
     auto p_processTerminalUpdate() const -> bool;
     static void p_startDrawing();
     static void p_finishDrawing();
@@ -714,6 +750,12 @@ inline void FVTerm_protected::p_determineWindowLayers()
   finalcut::FVTerm::determineWindowLayers();
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm_protected::p_invalidateWindowIndex()
+{
+  finalcut::FVTerm::invalidateWindowIndex();
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm_protected::p_scrollRegionForward (FTermRegion* region)
 {
@@ -738,6 +780,18 @@ inline void FVTerm_protected::p_forceTerminalUpdate() const
   finalcut::FVTerm::forceTerminalUpdate();
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm_protected::p_saveCurrentVTerm() const
+{
+  finalcut::FVTerm::saveCurrentVTerm();
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm_protected::p_scrollShiftedLines() const
+{
+  finalcut::FVTerm::scrollShiftedLines();
+}
+
 //----------------------------------------------------------------------
 inline auto FVTerm_protected::p_processTerminalUpdate() const -> bool
 {
@@ -783,6 +837,12 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     void FVTermOverlappingWindowsTest();
     void FVTermTranparencyTest();
     void FVTermReduceUpdatesTest();
+    void FVTermDamageSpanTest();
+    void FVTermBandCompositionTest();
+    void FVTermWindowIndexTest();
+    void FVTermHardwareScrollTest();
+    void FVTermRowRingTest();
+    void FVTermOpacityTest();
     void getFVTermRegionTest();
 
   private:
@@ -800,6 +860,12 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (FVTermOverlappingWindowsTest);
     CPPUNIT_TEST (FVTermTranparencyTest);
     CPPUNIT_TEST (FVTermReduceUpdatesTest);
+    CPPUNIT_TEST (FVTermDamageSpanTest);
+    CPPUNIT_TEST (FVTermBandCompositionTest);
+    CPPUNIT_TEST (FVTermWindowIndexTest);
+    CPPUNIT_TEST (FVTermHardwareScrollTest);
+    CPPUNIT_TEST (FVTermRowRingTest);
+    CPPUNIT_TEST (FVTermOpacityTest);
     CPPUNIT_TEST (getFVTermRegionTest);
 
     // End of test suite definition
@@ -3277,6 +3343,317 @@ void FVTermTest::FVTermReduceUpdatesTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermDamageSpanTest()
+{
+  using FLineChanges = finalcut::FVTerm::FTermRegion::FLineChanges;
+  FLineChanges changes{80, 0, 0, false};
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 0 );
+
+  // Adjacent and close changes are merged
+  changes.addSpan (2, 2);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+  CPPUNIT_ASSERT ( changes.xmin == 2 );
+  CPPUNIT_ASSERT ( changes.xmax == 2 );
+  changes.addSpan (3, 5);
+  changes.addSpan (10, 12);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmin == 2 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmax == 12 );
+
+  // Distant changes get their own span
+  changes.addSpan (70, 75);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 2 );
+  CPPUNIT_ASSERT ( changes.xmin == 2 );
+  CPPUNIT_ASSERT ( changes.xmax == 75 );
+  CPPUNIT_ASSERT ( changes.getSpan(1).xmin == 70 );
+  CPPUNIT_ASSERT ( changes.getSpan(1).xmax == 75 );
+  changes.addSpan (40, 41);
+  changes.addSpan (25, 26);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 4 );
+  CPPUNIT_ASSERT ( changes.getSpan(1).xmin == 25 );
+  CPPUNIT_ASSERT ( changes.getSpan(2).xmin == 40 );
+
+  // Without free capacity the spans with the smallest gap are joined
+  changes.addSpan (55, 56);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 4 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmin == 2 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmax == 26 );
+  CPPUNIT_ASSERT ( changes.getSpan(1).xmin == 40 );
+  CPPUNIT_ASSERT ( changes.getSpan(2).xmin == 55 );
+  CPPUNIT_ASSERT ( changes.getSpan(3).xmax == 75 );
+
+  // A wide change swallows all spans in between
+  changes.addSpan (20, 60);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 2 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmin == 2 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmax == 60 );
+  CPPUNIT_ASSERT ( changes.getSpan(1).xmin == 70 );
+
+  // A direct change of the bounding range invalidates the span list
+  changes.xmin = 0;
+  CPPUNIT_ASSERT ( ! changes.hasValidSpans() );
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmin == 0 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmax == 75 );
+  changes.addSpan (78, 79);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+  CPPUNIT_ASSERT ( changes.xmax == 79 );
+
+  changes.clear (80);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 0 );
+  CPPUNIT_ASSERT ( changes.xmin == 80 );
+  CPPUNIT_ASSERT ( changes.xmax == 0 );
+  changes.setSpan (0, 79);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+
+  // An empty range keeps the spans and the bounds in sync
+  changes.setEmpty (30);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 0 );
+  CPPUNIT_ASSERT ( changes.xmin == 30 );
+  CPPUNIT_ASSERT ( changes.xmax == 29 );
+  CPPUNIT_ASSERT ( ! changes.hasValidSpans() );
+  changes.addSpan (40, 41);
+  CPPUNIT_ASSERT ( changes.getSpanCount() == 1 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmin == 40 );
+  CPPUNIT_ASSERT ( changes.getSpan(0).xmax == 41 );
+  changes.setSpan (0, 79);
+
+  // Spans are carried through the layer composition
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+  finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{80, 5}};
+  auto vwin_ptr = p_fvterm.p_createRegion (geometry);
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  p_fvterm.print() << finalcut::FPoint{3, 2} << "<";
+  p_fvterm.print() << finalcut::FPoint{71, 2} << "12:00";
+  CPPUNIT_ASSERT ( vwin->changes_in_line[1].getSpanCount() == 2 );
+  vwin->visible = true;
+  p_fvterm.p_addLayer(vwin);
+
+  const auto& line_changes = vterm->changes_in_line[1];
+  CPPUNIT_ASSERT ( line_changes.getSpanCount() == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(0).xmin == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(0).xmax == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(1).xmin == 70 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(1).xmax == 74 );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[1].getSpanCount() == 0 );
+
+  // Unchanged characters are removed from the spans
+  vterm->changes_in_line[1].addSpan (0, 5);
+  vterm->changes_in_line[1].addSpan (66, 79);
+  CPPUNIT_ASSERT ( line_changes.getSpan(0).xmin == 0 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(1).xmax == 79 );
+  finalcut::FVTerm::reduceTerminalLineUpdates(1);
+  CPPUNIT_ASSERT ( line_changes.getSpanCount() == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(0).xmin == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(0).xmax == 2 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(1).xmin == 70 );
+  CPPUNIT_ASSERT ( line_changes.getSpan(1).xmax == 74 );
+  vterm->changes_in_line[1].setSpan (20, 40);
+  finalcut::FVTerm::reduceTerminalLineUpdates(1);
+  CPPUNIT_ASSERT ( line_changes.getSpanCount() == 0 );
+  CPPUNIT_ASSERT ( line_changes.xmin == line_changes.xmax + 1 );
+  CPPUNIT_ASSERT ( ! line_changes.hasValidSpans() );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermBandCompositionTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+  finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{80, 24}};
+  auto vwin_ptr = p_fvterm.p_createRegion (geometry);
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  vwin->visible = true;
+
+  // Mixes opaque, transparent, color overlay and
+  // background inheriting characters
+  const std::array<finalcut::FStyle, 5> styles
+  {{
+    finalcut::FStyle{finalcut::Style::None},
+    finalcut::FStyle{finalcut::Style::Transparent},
+    finalcut::FStyle{finalcut::Style::ColorOverlay},
+    finalcut::FStyle{finalcut::Style::InheritBackground},
+    finalcut::FStyle{finalcut::Style::Reverse}
+  }};
+  const auto color = finalcut::FColorPair { finalcut::FColor::Yellow
+                                          , finalcut::FColor::Blue };
+
+  for (int y{1}; y <= 24; y++)
+  {
+    for (int x{1}; x <= 80; x++)
+    {
+      // Leave gaps to get several damage spans in a line
+      if ( y % 3 == 0 && x > 20 && x < 60 )
+        continue;
+
+      const auto& style = styles[std::size_t((x * 7 + y * 3) % 5)];
+      p_fvterm.print() << finalcut::FPoint{x, y} << color << style
+                       << wchar_t(L'A' + (x + y) % 26)
+                       << finalcut::FStyle{finalcut::Style::None};
+    }
+  }
+
+  // Serial composition
+  const auto vterm_data = vterm->data;
+  const auto vterm_changes = vterm->changes_in_line;
+  const auto vwin_changes = vwin->changes_in_line;
+  auto& band_compositor = finalcut::FVTerm::getBandCompositor();
+  CPPUNIT_ASSERT ( ! band_compositor.isParallel() );
+  p_fvterm.p_addLayer(vwin);
+  const auto serial_data = vterm->data;
+  const auto serial_changes = vterm->changes_in_line;
+
+  // Composition in horizontal bands
+  vterm->data = vterm_data;
+  vterm->changes_in_line = vterm_changes;
+  vwin->changes_in_line = vwin_changes;
+  band_compositor.setThreadCount (4);
+  band_compositor.setMinimumBandSize (1);
+  CPPUNIT_ASSERT ( band_compositor.getBandCount(24, 80) == 4 );
+  p_fvterm.p_addLayer(vwin);
+  band_compositor.setThreadCount (1);
+  band_compositor.setMinimumBandSize (finalcut::FBandCompositor::DEFAULT_MIN_BAND_SIZE);
+
+  CPPUNIT_ASSERT ( vterm->data.size() == serial_data.size() );
+
+  for (std::size_t i{0}; i < serial_data.size(); i++)
+  {
+    CPPUNIT_ASSERT ( vterm->data[i] == serial_data[i] );
+    CPPUNIT_ASSERT ( vterm->data[i].attr.data == serial_data[i].attr.data );
+  }
+
+  for (std::size_t y{0}; y < serial_changes.size(); y++)
+  {
+    const auto& line_changes = vterm->changes_in_line[y];
+    CPPUNIT_ASSERT ( line_changes.getSpanCount() == serial_changes[y].getSpanCount() );
+    CPPUNIT_ASSERT ( line_changes.xmin == serial_changes[y].xmin );
+    CPPUNIT_ASSERT ( line_changes.xmax == serial_changes[y].xmax );
+    CPPUNIT_ASSERT ( vwin->changes_in_line[y].getSpanCount() == 0 );
+  }
+
+  // A failed band start falls back to the serial composition
+  vterm->data = vterm_data;
+  vterm->changes_in_line = vterm_changes;
+  vwin->changes_in_line = vwin_changes;
+  band_compositor.setThreadCount (4);
+  band_compositor.setMinimumBandSize (1);
+  finalcut::FBandCompositor::simulateSystemError();
+  p_fvterm.p_addLayer(vwin);
+  finalcut::FBandCompositor::simulateSystemError (false);
+  band_compositor.setThreadCount (1);
+  band_compositor.setMinimumBandSize (finalcut::FBandCompositor::DEFAULT_MIN_BAND_SIZE);
+
+  for (std::size_t i{0}; i < serial_data.size(); i++)
+  {
+    CPPUNIT_ASSERT ( vterm->data[i] == serial_data[i] );
+    CPPUNIT_ASSERT ( vterm->data[i].attr.data == serial_data[i].attr.data );
+  }
+
+  for (std::size_t y{0}; y < serial_changes.size(); y++)
+  {
+    const auto& line_changes = vterm->changes_in_line[y];
+    CPPUNIT_ASSERT ( line_changes.getSpanCount() == serial_changes[y].getSpanCount() );
+    CPPUNIT_ASSERT ( line_changes.xmin == serial_changes[y].xmin );
+    CPPUNIT_ASSERT ( line_changes.xmax == serial_changes[y].xmax );
+    CPPUNIT_ASSERT ( vwin->changes_in_line[y].getSpanCount() == 0 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermWindowIndexTest()
+{
+  // Many overlapping windows: the covered state of each window line
+  // must match a comparison with every other window
+
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  constexpr std::size_t window_count = 40;
+  std::vector<std::unique_ptr<FVTerm_protected>> windows{};
+  std::vector<finalcut::FVTerm::FTermRegion*> regions{};
+  auto window_list = finalcut::FVTerm::getWindowList();
+  CPPUNIT_ASSERT ( window_list->empty() );
+  unsigned random{12345};
+
+  const auto next_random = [&random] (unsigned max)
+  {
+    random = random * 1103515245U + 12345U;
+    return int((random >> 16) % max);
+  };
+
+  for (std::size_t i{0}; i < window_count; i++)
+  {
+    windows.emplace_back (new FVTerm_protected(finalcut::outputClass<FTermOutputTest>{}));
+    auto& p_fvterm_win = *windows.back();
+    const finalcut::FRect geometry { finalcut::FPoint{next_random(70), next_random(20)}
+                                   , finalcut::FSize{ std::size_t(next_random(20) + 1)
+                                                    , std::size_t(next_random(8) + 1) } };
+    auto vwin_ptr = p_fvterm_win.p_createRegion (geometry);
+    regions.push_back(vwin_ptr.get());
+    regions.back()->visible = (i % 7 != 3);
+    p_fvterm_win.setVWin(std::move(vwin_ptr));
+    window_list->push_back(&p_fvterm_win);
+  }
+
+  FVTerm_protected::p_determineWindowLayers();
+
+  const auto check_covered_lines = [&windows, &regions] ()
+  {
+    for (std::size_t i{0}; i < regions.size(); i++)
+    {
+      auto* src = regions[i];
+
+      if ( ! src->visible )
+        continue;
+
+      windows[i]->p_putRegion ({src->position.x + 1, src->position.y + 1}, src);
+
+      for (int y{0}; y < src->size.height; y++)
+      {
+        bool covered{false};
+
+        for (const auto* win : regions)
+        {
+          if ( win->visible && win->layer > src->layer && win->isOverlapped(src)
+            && src->position.y + y >= win->position.y
+            && src->position.y + y < win->position.y + win->size.height )
+            covered = true;
+        }
+
+        CPPUNIT_ASSERT ( src->changes_in_line[unsigned(y)].covered == covered );
+      }
+    }
+  };
+
+  check_covered_lines();
+
+  // Move windows
+  for (std::size_t i{0}; i < window_count; i += 3)
+  {
+    regions[i]->position.x = next_random(70);
+    regions[i]->position.y = next_random(20);
+  }
+
+  FVTerm_protected::p_invalidateWindowIndex();
+  check_covered_lines();
+
+  // Raise and lower windows
+  std::swap(window_list->at(0), window_list->at(window_count - 1));
+  std::swap(window_list->at(5), window_list->at(20));
+  FVTerm_protected::p_determineWindowLayers();
+  check_covered_lines();
+
+  // Show and hide windows
+  regions[3]->visible = true;
+  regions[4]->visible = false;
+  FVTerm_protected::p_invalidateWindowIndex();
+  check_covered_lines();
+
+  window_list->clear();
+}
+
 //----------------------------------------------------------------------
 void FVTermTest::getFVTermRegionTest()
 {
@@ -3636,6 +4013,329 @@ void FVTermTest::getFVTermRegionTest()
   CPPUNIT_ASSERT ( test::isRegionEqual(test_vwin_region, vwin_region) );
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermHardwareScrollTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+  const auto width = vterm->size.width;
+  const auto height = vterm->size.height;
+  CPPUNIT_ASSERT ( width == 80 );
+  CPPUNIT_ASSERT ( height == 24 );
+  auto& scroll_region = FTermOutputTest::scroll_region;
+
+  // Each line starts with a unique character
+  const auto print_line = [vterm, width] (int y, int id)
+  {
+    finalcut::FChar fchar{};
+    fchar.color.setFgColor(finalcut::FColor::Black);
+    fchar.color.setBgColor(finalcut::FColor::LightGray);
+
+    for (int x{0}; x < width; x++)
+    {
+      fchar.ch[0] = ( x == 0 ) ? wchar_t(0x100 + id)
+                               : wchar_t(L'a' + (x + id) % 26);
+      vterm->getFChar(x, y) = fchar;
+    }
+  };
+
+  // Only the row range is marked, so that the
+  // exposed lines are the only lines with changes
+  const auto mark_rows = [vterm] (int ymin, int ymax)
+  {
+    for (auto& line_changes : vterm->changes_in_line)
+      line_changes.clear (uInt(vterm->size.width));
+
+    vterm->changes_in_row = {uInt(ymin), uInt(ymax)};
+  };
+
+  const auto has_changes = [vterm] (int y)
+  {
+    return vterm->changes_in_line[unsigned(y)].getSpanCount() > 0;
+  };
+
+  for (int y{0}; y < height; y++)
+    print_line (y, y);
+
+  p_fvterm.p_saveCurrentVTerm();
+
+  // Unchanged lines do not scroll
+  scroll_region = {};
+  mark_rows (0, height - 1);
+  p_fvterm.p_scrollShiftedLines();
+  CPPUNIT_ASSERT ( scroll_region.distance == 0 );
+
+  for (int y{0}; y < height; y++)
+    CPPUNIT_ASSERT ( ! has_changes(y) );
+
+  // Lines 5 to 22 move up by three lines
+  for (int y{2}; y < 20; y++)
+    print_line (y, y + 3);
+
+  for (int y{20}; y < 23; y++)
+    print_line (y, y + 100);
+
+  mark_rows (2, 22);
+  p_fvterm.p_scrollShiftedLines();
+  CPPUNIT_ASSERT ( scroll_region.top == 2 );
+  CPPUNIT_ASSERT ( scroll_region.bottom == 22 );
+  CPPUNIT_ASSERT ( scroll_region.distance == 3 );
+
+  // Only the exposed lines have to be printed again
+  for (int y{0}; y < 20; y++)
+    CPPUNIT_ASSERT ( ! has_changes(y) );
+
+  for (int y{20}; y < 23; y++)
+  {
+    CPPUNIT_ASSERT ( vterm->changes_in_line[unsigned(y)].xmin == 0 );
+    CPPUNIT_ASSERT ( vterm->changes_in_line[unsigned(y)].xmax == uInt(width - 1) );
+  }
+
+  CPPUNIT_ASSERT ( ! has_changes(23) );
+
+  // The copy of the last frame has been scrolled as well
+  scroll_region = {};
+  mark_rows (2, 22);
+  p_fvterm.p_scrollShiftedLines();
+  CPPUNIT_ASSERT ( scroll_region.distance == 0 );
+  p_fvterm.p_saveCurrentVTerm();
+
+  // Lines 0 to 9 move down by two lines
+  for (int y{11}; y > 1; y--)
+    print_line (y, int(vterm->getFChar(0, y - 2).ch[0]) - 0x100);
+
+  print_line (0, 200);
+  print_line (1, 201);
+  mark_rows (0, 11);
+  p_fvterm.p_scrollShiftedLines();
+  CPPUNIT_ASSERT ( scroll_region.top == 0 );
+  CPPUNIT_ASSERT ( scroll_region.bottom == 11 );
+  CPPUNIT_ASSERT ( scroll_region.distance == -2 );
+  CPPUNIT_ASSERT ( has_changes(0) );
+  CPPUNIT_ASSERT ( has_changes(1) );
+
+  for (int y{2}; y < height; y++)
+    CPPUNIT_ASSERT ( ! has_changes(y) );
+
+  p_fvterm.p_saveCurrentVTerm();
+
+  // Scrolling is not worthwhile if only one line moves a long way
+  print_line (15, int(vterm->getFChar(0, 5).ch[0]) - 0x100);
+  scroll_region = {};
+  mark_rows (5, 15);
+  p_fvterm.p_scrollShiftedLines();
+  CPPUNIT_ASSERT ( scroll_region.distance == 0 );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermRowRingTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{4, 4}};
+  auto vwin_ptr = p_fvterm.p_createRegion (geometry);
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+
+  const auto clear_changes = [vwin] ()
+  {
+    for (auto& line_changes : vwin->changes_in_line)
+      line_changes.clear (uInt(vwin->size.width));
+
+    vwin->changes_in_row = {uInt(vwin->size.height), 0};
+  };
+
+  const auto is_line_changed = [vwin] (int y)
+  {
+    const auto& line_changes = vwin->changes_in_line[unsigned(y)];
+    return line_changes.getSpanCount() == 1
+        && line_changes.xmin == 0
+        && line_changes.xmax == uInt(vwin->size.width - 1);
+  };
+
+  // The lines are stored one after the other after resizing
+  CPPUNIT_ASSERT ( vwin->row_offsets.size() == 4 );
+
+  for (std::size_t y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( vwin->row_offsets[y] == y * 4 );
+
+  p_fvterm.print() << finalcut::FPoint{1, 1} << "AAAABBBBCCCCDDDD";
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L'D' );
+  vwin->changes_in_line[1].trans_count = 2;
+  clear_changes();
+
+  // Scrolling up rotates the line offsets
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( vwin->row_offsets[0] == 4 );
+  CPPUNIT_ASSERT ( vwin->row_offsets[1] == 8 );
+  CPPUNIT_ASSERT ( vwin->row_offsets[2] == 12 );
+  CPPUNIT_ASSERT ( vwin->row_offsets[3] == 0 );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 0).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vwin->getFChar(3, 2).ch[0] == L'D' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vwin->getFChar(3, 3).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[0].trans_count == 2 );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[3].trans_count == 0 );
+  CPPUNIT_ASSERT ( vwin->changes_in_row.ymin == 0 );
+  CPPUNIT_ASSERT ( vwin->changes_in_row.ymax == 3 );
+  CPPUNIT_ASSERT ( vwin->has_changes );
+
+  for (int y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( is_line_changed(y) );
+
+  // Printing follows the line order
+  p_fvterm.print() << finalcut::FPoint{1, 3} << "WXYZ1234";
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 2).ch[0] == L'W' );
+  CPPUNIT_ASSERT ( vwin->getFChar(3, 2).ch[0] == L'Z' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L'1' );
+  CPPUNIT_ASSERT ( vwin->getFChar(3, 3).ch[0] == L'4' );
+  CPPUNIT_ASSERT ( vwin->data[0].ch[0] == L'1' );
+  clear_changes();
+
+  // Scrolling down rotates back
+  p_fvterm.p_scrollRegionReverse (vwin);
+  p_fvterm.p_scrollRegionReverse (vwin);
+
+  for (std::size_t y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( vwin->row_offsets[y] == ((y + 3) % 4) * 4 );
+
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 0).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 1).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 2).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L'C' );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[2].trans_count == 2 );
+
+  for (int y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( is_line_changed(y) );
+
+  // A resize restores the line order
+  p_fvterm.p_resizeRegion (finalcut::FRect{finalcut::FPoint{0, 0}, finalcut::FSize{5, 3}}, vwin);
+  CPPUNIT_ASSERT ( vwin->row_offsets.size() == 3 );
+
+  for (std::size_t y{0}; y < 3; y++)
+    CPPUNIT_ASSERT ( vwin->row_offsets[y] == y * 5 );
+
+  // The right shadow keeps its position
+  finalcut::FSize shadow(1, 1);
+  auto shadow_win_ptr = p_fvterm.p_createRegion ({geometry, shadow});
+  auto shadow_win = shadow_win_ptr.get();
+  CPPUNIT_ASSERT ( shadow_win->row_offsets.size() == 5 );
+
+  for (int y{0}; y < 4; y++)
+  {
+    for (int x{0}; x < 4; x++)
+      shadow_win->getFChar(x, y).ch[0] = wchar_t(L'a' + y);
+
+    shadow_win->getFChar(4, y).ch[0] = wchar_t(L'0' + y);
+  }
+
+  p_fvterm.p_scrollRegionForward (shadow_win);
+
+  for (std::size_t y{0}; y < 5; y++)
+    CPPUNIT_ASSERT ( shadow_win->row_offsets[y] == y * 5 );
+
+  CPPUNIT_ASSERT ( shadow_win->getFChar(0, 0).ch[0] == L'b' );
+  CPPUNIT_ASSERT ( shadow_win->getFChar(3, 2).ch[0] == L'd' );
+  CPPUNIT_ASSERT ( shadow_win->getFChar(0, 3).ch[0] == L' ' );
+
+  for (int y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( shadow_win->getFChar(4, y).ch[0] == wchar_t(L'0' + y) );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermOpacityTest()
+{
+  using Opacity = finalcut::FVTerm::FTermRegion::Opacity;
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+  finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{6, 4}};
+  finalcut::FSize shadow(1, 1);
+  auto vwin_ptr = p_fvterm.p_createRegion ({geometry, shadow});
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  vwin->visible = true;
+
+  // A region without transparent characters is opaque
+  for (auto& line_changes : vwin->changes_in_line)
+    line_changes.trans_count = 0;
+
+  CPPUNIT_ASSERT ( vwin->getOpacity() == Opacity::Opaque );
+  CPPUNIT_ASSERT ( vwin->getLineOpacity(0) == Opacity::Opaque );
+
+  // Transparent right and bottom shadow
+  for (int y{0}; y < 5; y++)
+  {
+    for (int x{0}; x < 7; x++)
+    {
+      auto& fchar = vwin->getFChar(x, y);
+      fchar.ch[0] = wchar_t(L'a' + y);
+
+      if ( x == 6 || y == 4 )
+      {
+        fchar.setBit(finalcut::FAttribute::set::transparent);
+        vwin->changes_in_line[unsigned(y)].trans_count++;
+      }
+    }
+
+    vwin->changes_in_line[unsigned(y)].setSpan (0, 6);
+  }
+
+  vwin->changes_in_row = {0, 4};
+  vwin->has_changes = true;
+  vwin->invalidateOpacity();
+  CPPUNIT_ASSERT ( vwin->getOpacity() == Opacity::Shadow );
+
+  for (int y{0}; y < 4; y++)
+    CPPUNIT_ASSERT ( vwin->getLineOpacity(y) == Opacity::Shadow );
+
+  CPPUNIT_ASSERT ( vwin->getLineOpacity(4) == Opacity::Mixed );
+
+  // The interior is copied, the transparent shadow is not
+  const auto vterm_char = vterm->getFChar(6, 0);
+  p_fvterm.p_addLayer(vwin);
+
+  for (int y{0}; y < 4; y++)
+  {
+    for (int x{0}; x < 6; x++)
+      CPPUNIT_ASSERT ( vterm->getFChar(x, y).ch[0] == wchar_t(L'a' + y) );
+
+    CPPUNIT_ASSERT ( vterm->getFChar(6, y).ch[0] == vterm_char.ch[0] );
+    CPPUNIT_ASSERT ( vterm->changes_in_line[unsigned(y)].xmin == 0 );
+    CPPUNIT_ASSERT ( vterm->changes_in_line[unsigned(y)].xmax == 6 );
+    CPPUNIT_ASSERT ( vwin->changes_in_line[unsigned(y)].getSpanCount() == 0 );
+  }
+
+  for (int x{0}; x < 7; x++)
+    CPPUNIT_ASSERT ( vterm->getFChar(x, 4).ch[0] == vterm_char.ch[0] );
+
+  // An opaque shadow character with the same transparent count
+  // does not hide a transparent character inside the region
+  vwin->getFChar(6, 1).unsetBit(finalcut::FAttribute::unset::transparent);
+  vwin->getFChar(2, 1).setBit(finalcut::FAttribute::set::transparent);
+  vwin->invalidateOpacity();
+  CPPUNIT_ASSERT ( vwin->getLineOpacity(1) == Opacity::Mixed );
+  CPPUNIT_ASSERT ( vwin->getOpacity() == Opacity::Mixed );
+
+  vwin->changes_in_line[1].setSpan (0, 6);
+  vwin->changes_in_row = {1, 1};
+  vwin->has_changes = true;
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vterm->getFChar(1, 1).ch[0] == L'b' );
+  CPPUNIT_ASSERT ( vterm->getFChar(2, 1).ch[0] == L'b' );  // unchanged
+  CPPUNIT_ASSERT ( vterm->getFChar(6, 1).ch[0] == L'b' );
+
+  // Printing a transparent character inside the region
+  vwin->getFChar(6, 1).setBit(finalcut::FAttribute::set::transparent);
+  vwin->getFChar(2, 1).unsetBit(finalcut::FAttribute::unset::transparent);
+  vwin->invalidateOpacity();
+  CPPUNIT_ASSERT ( vwin->getOpacity() == Opacity::Shadow );
+  p_fvterm.print() << finalcut::FPoint{3, 3}
+                   << finalcut::FStyle{finalcut::Style::Transparent} << 'T'
+                   << finalcut::FStyle{finalcut::Style::None};
+  CPPUNIT_ASSERT ( vwin->changes_in_line[2].trans_count == 2 );
+  CPPUNIT_ASSERT ( vwin->getLineOpacity(2) == Opacity::Mixed );
+  CPPUNIT_ASSERT ( vwin->getOpacity() == Opacity::Mixed );
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FVTermTest);
 
@@ -57,6 +57,7 @@ using enable_if_FChar_t =
 //----------------------------------------------------------------------
 void showFCharData (const finalcut::FChar&);
 auto getRegionSize (finalcut::FVTerm::FTermRegion*) -> std::size_t;
+auto getRegionChar (const finalcut::FVTerm::FTermRegion*, std::size_t) -> const finalcut::FChar&;
 auto isRegionEqual (finalcut::FVTerm::FTermRegion*, finalcut::FVTerm::FTermRegion*) -> bool;
 auto isFCharEqual (const finalcut::FChar&, const finalcut::FChar&) -> bool;
 template < typename FCharT
@@ -127,6 +128,16 @@ auto getRegionSize (finalcut::FVTerm::FTermRegion* region) -> std::size_t
   return full_width * full_height;
 }
 
+//----------------------------------------------------------------------
+auto getRegionChar ( const finalcut::FVTerm::FTermRegion* region
+                   , std::size_t i ) -> const finalcut::FChar&
+{
+  // Returns the i-th character in display order
+
+  const auto width = std::size_t(region->size.width) + std::size_t(region->shadow.width);
+  return region->getFChar(int(i % width), int(i / width));
+}
+
 //----------------------------------------------------------------------
 auto isRegionEqual ( finalcut::FVTerm::FTermRegion* region1
                    , finalcut::FVTerm::FTermRegion* region2 ) -> bool
@@ -146,11 +157,14 @@ auto isRegionEqual ( finalcut::FVTerm::FTermRegion* region1
 
   for (std::size_t i{0U}; i < size1; i++)
   {
-    if ( ! isFCharEqual (region1->data[i], region2->data[i]) )
+    const auto& fchar1 = getRegionChar(region1, i);
+    const auto& fchar2 = getRegionChar(region2, i);
+
+    if ( ! isFCharEqual (fchar1, fchar2) )
     {
       std::wcout << L"differ: char " << i << L" '"
-                 << region1->data[i].ch[0] << L"' != '"
-                 << region2->data[i].ch[0] << L"'\n";
+                 << fchar1.ch[0] << L"' != '"
+                 << fchar2.ch[0] << L"'\n";
       return false;
     }
   }
@@ -261,7 +275,9 @@ void printRegion ( finalcut::FVTerm::FTermRegion* region )
 
   for (std::size_t i{0U}; i < size; i++)
   {
-    if ( region->data[i].attr.bit()->fullwidth_padding )
+    const auto& fchar = getRegionChar(region, i);
+
+    if ( fchar.attr.bit()->fullwidth_padding )
       continue;
 
     auto col = (i + 1) % width ;
@@ -270,7 +286,7 @@ void printRegion ( finalcut::FVTerm::FTermRegion* region )
     if ( col == 1 && line < std::size_t(height) )
       std::wcout << L"│";
 
-    auto ch = region->data[i].ch;
+    auto ch = fchar.ch;
 
     if ( ch[0] == L'\0' )
       ch[0] = L' ';
@@ -392,6 +392,7 @@ class FWidgetTest : public CPPUNIT_NS::TestFixture
     void closeWidgetTest();
     void adjustSizeTest();
     void callbackTest();
+    void transparentShadowTest();
 
   private:
     class FSystemTest;
@@ -411,6 +412,7 @@ class FWidgetTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (closeWidgetTest);
     CPPUNIT_TEST (adjustSizeTest);
     CPPUNIT_TEST (callbackTest);
+    CPPUNIT_TEST (transparentShadowTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -464,6 +466,15 @@ class FWidgetTest::FSystemTest : public finalcut::FSystem
       return ret_val;
     }
 
+    auto fcntl (int fd, int cmd, ...) noexcept -> int override
+    {
+      va_list args{};
+      va_start (args, cmd);
+      auto arg = va_arg (args, int);
+      va_end (args);
+      return ::fcntl(fd, cmd, arg);
+    }
+
     auto pipe (finalcut::PipeData&) noexcept -> int override
     {
       return 0;
@@ -508,6 +519,16 @@ class FWidgetTest::FSystemTest : public finalcut::FSystem
       return std::fwrite(str, 1, len, stdout);
     }
 
+    auto read (int fd, void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      return ::read(fd, buf, count);
+    }
+
+    auto write (int fd, const void* buf, std::size_t count) noexcept -> ssize_t override
+    {
+      return ::write(fd, buf, count);
+    }
+
     auto sigaction (int, const struct sigaction*, struct sigaction*) noexcept -> int override
     {
       return 0;
@@ -3166,6 +3187,56 @@ void FWidgetTest::callbackTest()
   CPPUNIT_ASSERT ( value == 302 );
 }
 
+//----------------------------------------------------------------------
+void FWidgetTest::transparentShadowTest()
+{
+  using Opacity = finalcut::FVTerm::FTermRegion::Opacity;
+
+  class ShadowWidget : public finalcut::FWidget
+  {
+    public:
+      explicit ShadowWidget (finalcut::FWidget* parent = nullptr)
+        : finalcut::FWidget{parent}
+      {
+        const finalcut::FRect box{finalcut::FPoint{0, 0}, finalcut::FSize{10, 4}};
+        shadow_region = createRegion({box, finalcut::FSize{2, 1}});
+      }
+
+      auto getPrintRegion() -> FTermRegion* override
+      {
+        return shadow_region.get();
+      }
+
+    private:
+      std::unique_ptr<FTermRegion> shadow_region{};
+  };
+
+  finalcut::FWidget root_wdgt{};
+  ShadowWidget wdgt{&root_wdgt};
+  wdgt.setFlags().shadow.trans_shadow = true;
+  const auto region = wdgt.getPrintRegion();
+
+  // Redrawing the shadow does not increase the transparent count
+  for (int i{0}; i < 3; i++)
+  {
+    finalcut::drawShadow(&wdgt);
+
+    for (std::size_t y{0}; y < 4; y++)
+      CPPUNIT_ASSERT ( region->changes_in_line[y].trans_count == 2 );
+
+    CPPUNIT_ASSERT ( region->changes_in_line[4].trans_count == 12 );
+    CPPUNIT_ASSERT ( region->getFChar(10, 0).isBitSet(finalcut::FAttribute::set::transparent) );
+    CPPUNIT_ASSERT ( region->getFChar(11, 3).isBitSet(finalcut::FAttribute::set::color_overlay) );
+    CPPUNIT_ASSERT ( region->getFChar(1, 4).isBitSet(finalcut::FAttribute::set::transparent) );
+    CPPUNIT_ASSERT ( region->getFChar(2, 4).isBitSet(finalcut::FAttribute::set::color_overlay) );
+    CPPUNIT_ASSERT ( ! region->getFChar(9, 3).isBitSet(finalcut::FAttribute::set::color_overlay) );
+    CPPUNIT_ASSERT ( region->getOpacity() == Opacity::Shadow );
+
+    for (int y{0}; y < 4; y++)
+      CPPUNIT_ASSERT ( region->getLineOpacity(y) == Opacity::Shadow );
+  }
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FWidgetTest);